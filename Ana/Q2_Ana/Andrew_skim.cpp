@@ -17,6 +17,7 @@
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
 #include "HipoChainWriter.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -49,9 +50,11 @@ int main(int argc, char ** argv)
   char * outName = argv[1];
   cout<<"Ouput file "<< outName <<endl;
   clas12root::HipoChainWriter chain(outName);
+  clas12jobstats stats("Andrew_skim");
   for(int k = 2; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   //chain.GetWriter().writeSpecialBanks(true);
   chain.SetReaderTags({0});
@@ -82,16 +85,11 @@ int main(int argc, char ** argv)
   clas12ana clasAna;
   clasAna.printParams();
   
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto selection_timer = stats.time(jobStage::Selection);
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
 
       clasAna.Run(c12);
       auto electrons = clasAna.getByPid(11);
@@ -117,9 +115,14 @@ int main(int argc, char ** argv)
 	  }
 	  
 	  if(lead_ctr==0){continue;}
-	  chain.WriteEvent();	  
+	  {
+	    auto write_timer = stats.time(jobStage::Write);
+	    chain.WriteEvent();
+	  }
 	}
     }
+
+  stats.summary();
   return 0;
 }
 
@@ -21,6 +21,7 @@
 #include "TFitResultPtr.h"
 #include "TLatex.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -104,9 +105,11 @@ int main(int argc, char ** argv)
   clas12ana clasAna;
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("Central_Detector_Proton");
   for(int k = 4; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -252,9 +255,10 @@ int main(int argc, char ** argv)
   hist_list.push_back(h_Chi2PID_wPID);
   
 
-  while(chain.Next())
+  while(stats.next(chain))
   //while(chain.Next() && counter<100)
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
       double weight = 1;
       if(isMC==1){
 	weight = c12->mcevent()->getWeight(); //used if MC events have a weight
@@ -262,14 +266,8 @@ int main(int argc, char ** argv)
 
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
-
- clasAna.Run(c12);
+
+ stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       auto protons = clasAna.getByPid(2212);
       auto pionplus = clasAna.getByPid(211);
@@ -336,63 +334,88 @@ int main(int argc, char ** argv)
 	    }
 
 	    //vertex
-	    h_vtz_CD_bc->Fill(vtz_p,weight);
-	    h_diffvtz_CD_bc->Fill(vtz_e-vtz_p,weight);
-	    h_vtz_e_p_CD_bc->Fill(vtz_e,vtz_p,weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_vtz_CD_bc->Fill(vtz_p,weight);
+	      h_diffvtz_CD_bc->Fill(vtz_e-vtz_p,weight);
+	      h_vtz_e_p_CD_bc->Fill(vtz_e,vtz_p,weight);
+	    }
 	    if(fabs(vtz_e-vtz_p-0.62)>(2*0.86)){continue;}
 	    if((vtz_p<-5.5) || (vtz_p>-0.5)){continue;}
-	    h_vtz_CD_ac->Fill(vtz_p,weight);
-	    h_diffvtz_CD_ac->Fill(vtz_e-vtz_p,weight);
-	    h_vtz_e_p_CD_ac->Fill(vtz_e,vtz_p,weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_vtz_CD_ac->Fill(vtz_p,weight);
+	      h_diffvtz_CD_ac->Fill(vtz_e-vtz_p,weight);
+	      h_vtz_e_p_CD_ac->Fill(vtz_e,vtz_p,weight);
 
 
-	    //fid
-	    h_mom_ToFToF_d_ToFMom_CD_bc->Fill(mom,DT_proton,weight);
-	    h_theta_CD_bc->Fill(theta,weight);
-	    h_phi_momT_CD_bc->Fill(phi,momT,weight);
-	    h_ToFToF_d_ToFMom_CD_bc_bin[mom_bin]->Fill(DT_proton,weight);
+	      //fid
+	      h_mom_ToFToF_d_ToFMom_CD_bc->Fill(mom,DT_proton,weight);
+	      h_theta_CD_bc->Fill(theta,weight);
+	      h_phi_momT_CD_bc->Fill(phi,momT,weight);
+	      h_ToFToF_d_ToFMom_CD_bc_bin[mom_bin]->Fill(DT_proton,weight);
 
-	    h_edge_first_CD_bc->Fill(edge_first,weight);
-	    h_edge_last_CD_bc->Fill(edge_last,weight);
+	      h_edge_first_CD_bc->Fill(edge_first,weight);
+	      h_edge_last_CD_bc->Fill(edge_last,weight);
+	    }
 
 	    if(!pass_fid){
-	      h_mom_ToFToF_d_ToFMom_CD_bad->Fill(mom,DT_proton,weight);  		
-	      h_ToFToF_d_ToFMom_CD_bad_bin[mom_bin]->Fill(DT_proton,weight);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mom_ToFToF_d_ToFMom_CD_bad->Fill(mom,DT_proton,weight);  		
+		h_ToFToF_d_ToFMom_CD_bad_bin[mom_bin]->Fill(DT_proton,weight);
+	      }
 	      continue;
 	    }
 	    
-	    h_mom_ToFToF_d_ToFMom_CD_ac->Fill(mom,DT_proton,weight);
-	    h_ToFToF_d_ToFMom_CD_ac_bin[mom_bin]->Fill(DT_proton,weight);
-	    h_theta_CD_ac->Fill(theta,weight);		  
-	    h_phi_momT_CD_ac->Fill(phi,momT,weight);
-
-
-	    //pid
-	    h_StartTime->Fill(c12->event()->getStartTime(),weight);
-	    h_HitTime->Fill((*p)->getTime(),weight);
-	    h_ToF->Fill((*p)->getTime()-c12->event()->getStartTime(),weight);
-	    h_Path->Fill((*p)->getPath(),weight);
-	    h_ToF_Path->Fill((*p)->getTime(),(*p)->getPath(),weight);
-	    h_mom_DT->Fill(mom,DT_proton,weight);
-	    h_mom_beta->Fill(mom,beta,weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_mom_ToFToF_d_ToFMom_CD_ac->Fill(mom,DT_proton,weight);
+	      h_ToFToF_d_ToFMom_CD_ac_bin[mom_bin]->Fill(DT_proton,weight);
+	      h_theta_CD_ac->Fill(theta,weight);		  
+	      h_phi_momT_CD_ac->Fill(phi,momT,weight);
+
+
+	      //pid
+	      h_StartTime->Fill(c12->event()->getStartTime(),weight);
+	      h_HitTime->Fill((*p)->getTime(),weight);
+	      h_ToF->Fill((*p)->getTime()-c12->event()->getStartTime(),weight);
+	      h_Path->Fill((*p)->getPath(),weight);
+	      h_ToF_Path->Fill((*p)->getTime(),(*p)->getPath(),weight);
+	      h_mom_DT->Fill(mom,DT_proton,weight);
+	      h_mom_beta->Fill(mom,beta,weight);
+	    }
 	    if((mom>1.27) && (mom<1.3)){
 	      h_mom125_beta->Fill(beta,weight);}
-	    h_DT_mom_bin[mom_bin]->Fill(DT_proton,weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_DT_mom_bin[mom_bin]->Fill(DT_proton,weight);
+	    }
 	    int theta_bin = theta<60?0:theta<80?1:2;
 	    int phi_bin = phi<-120?0:phi<-60?1:phi<0?2:phi<60?3:phi<120?4:5;
-	    h_mom_DT_theta_phi_bin[phi_bin][theta_bin]->Fill(mom,DT_proton,weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_mom_DT_theta_phi_bin[phi_bin][theta_bin]->Fill(mom,DT_proton,weight);
+	    }
 
 	    if(hpid==2212){
-	      h_mom_beta_2212->Fill(mom,beta,weight);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mom_beta_2212->Fill(mom,beta,weight);
+	      }
 	      if((mom>1.27) && (mom<1.3)){
 		h_mom125_beta_2212->Fill(beta,weight);}
 	    }
 
 	    if(pass_cut(mom,DT_proton,2) && (DT_proton>-0.75)){
-	      h_mom_DT_wPID->Fill(mom,DT_proton,weight);
-	      h_mom_beta_wPID->Fill(mom,beta,weight);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mom_DT_wPID->Fill(mom,DT_proton,weight);
+		h_mom_beta_wPID->Fill(mom,beta,weight);
+	      }
 	      if((mom>1.27) && (mom<1.3)){
 		h_mom125_beta_wPID->Fill(beta,weight);}
+	      auto fill_timer = stats.time(jobStage::Fill);
 	      h_mom_Chi2PID_wPID->Fill(mom,Chi2PID,weight);
 	      h_Chi2PID_wPID->Fill(Chi2PID,weight);
 	    }
@@ -403,6 +426,8 @@ int main(int argc, char ** argv)
 	}
     }
 
+  auto write_timer = stats.time(jobStage::Write);
+
   //clasAna.WriteDebugPlots();
   char temp[100];
   TGraph * g_phi[3];
@@ -691,6 +716,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
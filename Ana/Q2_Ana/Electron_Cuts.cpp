@@ -16,6 +16,7 @@
 #include <TStyle.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -55,9 +56,11 @@ int main(int argc, char ** argv)
   clas12ana clasAna2;
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("Electron_Cuts");
   for(int k = 3; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -167,15 +170,16 @@ int main(int argc, char ** argv)
     h_Chi2DoF_bc[i] = new TH1D(temp_name,temp_title,100,0,100);
   }
 
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
 
       //Display completed  
       counter++;
-      clasAna.Run(c12);
-      clasAna2.Run(c12);
+      stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
+      stats.timed(jobStage::Selection,[&]{clasAna2.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       auto protons = clasAna.getByPid(2212);
 
@@ -189,39 +193,57 @@ int main(int argc, char ** argv)
 	  TLorentzVector q = beam - el; //photon  4-vector            
           double Q2        = -q.M2(); // Q^2
           double xB       = Q2/(2 * mass_p * (beam.E() - el.E()) ); //x-borken
-	  h_Q2_bc->Fill(Q2);
-	  h_xB_bc->Fill(xB);
-	  h_phi_theta_bc->Fill(el.Phi()*180/M_PI,el.Theta()*180/M_PI);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_Q2_bc->Fill(Q2);
+	    h_xB_bc->Fill(xB);
+	    h_phi_theta_bc->Fill(el.Phi()*180/M_PI,el.Theta()*180/M_PI);
+	  }
 
 	  int nphe = electrons[0]->che(HTCC)->getNphe();
-	  h_nphe_bc->Fill(nphe);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_nphe_bc->Fill(nphe);
+	  }
 
 	  double PCedep = electrons[0]->cal(PCAL)->getEnergy();
 	  double ECINedep = electrons[0]->cal(ECIN)->getEnergy();
 	  double ECOUTedep = electrons[0]->cal(ECOUT)->getEnergy();
-	  h_PCedep_bc->Fill(PCedep);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_PCedep_bc->Fill(PCedep);
+	  }
 
 	  double SF = (PCedep + ECINedep + ECOUTedep)/el.Rho();
 	  int esector = electrons[0]->getSector();
-	  h_mom_SF_bc[esector-1]->Fill(el.Rho(),SF);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_mom_SF_bc[esector-1]->Fill(el.Rho(),SF);
 
-	  h_PCedep_SF_bc[esector-1]->Fill(PCedep,SF);
+	    h_PCedep_SF_bc[esector-1]->Fill(PCedep,SF);
+	  }
 
 	  ///////////////////////////////////////////
 	  if(electrons_check.size() != 1){continue;}	
 
-	  h_mom_SF_ac[esector-1]->Fill(el.Rho(),SF);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_mom_SF_ac[esector-1]->Fill(el.Rho(),SF);
 		  
-	  h_PCedep_SF_ac[esector-1]->Fill(PCedep,SF);
+	    h_PCedep_SF_ac[esector-1]->Fill(PCedep,SF);
 
-	  h_PCSF_ECINSF_bc[esector-1]->Fill(PCedep/el.Rho(),ECINedep/el.Rho());
+	    h_PCSF_ECINSF_bc[esector-1]->Fill(PCedep/el.Rho(),ECINedep/el.Rho());
+	  }
 
 	  double vtz_e = electrons[0]->par()->getVz();
-	  h_vtz_e_bc->Fill(vtz_e);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_vtz_e_bc->Fill(vtz_e);
 
-	  h_Vcal_SF_bc[esector-1]->Fill(electrons[0]->cal(PCAL)->getLv(),SF);
+	    h_Vcal_SF_bc[esector-1]->Fill(electrons[0]->cal(PCAL)->getLv(),SF);
 
-	  h_Wcal_SF_bc[esector-1]->Fill(electrons[0]->cal(PCAL)->getLw(),SF);
+	    h_Wcal_SF_bc[esector-1]->Fill(electrons[0]->cal(PCAL)->getLw(),SF);
+	  }
 
 	  double DCedge[3];
 	  DCedge[0]  = electrons[0]->traj(DC,6 )->getFloat("edge",electrons[0]->traj(DC,6 )->getIndex());
@@ -230,14 +252,18 @@ int main(int argc, char ** argv)
 	  double Chi2DoF = electrons[0]->trk(DC)->getChi2()/electrons[0]->trk(DC)->getNDF();
 
 	  for(int k=0; k<3; k++){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_DCedge_bc[k][esector-1]->Fill(DCedge[k]);
 	    h_DCedge_weight_bc[k][esector-1]->Fill(DCedge[k],Chi2DoF);
 	  }
 	  
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_Chi2DoF_bc[esector-1]->Fill(Chi2DoF);
 	}
     }
 
+  auto write_timer = stats.time(jobStage::Write);
+
   //clasAna.WriteDebugPlots();
 
   TFile *f = new TFile(outFile,"RECREATE");
@@ -386,6 +412,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
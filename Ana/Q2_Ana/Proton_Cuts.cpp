@@ -16,6 +16,7 @@
 #include <TStyle.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -79,9 +80,11 @@ int main(int argc, char ** argv)
     
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("Proton_Cuts");
   for(int k = 3; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -201,21 +204,16 @@ int main(int argc, char ** argv)
   //clasAna.setVzcuts(-6,1);
   //clasAna.setVertexCorrCuts(-3,1);
 
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
 
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
-
- clasAna.Run(c12);
+
+ stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       auto protons = clasAna.getByPid(2212);
       auto pionplus = clasAna.getByPid(211);
@@ -230,9 +228,12 @@ int main(int argc, char ** argv)
 	  TLorentzVector q = beam - el; //photon  4-vector            
           double Q2        = -q.M2(); // Q^2
           double xB       = Q2/(2 * mass_p * (beam.E() - el.E()) ); //x-borken
-	  h_Q2_bc->Fill(Q2);
-	  h_xB_bc->Fill(xB);
-	  h_phi_theta_bc->Fill(el.Phi()*180/M_PI,el.Theta()*180/M_PI);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_Q2_bc->Fill(Q2);
+	    h_xB_bc->Fill(xB);
+	    h_phi_theta_bc->Fill(el.Phi()*180/M_PI,el.Theta()*180/M_PI);
+	  }
 	  double vtz_e = electrons[0]->par()->getVz();
 	  
 	  ///////////////////////////////
@@ -273,25 +274,35 @@ int main(int argc, char ** argv)
 	      //fid
 	      bool pass_fiducial = true;
 	      for(int k=0; k<3; k++){
-		h_DCedge_FD_bc[k][psector-1]->Fill(DCedge[k]);
-		h_DCedge_weight_FD_bc[k][psector-1]->Fill(DCedge[k],Chi2DoF);
+		{
+		  auto fill_timer = stats.time(jobStage::Fill);
+		  h_DCedge_FD_bc[k][psector-1]->Fill(DCedge[k]);
+		  h_DCedge_weight_FD_bc[k][psector-1]->Fill(DCedge[k],Chi2DoF);
+		}
 		if(DCedge[k]<10){pass_fiducial=false;}
 	      }
 	      if(!pass_fiducial){continue;}
 	      //vertex
-	      h_vtz_FD_bc->Fill(vtz_p);
-	      h_diffvtz_FD_bc->Fill(vtz_e-vtz_p);
-	      h_vtz_e_p_FD_bc->Fill(vtz_e,vtz_p);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_vtz_FD_bc->Fill(vtz_p);
+		h_diffvtz_FD_bc->Fill(vtz_e-vtz_p);
+		h_vtz_e_p_FD_bc->Fill(vtz_e,vtz_p);
+	      }
 	      if(fabs(vtz_e-vtz_p)>2){continue;}
-	      h_vtz_FD_ac->Fill(vtz_p);
-	      h_diffvtz_FD_ac->Fill(vtz_e-vtz_p);
-	      h_vtz_e_p_FD_ac->Fill(vtz_e,vtz_p);
-
-	      //pid
-	      h_mom_beta_FD_bc->Fill(lead_ptr.Rho(),beta);
-	      h_Chi2PID_FD_bc->Fill(Chi2PID);
-	      h_mom_Chi2PID_FD_bc->Fill(lead_ptr.Rho(),Chi2PID);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_vtz_FD_ac->Fill(vtz_p);
+		h_diffvtz_FD_ac->Fill(vtz_e-vtz_p);
+		h_vtz_e_p_FD_ac->Fill(vtz_e,vtz_p);
+
+		//pid
+		h_mom_beta_FD_bc->Fill(lead_ptr.Rho(),beta);
+		h_Chi2PID_FD_bc->Fill(Chi2PID);
+		h_mom_Chi2PID_FD_bc->Fill(lead_ptr.Rho(),Chi2PID);
+	      }
 	      if(fabs(Chi2PID)>4){continue;}
+	      auto fill_timer = stats.time(jobStage::Fill);
 	      h_mom_beta_FD_ac->Fill(lead_ptr.Rho(),beta);
 	      h_Chi2PID_FD_ac->Fill(Chi2PID);
 	      h_mom_Chi2PID_FD_ac->Fill(lead_ptr.Rho(),Chi2PID);
@@ -301,32 +312,45 @@ int main(int argc, char ** argv)
 	    else if((*p)->getRegion() == CD){
 
 	      //fid
-	      h_mom_ToFToF_d_ToFMom_CD_bc->Fill(mom,DT_proton);  
-	      h_theta_CD_bc->Fill(theta);
-	      h_phi_momT_CD_bc->Fill(phi,momT);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mom_ToFToF_d_ToFMom_CD_bc->Fill(mom,DT_proton);  
+		h_theta_CD_bc->Fill(theta);
+		h_phi_momT_CD_bc->Fill(phi,momT);
+	      }
 	      if(!CD_fiducial(phi,theta,momT)){
-		h_mom_ToFToF_d_ToFMom_CD_bad->Fill(mom,DT_proton);  		
+		{
+		  auto fill_timer = stats.time(jobStage::Fill);
+		  h_mom_ToFToF_d_ToFMom_CD_bad->Fill(mom,DT_proton);  		
+		}
 		continue;
 	      }
 	      	      
-	      h_mom_ToFToF_d_ToFMom_CD_ac->Fill(mom,DT_proton);
-	      h_theta_CD_ac->Fill(theta);		  
-	      h_phi_momT_CD_ac->Fill(phi,momT);
-
-	      //vertex
-	      h_vtz_CD_bc->Fill(vtz_p);
-	      h_diffvtz_CD_bc->Fill(vtz_e-vtz_p);
-	      h_vtz_e_p_CD_bc->Fill(vtz_e,vtz_p);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mom_ToFToF_d_ToFMom_CD_ac->Fill(mom,DT_proton);
+		h_theta_CD_ac->Fill(theta);		  
+		h_phi_momT_CD_ac->Fill(phi,momT);
+
+		//vertex
+		h_vtz_CD_bc->Fill(vtz_p);
+		h_diffvtz_CD_bc->Fill(vtz_e-vtz_p);
+		h_vtz_e_p_CD_bc->Fill(vtz_e,vtz_p);
+	      }
 	      if(fabs(vtz_e-vtz_p)>2){continue;}
-	      h_vtz_CD_ac->Fill(vtz_p);
-	      h_diffvtz_CD_ac->Fill(vtz_e-vtz_p);
-	      h_vtz_e_p_CD_ac->Fill(vtz_e,vtz_p);
-
-	      //pid
-	      h_mom_beta_CD_bc->Fill(lead_ptr.Rho(),beta);
-	      h_Chi2PID_CD_bc->Fill(Chi2PID);
-	      h_mom_Chi2PID_CD_bc->Fill(lead_ptr.Rho(),Chi2PID);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_vtz_CD_ac->Fill(vtz_p);
+		h_diffvtz_CD_ac->Fill(vtz_e-vtz_p);
+		h_vtz_e_p_CD_ac->Fill(vtz_e,vtz_p);
+
+		//pid
+		h_mom_beta_CD_bc->Fill(lead_ptr.Rho(),beta);
+		h_Chi2PID_CD_bc->Fill(Chi2PID);
+		h_mom_Chi2PID_CD_bc->Fill(lead_ptr.Rho(),Chi2PID);
+	      }
 	      if(fabs(Chi2PID)>4){continue;}
+	      auto fill_timer = stats.time(jobStage::Fill);
 	      h_mom_beta_CD_ac->Fill(lead_ptr.Rho(),beta);
 	      h_Chi2PID_CD_ac->Fill(Chi2PID);
 	      h_mom_Chi2PID_CD_ac->Fill(lead_ptr.Rho(),Chi2PID);
@@ -354,11 +378,13 @@ int main(int argc, char ** argv)
 	    double td = ((*p)->getTime()-c12->event()->getStartTime()) - time_frommom;
 
 	    if((*p)->getRegion() == FD){
+	      auto fill_timer = stats.time(jobStage::Fill);
 	      h_mom_beta_FD_ac->Fill(lead_ptr.Rho(),beta);
 	      h_Chi2PID_FD_ac->Fill(Chi2PID);
 	      h_TimeDiff_FD_ac->Fill(td);
 	    }
 	    else if((*p)->getRegion() == CD){
+	      auto fill_timer = stats.time(jobStage::Fill);
 	      h_mom_beta_CD_ac->Fill(lead_ptr.Rho(),beta);
 	      h_Chi2PID_CD_ac->Fill(Chi2PID);
 	      h_TimeDiff_CD_ac->Fill(td);
@@ -371,6 +397,8 @@ int main(int argc, char ** argv)
 	}
     }
 
+  auto write_timer = stats.time(jobStage::Write);
+
   //clasAna.WriteDebugPlots();
 
   TFile *f = new TFile(outFile,"RECREATE");
@@ -514,6 +542,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
@@ -16,6 +16,7 @@
 #include <TStyle.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 #include "TGraph.h"
 #include "TFitResult.h"
@@ -107,9 +108,11 @@ int main(int argc, char ** argv)
   clasAna.printParams();
     
   clas12root::HipoChain chain;
+  clas12jobstats stats("Q2_dependence");
   for(int k = 4; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -274,8 +277,9 @@ int main(int argc, char ** argv)
   double num = 0;
   double den = 0;
   
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double wep = 1;
       double wepp = 1;
@@ -289,16 +293,10 @@ int main(int argc, char ** argv)
 
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
 
       //Display completed  
       counter++;
-      clasAna.Run(c12);
+      stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       auto protons = clasAna.getByPid(2212);
       if(electrons.size() == 1 && protons.size() >= 1)
@@ -338,14 +336,18 @@ int main(int argc, char ** argv)
 	      if((lead[0]->getRegion()==CD)){		
 		h_vtz_e_l->Fill(vtz_e,vtz_l,wepp);}
 
-	      h_pmiss_SRC->Fill(miss.P(),wep);
-	      h_Q2_SRC_Q2bin[binQ2(Q2)]->Fill(Q2,wep);
-	      h_pmiss_SRC_Q2bin[binQ2(Q2)]->Fill(miss.P(),wep);	      
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_pmiss_SRC->Fill(miss.P(),wep);
+		h_Q2_SRC_Q2bin[binQ2(Q2)]->Fill(Q2,wep);
+		h_pmiss_SRC_Q2bin[binQ2(Q2)]->Fill(miss.P(),wep);	      
 	      
-	      h_pLead_ep->Fill(lead_ptr.P(),wep);
-	      h_pMiss_ep->Fill(miss.P(),wep);
+		h_pLead_ep->Fill(lead_ptr.P(),wep);
+		h_pMiss_ep->Fill(miss.P(),wep);
+	      }
 
 	      if(bp!=-1){
+		auto fill_timer = stats.time(jobStage::Fill);
 		h_Q2_SRC_pmissbin[bp]->Fill(Q2,wep);
 		h_emiss_SRC_pmissbin[bp]->Fill(emiss,wep);
 	      }
@@ -364,38 +366,49 @@ int main(int argc, char ** argv)
 		TVector3 vx = vt.Cross(vy).Unit();
 		double vtz_r = recoil[0]->par()->getVz();
 
-		h_vtz_e_r->Fill(vtz_e,vtz_r,wepp);
-		h_vtz_l_r->Fill(vtz_l,vtz_r,wepp);
+		{
+		  auto fill_timer = stats.time(jobStage::Fill);
+		  h_vtz_e_r->Fill(vtz_e,vtz_r,wepp);
+		  h_vtz_l_r->Fill(vtz_l,vtz_r,wepp);
+		}
 		if((lead[0]->getRegion()==FD) && (recoil[0]->getRegion()==CD)){
+		  auto fill_timer = stats.time(jobStage::Fill);
 		  h_vtz_l_r_FD_CD->Fill(vtz_l,vtz_r,wepp);
 		}
 		if((lead[0]->getRegion()==CD) && (recoil[0]->getRegion()==FD)){
+		  auto fill_timer = stats.time(jobStage::Fill);
 		  h_vtz_l_r_CD_FD->Fill(vtz_l,vtz_r,wepp);
 		}
 		if((lead[0]->getRegion()==CD) && (recoil[0]->getRegion()==CD)){
+		  auto fill_timer = stats.time(jobStage::Fill);
 		  h_vtz_l_r_CD_CD->Fill(vtz_l,vtz_r,wepp);
 		}
 
-		h_thetamissrec_epp->Fill(v_miss.Angle(v_rec)*180/M_PI,wepp);
+		{
+		  auto fill_timer = stats.time(jobStage::Fill);
+		  h_thetamissrec_epp->Fill(v_miss.Angle(v_rec)*180/M_PI,wepp);
 
 		
-		h_pmiss_Rec->Fill(miss.P(),wepp);
+		  h_pmiss_Rec->Fill(miss.P(),wepp);
 
-		h_pLead_epp->Fill(lead_ptr.P(),wepp);
-		h_pMiss_epp->Fill(miss.P(),wepp);
-		h_pRec_epp->Fill(recoil_ptr.P(),wepp);
-		h_thetaRec_epp->Fill(recoil_ptr.Theta()*180/M_PI,wepp);
-		h_phiRec_epp->Fill(recoil_ptr.Phi()*180/M_PI,wepp);
+		  h_pLead_epp->Fill(lead_ptr.P(),wepp);
+		  h_pMiss_epp->Fill(miss.P(),wepp);
+		  h_pRec_epp->Fill(recoil_ptr.P(),wepp);
+		  h_thetaRec_epp->Fill(recoil_ptr.Theta()*180/M_PI,wepp);
+		  h_phiRec_epp->Fill(recoil_ptr.Phi()*180/M_PI,wepp);
 		
-		h_Q2_Rec_Q2bin[binQ2(Q2)]->Fill(Q2,wepp);
-		h_p_z_cm_Rec->Fill(v_cm.Dot(vt),wepp);
-		h_p_y_cm_Rec->Fill(v_cm.Dot(vy),wepp);
-		h_p_x_cm_Rec->Fill(v_cm.Dot(vx),wepp);
+		  h_Q2_Rec_Q2bin[binQ2(Q2)]->Fill(Q2,wepp);
+		  h_p_z_cm_Rec->Fill(v_cm.Dot(vt),wepp);
+		  h_p_y_cm_Rec->Fill(v_cm.Dot(vy),wepp);
+		  h_p_x_cm_Rec->Fill(v_cm.Dot(vx),wepp);
+		}
 		if(bp!=-1){
+		  auto fill_timer = stats.time(jobStage::Fill);
 		  h_Q2_Rec_pmissbin[bp]->Fill(Q2,wepp);
 		  h_emiss_Rec_pmissbin[bp]->Fill(emiss,wepp);
 		}
 		
+		auto fill_timer = stats.time(jobStage::Fill);
 		h_pmiss_Rec_Q2bin[binQ2(Q2)]->Fill(miss.P(),wepp);
 		h_p_z_cm_Rec_Q2bin[binQ2(Q2)]->Fill(v_cm.Dot(vt),wepp);
 		h_p_y_cm_Rec_Q2bin[binQ2(Q2)]->Fill(v_cm.Dot(vy),wepp);
@@ -407,6 +420,8 @@ int main(int argc, char ** argv)
 
 	}
     }
+
+  auto write_timer = stats.time(jobStage::Write);
   
   /*
   TGraph * g_Q2_p_y_cm = new TGraph();
@@ -486,6 +501,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
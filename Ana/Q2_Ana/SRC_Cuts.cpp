@@ -17,6 +17,7 @@
 #include <TLine.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -101,9 +102,11 @@ int main(int argc, char ** argv)
   clas12ana clasAna;
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("SRC_Cuts");
   for(int k = 4; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -277,21 +280,16 @@ int main(int argc, char ** argv)
   TH1D * h_doublelead = new TH1D("doublelead","Number of Protons Passing SRC Cuts;Proton Number",5,1,6);
 
 
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
 
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
-
- clasAna.Run(c12);
+
+ stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       auto protons = clasAna.getByPid(2212);
       auto particles = c12->getDetParticles(); //particles is now
@@ -308,10 +306,13 @@ int main(int argc, char ** argv)
           Q2        = -q.M2(); // Q^2
           xB       = Q2/(2 * mass_p * (beam.E() - el.E()) ); //x-bjorken
           double omega = beam.E() - el.E();
-	  h_Q2_bc->Fill(Q2);
-	  h_xB_bc->Fill(xB);
-	  h_phi_theta_bc->Fill(el.Phi()*180/M_PI,el.Theta()*180/M_PI);
-          h_qmag_qtheta->Fill(-1*q.Mag(),q.Vect().Theta()*180./M_PI);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_Q2_bc->Fill(Q2);
+	    h_xB_bc->Fill(xB);
+	    h_phi_theta_bc->Fill(el.Phi()*180/M_PI,el.Theta()*180/M_PI);
+	    h_qmag_qtheta->Fill(-1*q.Mag(),q.Vect().Theta()*180./M_PI);
+	  }
 	  double vtz_e = electrons[0]->par()->getVz();
 
           // define final lead kinematics - use these after first proton loop (see warning below)
@@ -357,65 +358,119 @@ int main(int argc, char ** argv)
 
 	    if(beta<0.2){continue;} // proton cut
 
-            tree->Fill();
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      tree->Fill();
+	    }
 
 
             // FORWARD DETECTOR PROTONS
 	    if((*p)->getRegion() == FD){
 
-              h_thetae_q2_fd->Fill(Q2,el.Theta()*180./M_PI);
-              h_thetae_q2_all->Fill(Q2,el.Theta()*180./M_PI);
-              h_thetap_q2_all->Fill(Q2,theta);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_thetae_q2_fd->Fill(Q2,el.Theta()*180./M_PI);
+		h_thetae_q2_all->Fill(Q2,el.Theta()*180./M_PI);
+		h_thetap_q2_all->Fill(Q2,theta);
 
-              // plead cut
-              h_plead_all->Fill(mom);
-              h_plead_fd->Fill(mom);
+		// plead cut
+		h_plead_all->Fill(mom);
+		h_plead_fd->Fill(mom);
+	      }
               if (mom<1.0) {continue;}
 
               // SRC histograms here - FD
-              h_mmiss_nocuts_fd->Fill(mmiss);
-              h_mmiss_xb_fd->Fill(xB,mmiss);
-              h_mmiss_nocuts_all->Fill(mmiss);
-              h_mmiss_xb_all->Fill(xB,mmiss);
-              h_xb_fd->Fill(xB);
-            h_xb_all->Fill(xB);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_nocuts_fd->Fill(mmiss);
+		h_mmiss_xb_fd->Fill(xB,mmiss);
+		h_mmiss_nocuts_all->Fill(mmiss);
+		h_mmiss_xb_all->Fill(xB,mmiss);
+		h_xb_fd->Fill(xB);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_xb_all->Fill(xB);
+	    }
               if (xB<1.2) {continue;}
 
 
-              h_pmiss_fd->Fill(pmiss.Mag());
-            h_pmiss_all->Fill(pmiss.Mag());
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_pmiss_fd->Fill(pmiss.Mag());
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_pmiss_all->Fill(pmiss.Mag());
+	    }
               if (pmiss.Mag()<0.35 || pmiss.Mag()>1.0) {continue;}
 
-              h_mmiss_q2_fd->Fill(Q2,mmiss);
-            h_mmiss_q2_all->Fill(Q2,mmiss);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_q2_fd->Fill(Q2,mmiss);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_mmiss_q2_all->Fill(Q2,mmiss);
+	    }
 
 
-              h_q2_fd->Fill(Q2);
-            h_q2_all->Fill(Q2);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_q2_fd->Fill(Q2);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_q2_all->Fill(Q2);
+	    }
               if (Q2<1.5) {continue;}
 
 
-              h_mmiss_thetapq_fd->Fill(thetapq,mmiss);
-              h_mmiss_pq_fd->Fill(pq,mmiss);
-              h_thetapq_pq_fd->Fill(pq,thetapq);
-            h_thetapq_pq_all->Fill(pq,thetapq);
-            h_mmiss_thetapq_all->Fill(thetapq,mmiss);
-            h_mmiss_pq_all->Fill(pq,mmiss);
-              h_thetapmq_pq_fd->Fill(pq,theta_pmq);
-            h_thetapmq_pq_all->Fill(pq,theta_pmq);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_thetapq_fd->Fill(thetapq,mmiss);
+		h_mmiss_pq_fd->Fill(pq,mmiss);
+		h_thetapq_pq_fd->Fill(pq,thetapq);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_thetapq_pq_all->Fill(pq,thetapq);
+	      h_mmiss_thetapq_all->Fill(thetapq,mmiss);
+	      h_mmiss_pq_all->Fill(pq,mmiss);
+	    }
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_thetapmq_pq_fd->Fill(pq,theta_pmq);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_thetapmq_pq_all->Fill(pq,theta_pmq);
+	    }
 
               //if (thetapq>25) {continue;}
               //if (pq<0.62) {continue;}
               if (pq>0.96) {continue;}
 
 
-              h_mmiss_fd->Fill(mmiss);
-            h_mmiss_all->Fill(mmiss);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_fd->Fill(mmiss);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_mmiss_all->Fill(mmiss);
+	    }
               if (mmiss>1.1) {continue;}
-              h_p_theta_fd->Fill(theta,mom);
-            h_p_theta_all->Fill(theta,mom);
-            h_pmiss_src_all->Fill(pmiss.Mag());
-            h_xb_q2_src_all->Fill(Q2,xB);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_p_theta_fd->Fill(theta,mom);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_p_theta_all->Fill(theta,mom);
+	      h_pmiss_src_all->Fill(pmiss.Mag());
+	      h_xb_q2_src_all->Fill(Q2,xB);
+	    }
 
 
               // define kinematics for lead proton (valid past this proton loop)
@@ -439,57 +494,105 @@ int main(int argc, char ** argv)
 		continue;
 	      }
 
-              h_thetae_q2_cd->Fill(Q2,el.Theta()*180./M_PI);
-              h_thetae_q2_all->Fill(Q2,el.Theta()*180./M_PI);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_thetae_q2_cd->Fill(Q2,el.Theta()*180./M_PI);
+		h_thetae_q2_all->Fill(Q2,el.Theta()*180./M_PI);
 
-              // plead cut
-              h_plead_all->Fill(mom);
-              h_plead_cd->Fill(mom);
+		// plead cut
+		h_plead_all->Fill(mom);
+		h_plead_cd->Fill(mom);
+	      }
               if (mom<1.0) {continue;}
 
               // SRC histograms here - CD
-              h_mmiss_nocuts_cd->Fill(mmiss);
-              h_mmiss_xb_cd->Fill(xB,mmiss);  // define
-              h_mmiss_nocuts_all->Fill(mmiss);
-              h_mmiss_xb_all->Fill(xB,mmiss);
-              h_xb_cd->Fill(xB);
-              h_xb_all->Fill(xB);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_nocuts_cd->Fill(mmiss);
+		h_mmiss_xb_cd->Fill(xB,mmiss);  // define
+		h_mmiss_nocuts_all->Fill(mmiss);
+		h_mmiss_xb_all->Fill(xB,mmiss);
+		h_xb_cd->Fill(xB);
+		h_xb_all->Fill(xB);
+	      }
               if (xB<1.2) {continue;}
 
 
-              h_pmiss_cd->Fill(pmiss.Mag());
-            h_pmiss_all->Fill(pmiss.Mag());
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_pmiss_cd->Fill(pmiss.Mag());
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_pmiss_all->Fill(pmiss.Mag());
+	    }
               if (pmiss.Mag()<0.35 || pmiss.Mag()>1.0) {continue;}
 
 
-              h_mmiss_q2_cd->Fill(Q2,mmiss);  // define
-            h_mmiss_q2_all->Fill(Q2,mmiss);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_q2_cd->Fill(Q2,mmiss);  // define
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_mmiss_q2_all->Fill(Q2,mmiss);
+	    }
 
-              h_q2_cd->Fill(Q2);
-            h_q2_all->Fill(Q2);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_q2_cd->Fill(Q2);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_q2_all->Fill(Q2);
+	    }
               if (Q2<1.5) {continue;}
 
-              h_mmiss_thetapq_cd->Fill(thetapq,mmiss);
-              h_mmiss_pq_cd->Fill(pq,mmiss);
-              h_thetapq_pq_cd->Fill(pq,thetapq);
-            h_thetapq_pq_all->Fill(pq,thetapq);
-            h_mmiss_thetapq_all->Fill(thetapq,mmiss);
-            h_mmiss_pq_all->Fill(pq,mmiss);
-              h_thetapmq_pq_cd->Fill(pq,theta_pmq);
-            h_thetapmq_pq_all->Fill(pq,theta_pmq);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_thetapq_cd->Fill(thetapq,mmiss);
+		h_mmiss_pq_cd->Fill(pq,mmiss);
+		h_thetapq_pq_cd->Fill(pq,thetapq);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_thetapq_pq_all->Fill(pq,thetapq);
+	      h_mmiss_thetapq_all->Fill(thetapq,mmiss);
+	      h_mmiss_pq_all->Fill(pq,mmiss);
+	    }
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_thetapmq_pq_cd->Fill(pq,theta_pmq);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_thetapmq_pq_all->Fill(pq,theta_pmq);
+	    }
 
               //if (thetapq>25) {continue;}
               //if (pq<0.62) {continue;}
               if (pq>0.96) {continue;}
 
-              h_mmiss_cd->Fill(mmiss);
-            h_mmiss_all->Fill(mmiss);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mmiss_cd->Fill(mmiss);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_mmiss_all->Fill(mmiss);
+	    }
 
               if (mmiss>1.1) {continue;}
-              h_p_theta_cd->Fill(theta,mom);
-            h_p_theta_all->Fill(theta,mom);
-            h_pmiss_src_all->Fill(pmiss.Mag());
-            h_xb_q2_src_all->Fill(Q2,xB);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_p_theta_cd->Fill(theta,mom);
+	      }
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_p_theta_all->Fill(theta,mom);
+	      h_pmiss_src_all->Fill(pmiss.Mag());
+	      h_xb_q2_src_all->Fill(Q2,xB);
+	    }
 
 
               // define kinematics for lead proton (valid past this proton loop)
@@ -532,6 +635,7 @@ int main(int argc, char ** argv)
 
 
             // final e'p distributions after SRC cuts
+	    auto fill_timer = stats.time(jobStage::Fill);
             h_xb_final->Fill(xB);
             h_pmiss_final->Fill(pmiss.Mag());
             h_q2_final->Fill(Q2);
@@ -544,7 +648,10 @@ int main(int argc, char ** argv)
  
 	  } // end first loop over protons
 
-          if (num_lead>0) {h_doublelead->Fill(num_lead);}
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    if (num_lead>0) {h_doublelead->Fill(num_lead);}
+	  }
 
           if (pindex==-1) {continue;} // if no lead proton, skip to next event (don't look for recoil)
 
@@ -579,15 +686,22 @@ int main(int argc, char ** argv)
               double recoil_emiss = lead_emiss - recoil_ptr.E();
 
 	      //if(mom==0){continue;} // proton cut
-	      h_lead_rec->Fill(theta,lead_theta);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_lead_rec->Fill(theta,lead_theta);
+	      }
 
             if((*p)->getRegion() == CD){ // look in CD only
 
 
               // cut on momentum
-              h_prec->Fill(mom);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_prec->Fill(mom);
+	      }
               if (mom<0.35) {continue;}
               
+	      auto fill_timer = stats.time(jobStage::Fill);
               h_cos0->Fill(cos(lead_pmiss.Angle(recoil_ptr.Vect())));
 
               // histos for e'pp kinematics
@@ -613,6 +727,8 @@ int main(int argc, char ** argv)
 	} // end requirement for one electron in event
     } // end event loop
 
+  auto write_timer = stats.time(jobStage::Write);
+
   //clasAna.WriteDebugPlots();
 
 
@@ -1299,6 +1415,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
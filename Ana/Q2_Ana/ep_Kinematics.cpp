@@ -16,6 +16,7 @@
 #include <TStyle.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -63,9 +64,11 @@ int main(int argc, char ** argv)
     
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("ep_Kinematics");
   for(int k = 3; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -133,14 +136,15 @@ int main(int argc, char ** argv)
   clasAna.setVertexCorrCuts();
   //clasAna.setDCEdgeCuts();
   
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
 
       //Display completed  
       counter++;
-      clasAna.Run(c12);
+      stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       //auto electrons=c12->getByID(11);
       auto protons = clasAna.getByPid(2212);
@@ -164,6 +168,7 @@ int main(int argc, char ** argv)
 	      double TB = miss_Am1.E() - miss_Am1.M();
 	      double TP = lead_ptr.E() - lead_ptr.M();
 	      double Emiss = q.E() - TP - TB;
+	      auto fill_timer = stats.time(jobStage::Fill);
 	      //h_poq_thetapq->Fill(lead_ptr.Rho()/q.Rho(),lead_ptr.Angle(q.Vect())*180/M_PI);
 	      h_Emiss->Fill(Emiss);
 	      h_omega_Emiss->Fill(omega,Emiss);
@@ -177,6 +182,8 @@ int main(int argc, char ** argv)
 	}
     }
 
+  auto write_timer = stats.time(jobStage::Write);
+
   //clasAna.WriteDebugPlots();
 
   TFile *f = new TFile(outFile,"RECREATE");
@@ -218,6 +225,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
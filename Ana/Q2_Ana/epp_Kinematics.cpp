@@ -16,6 +16,7 @@
 #include <TStyle.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 #include "many_plots.h"
 
@@ -62,9 +63,11 @@ int main(int argc, char ** argv)
   clasAna.printParams();
     
   clas12root::HipoChain chain;
+  clas12jobstats stats("epp_Kinematics");
   for(int k = 3; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -172,23 +175,18 @@ int main(int argc, char ** argv)
   double num = 0;
   double den = 0;
   
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
 
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
 
       //Display completed  
       counter++;
-      clasAna.Run(c12);
+      stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
       auto electrons = clasAna.getByPid(11);
       auto protons = clasAna.getByPid(2212);
       if(electrons.size() == 1 && protons.size() >= 1)
@@ -280,6 +278,8 @@ int main(int argc, char ** argv)
 	}
     }
 
+  auto write_timer = stats.time(jobStage::Write);
+
   /////////////////////////////////////////////////////
   //Now create the output PDFs
   /////////////////////////////////////////////////////
@@ -315,6 +315,7 @@ int main(int argc, char ** argv)
   f->Close();
 
 
+  stats.summary();
   return 0;
 }
 
@@ -16,6 +16,7 @@
 #include <TStyle.h>
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -36,6 +37,7 @@ int main(int argc, char ** argv)
 {
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("example_ana");
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
 
@@ -61,6 +63,7 @@ int main(int argc, char ** argv)
 	{
 	  TString inFile(argv[i]);
 	  chain.Add(inFile);
+	  stats.addInputFile(inFile);
 	  cout<<"Input file "<< inFile << "\n";
 	}
     }
@@ -102,17 +105,18 @@ int main(int argc, char ** argv)
   TH1D * lead_theta   = new TH1D("lead_theta","Lead Theta ",100,0,180);
   TH1D * recoil_theta = new TH1D("recoil_theta","Recoil Theta ",100,0,180);
 
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       double weight = 1.;
       if(data_type)
 	weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
 
-      clasAna.Run(c12);
+      stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
 
-      auto electrons = clasAna.getByPid(11);
-      auto protons = clasAna.getByPid(2212);
+      auto &electrons = clasAna.getByPidView(11);
+      auto &protons = clasAna.getByPidView(2212);
 
       if(electrons.size() == 1)
 	{
@@ -129,14 +133,18 @@ int main(int argc, char ** argv)
 	  double p_q      = 0;
 	  double x_prime  = 0;
 
-	  q2_h->Fill(q2,weight);
-	  xb_h->Fill(x_b,weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    q2_h->Fill(q2,weight);
+	    xb_h->Fill(x_b,weight);
+	  }
 
-	  for(auto &p : clasAna.getByPid(2212))
+	  for(auto &p : clasAna.getByPidView(2212))
 	    {
 	      if(p->getRegion() == CD)
 		el_p_corr_cd->Fill(electrons[0]->par()->getVz()-p->par()->getVz());
 	      else if(p->getRegion() == FD)
+		auto fill_timer = stats.time(jobStage::Fill);
 		el_p_corr_fd->Fill(electrons[0]->par()->getVz()-p->par()->getVz());
 	    }
 
@@ -150,17 +158,24 @@ int main(int argc, char ** argv)
 
 	      SetLorentzVector(lead_ptr,lead[0]);
 	      TLorentzVector miss = beam + target - el - lead_ptr; //photon  4-vector            
-	      lead_theta->Fill(lead_ptr.Theta()*TMath::RadToDeg());
-	      ep_h->Fill(miss.P(),weight);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		lead_theta->Fill(lead_ptr.Theta()*TMath::RadToDeg());
+		ep_h->Fill(miss.P(),weight);
+	      }
 
 
 	      if(recoil.size() == 1)
 		{
-		  missm->Fill(miss.M());
+		  {
+		    auto fill_timer = stats.time(jobStage::Fill);
+		    missm->Fill(miss.M());
+		  }
 
 		  SetLorentzVector(recoil_ptr,recoil[0]);
 		  auto com_vec = clasAna.getCOM(lead_ptr,recoil_ptr,q);
 
+		  auto fill_timer = stats.time(jobStage::Fill);
 		  recoil_theta->Fill(recoil_ptr.Theta()*TMath::RadToDeg());
 		  
 		  px_com->Fill(com_vec.X(),weight);
@@ -177,6 +192,8 @@ int main(int argc, char ** argv)
 
     }
 
+  auto write_timer = stats.time(jobStage::Write);
+
 
   TFile f(outFile,"RECREATE");
   f.cd();
@@ -201,6 +218,7 @@ int main(int argc, char ** argv)
   f.Close();
 
 
+  stats.summary();
   return 0;
 }
 
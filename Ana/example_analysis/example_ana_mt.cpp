@@ -0,0 +1,158 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sstream>
+
+#include <TFile.h>
+#include <TLorentzVector.h>
+#include <TH1.h>
+#include <TDatabasePDG.h>
+#include "clas12parallel.h"
+#include "clas12ana.h"
+
+using namespace std;
+using namespace clas12;
+
+void SetLorentzVector(TLorentzVector &p4,clas12::region_part_ptr rp){
+  p4.SetXYZM(rp->par()->getPx(),rp->par()->getPy(),rp->par()->getPz(),p4.M());
+
+}
+
+void Usage()
+{
+  std::cerr << "Usage: ./example_ana_mt Nthreads Data(0)/MC(1) outputfile inputfile_1 inputfile_2 ... \n\n\n";
+}
+
+//histograms filled by one worker
+struct workerHists
+{
+  TH1D *q2_h;
+  TH1D *xb_h;
+  TH1D *ep_h;
+  TH1D *epp_h;
+  TH1D *missm;
+};
+
+
+int main(int argc, char ** argv)
+{
+
+  if(argc < 5)
+    {
+      Usage();
+      return -1;
+    }
+
+  int nthreads = atoi(argv[1]);
+  TString outFile = argv[3];
+  cout<<"Ouput file "<< outFile <<endl;
+  std::stringstream  ss(argv[2]);
+  bool data_type;
+  if(!(ss >> data_type))
+    {std::cerr << "Data type invalid use 0 or 1"<<std::endl; return -1;}
+
+  //cuts are configured once and copied to every worker
+  bool outputDebugPlots = false;
+  clas12ana clasAna(outputDebugPlots);
+
+  clas12parallel loop(clasAna,nthreads);
+  loop.SetReaderTags({0});
+  loop.TurnOffQADB();
+
+  for(int i = 4; i != argc; ++i)
+    {
+      TString inFile(argv[i]);
+      loop.Add(inFile);
+      cout<<"Input file "<< inFile << "\n";
+    }
+
+  auto db=TDatabasePDG::Instance();
+  double mass_p = db->GetParticle(2212)->Mass();
+  double mD = 1.8756;
+  double beam_E = 5.98;
+  double mass_el = db->GetParticle(11)->Mass();
+
+  auto init = [](int worker)
+    {
+      auto h = std::make_unique<workerHists>();
+      h->q2_h  = new TH1D(Form("q2_h_%d",worker),"Q^2 ",1000,0, 4);
+      h->xb_h  = new TH1D(Form("xb_h_%d",worker),"x_B ",1000,0, 4);
+      h->ep_h  = new TH1D(Form("ep_h_%d",worker),"(e,e'p)",100,0,2);
+      h->epp_h = new TH1D(Form("epp_h_%d",worker),"(e,e'pp)",100,0,2);
+      h->missm = new TH1D(Form("missm_%d",worker),"Missing mass",100,0.5,1.5);
+      return h;
+    };
+
+  auto process = [&](workerHists &h, clas12reader *c12, clas12ana &ana)
+    {
+      double weight = 1.;
+      if(data_type)
+	weight = c12->mcevent()->getWeight(); //used if MC events have a weight 
+
+      auto &electrons = ana.getByPidView(11);
+      if(electrons.size() != 1)
+	return;
+
+      TLorentzVector beam(0,0,beam_E,beam_E);
+      TLorentzVector target(0,0,0,mD);
+      TLorentzVector el(0,0,0,mass_el);
+      TLorentzVector lead_ptr(0,0,0,mass_p);
+      SetLorentzVector(el,electrons[0]);
+
+      TLorentzVector q = beam - el; //photon  4-vector            
+      double q2        = -q.M2(); // Q^2
+      double x_b       = q2/(2 * mass_p * (beam.E() - el.E()) ); //x-borken
+
+      h.q2_h->Fill(q2,weight);
+      h.xb_h->Fill(x_b,weight);
+
+      ana.getLeadRecoilSRC(beam,target,el);
+      auto lead    = ana.getLeadSRC();
+      auto recoil  = ana.getRecoilSRC();
+
+      if(lead.size() == 1)
+	{
+	  SetLorentzVector(lead_ptr,lead[0]);
+	  TLorentzVector miss = beam + target - el - lead_ptr;
+	  h.ep_h->Fill(miss.P(),weight);
+
+	  if(recoil.size() == 1)
+	    {
+	      h.missm->Fill(miss.M());
+	      h.epp_h->Fill(miss.P(),weight);
+	    }
+	}
+    };
+
+  auto hists = loop.Process<workerHists>(init,process);
+  cout<<"Processed "<<loop.getNEvents()<<" events with "<<hists.size()<<" workers"<<endl;
+
+  //cut flow table, filled when built with -DCLAS12ANA_CUTFLOW=1 or 2
+  loop.MergeCutFlow(clasAna);
+  clasAna.printCutFlow();
+
+  //merge in worker order
+  auto merge = [&](TH1D* workerHists::*h, TString name)
+    {
+      std::vector<TH1*> list;
+      for(auto &w : hists)
+	list.push_back(w.get()->*h);
+      auto out = clas12parallel::Merge(list);
+      if(out)
+	out->SetName(name);
+      return out;
+    };
+
+  TFile f(outFile,"RECREATE");
+  f.cd();
+
+  for(auto h : {merge(&workerHists::q2_h,"q2_h"), merge(&workerHists::xb_h,"xb_h"),
+	merge(&workerHists::ep_h,"ep_h"), merge(&workerHists::epp_h,"epp_h"), merge(&workerHists::missm,"missm")})
+    if(h)
+      h->Write();
+
+  f.Close();
+
+
+  return 0;
+}
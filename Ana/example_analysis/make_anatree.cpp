@@ -0,0 +1,81 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <TLorentzVector.h>
+#include "HipoChain.h"
+#include "clas12jobstats.h"
+#include "clas12ana.h"
+#include "clas12anatree.h"
+
+using namespace std;
+using namespace clas12;
+
+void Usage()
+{
+  std::cerr << "Writes the events selected by clas12ana to a columnar ROOT file \n";
+  std::cerr << "Usage: ./make_anatree Ebeam outputfile.root inputfile_1.hipo inputfile_2.hipo ... \n\n\n";
+}
+
+
+int main(int argc, char ** argv)
+{
+
+  if(argc < 4)
+    {
+      Usage();
+      return -1;
+    }
+
+  double beam_E = atof(argv[1]);
+  TString outFile = argv[2];
+  cout<<"Ouput file "<< outFile <<endl;
+
+  clas12root::HipoChain chain;
+  clas12jobstats stats("make_anatree");
+  chain.SetReaderTags({0});
+  chain.db()->turnOffQADB();
+
+  for(int i = 3; i != argc; ++i)
+    {
+      TString inFile(argv[i]);
+      chain.Add(inFile);
+      stats.addInputFile(inFile);
+      cout<<"Input file "<< inFile << "\n";
+    }
+
+  clas12ana clasAna;
+  clas12anatree tree(outFile,beam_E);
+
+  auto &c12=chain.C12ref();
+
+  double mD = 1.8756;
+  TLorentzVector beam(0,0,beam_E,beam_E);
+  TLorentzVector target(0,0,0,mD);
+  TLorentzVector el(0,0,0,0.000511);
+
+  while(stats.next(chain))
+    {
+      stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
+
+      auto analysis_timer = stats.time(jobStage::Analysis);
+      auto &electrons = clasAna.getByPidView(11);
+      if(electrons.size() != 1)
+	continue;
+
+      //lead/recoil flags are stored with the particles
+      el.SetXYZM(electrons[0]->par()->getPx(),electrons[0]->par()->getPy(),electrons[0]->par()->getPz(),el.M());
+      clasAna.getLeadRecoilSRC(beam,target,el);
+
+      auto fill_timer = stats.time(jobStage::Fill);
+      tree.Fill(c12,clasAna);
+    }
+
+  {
+    auto write_timer = stats.time(jobStage::Write);
+    tree.Close();
+  }
+  stats.summary();
+
+  return 0;
+}
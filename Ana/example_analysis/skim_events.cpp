@@ -17,7 +17,9 @@
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
 #include "HipoChainWriter.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
+#include "clas12prefilter.h"
 
 using namespace std;
 using namespace clas12;
@@ -49,6 +51,7 @@ int main(int argc, char ** argv)
   cout<<"Ouput file "<< outFile <<endl;
 
   clas12root::HipoChainWriter chain(outFile);
+  clas12jobstats stats("skim_events");
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
 
@@ -58,6 +61,7 @@ int main(int argc, char ** argv)
 	{
           TString inFile(argv[i]);
           chain.Add(inFile);
+          stats.addInputFile(inFile);
           cout<<"Input file "<< inFile << "\n";
 	}
     }
@@ -68,6 +72,10 @@ int main(int argc, char ** argv)
 
   auto config_c12=chain.GetC12Reader();
 
+  //only events with an electron candidate can pass the skim
+  clas12prefilter prefilter({"11 1"});
+  prefilter.configure(config_c12);
+
   //now get reference to (unique)ptr for accessing data in loop
   //this will point to the correct place when file changes
   //  const std::unique_ptr<clas12::clas12reader>& c12=chain.C12ref();
@@ -100,8 +108,9 @@ int main(int argc, char ** argv)
   TH1D *epp_h = new TH1D("epp_h","(e,e'pp)",100,0,2);
   TH1D *ep_h  = new TH1D("ep_h","(e,e'p)",100,0,2);
 
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto selection_timer = stats.time(jobStage::Selection);
       //Display completed  
       counter++;
 
@@ -122,7 +131,10 @@ int main(int argc, char ** argv)
 	}
 
       if(anyCD_protons)
-	chain.WriteEvent();
+	{
+	  auto write_timer = stats.time(jobStage::Write);
+	  chain.WriteEvent();
+	}
 
       /*
       //Example for Lead proton skims
@@ -146,6 +158,8 @@ int main(int argc, char ** argv)
 
     }
 
+  stats.summary();
+
 
   return 0;
 }
@@ -16,6 +16,7 @@
 #include "clas12reader.h"
 #include "clas12writer.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "efficiency/efficiency.h"
 #include "clas12ana.h"
 
@@ -61,9 +62,11 @@ int main(int argc, char ** argv) {
 
   // arg 5+: input hipo file
   clas12root::HipoChain chain;
+  clas12jobstats stats("ProtonEfficiency");
   for (int k=5; k<argc; k++) {
     std::cout << "Input file " << argv[k] << std::endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader(); 
   chain.SetReaderTags({0});
@@ -252,8 +255,9 @@ const double c = 29.9792458;
 
 
 int numevent = 0;
-  while(chain.Next())
+  while(stats.next(chain))
   {
+    auto analysis_timer = stats.time(jobStage::Analysis);
     // if multiple files in chain
     // we need to update when file changes
     if(currc12!=c12.get()){
@@ -262,7 +266,7 @@ int numevent = 0;
       c12writer.assignReader(*currc12);
     }
 
-    clasAna.Run(c12);
+    stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
     auto allParticles=c12->getDetParticles();
 
     auto elec = clasAna.getByPid(11);
@@ -307,7 +311,10 @@ int numevent = 0;
 //////////////////////////
 /////     PROTONS    /////
 //////////////////////////
-    h_psize->Fill(prot.size());
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_psize->Fill(prot.size());
+    }
     int p_index = -1;
     TVector3 pp1(0.,0.,0.);
     // technically not optimized - this doesn't address what happens if there are two protons passing cuts
@@ -321,21 +328,33 @@ int numevent = 0;
 
       // angle
       double p_theta = pp1.Theta()*180./M_PI;
-      h_pangles1->Fill(pp1.Phi()*180./M_PI,p_theta);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_pangles1->Fill(pp1.Phi()*180./M_PI,p_theta);
+      }
       bool p_is_FD = prot[i]->getRegion()==FD;
       if (!p_is_FD) {continue;}
 
       // momentum and dbeta
-      h_dbeta_p->Fill(pp1.Mag(),dbeta);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_dbeta_p->Fill(pp1.Mag(),dbeta);
+      }
       if (pp1.Mag() < 0.3) {continue;}
       if (dbeta<-0.015 || dbeta>0.015) {continue;} // make it tighter
 
       // vertex
-      h_vtz_ep->Fill(vzp-vze);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_vtz_ep->Fill(vzp-vze);
+      }
       if ((vzp-vze)<-4. || (vzp-vze)>4.) {continue;}
 
       /*// chipid
-      h_chipid->Fill(chipid);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_chipid->Fill(chipid);
+      }
       if (chipid<-3. || chipid>3.) {continue;}*/
 
       p_index = i;
@@ -357,23 +376,32 @@ int numevent = 0;
       // pion angles
       ppi.SetMagThetaPhi(piminus[i]->getP(),piminus[i]->getTheta(),piminus[i]->getPhi());
       double pi_theta = ppi.Theta()*180./M_PI;
-      h_piangles->Fill(ppi.Phi()*180./M_PI,pi_theta);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_piangles->Fill(ppi.Phi()*180./M_PI,pi_theta);
 
-      // pi theta
-      h_pitheta->Fill(pi_theta);
+	// pi theta
+	h_pitheta->Fill(pi_theta);
+      }
       bool is_FD = piminus[i]->getRegion()==FD;
       if (!is_FD) {continue;}
 
       // dbeta
       ppi.SetMagThetaPhi(piminus[i]->getP(),piminus[i]->getTheta(),piminus[i]->getPhi());
       double dbeta_pi = piminus[i]->par()->getBeta() - ppi.Mag()/sqrt(ppi.Mag2()+mPi*mPi);
-      h_dbeta_pi->Fill(ppi.Mag(),dbeta_pi);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_dbeta_pi->Fill(ppi.Mag(),dbeta_pi);
+      }
       if (ppi.Mag()<0.3) {continue;}
       if (dbeta_pi<-0.015|| dbeta_pi>0.015) {continue;}
 
       // vertex
       double vzpi = piminus[i]->par()->getVz();
-      h_dvz_pi->Fill(vzpi-vze);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_dvz_pi->Fill(vzpi-vze);
+      }
       if ((vzpi-vze)<-4. || (vzpi-vze)>4.) {continue;}
 
       // pick remaining pion
@@ -398,7 +426,10 @@ int numevent = 0;
     double mmiss = pow( pow( (nu + mD - Ep - Epi), 2.) - pmiss.Mag2() , 0.5);
 
     // pmiss should point to CD
-    h_thetamiss_phimiss->Fill(pmiss.Phi()*180./M_PI,pmiss.Theta()*180./M_PI);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_thetamiss_phimiss->Fill(pmiss.Phi()*180./M_PI,pmiss.Theta()*180./M_PI);
+    }
     if (pmiss.Theta()*180./M_PI<45 || pmiss.Theta()*180./M_PI>120) {continue;}
 
 
@@ -413,32 +444,40 @@ int numevent = 0;
     double min_mom_pt = 0.15;
     double cd_edge_cut = 10;
     double fiducial_phi = (-asin(min_mom_pt/pt) - M_PI/2.) * 180./M_PI;
-    h_pt_phi_before->Fill(phi,pt);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pt_phi_before->Fill(phi,pt);
+    }
     if ( (std::abs(phi-fiducial_phi) < cd_edge_cut) || (std::abs(phi-fiducial_phi-120) < cd_edge_cut) || (std::abs(phi-fiducial_phi-240) < cd_edge_cut) ) {continue;}
-    h_pt_phi_after->Fill(phi,pt);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pt_phi_after->Fill(phi,pt);
 
 
 
-    // fill denominator
-    h_mmiss_pmiss->Fill(pmiss.Mag(),mmiss);
-    h_mmiss_tmiss->Fill(pmiss.Theta()*180./M_PI,mmiss);
+      // fill denominator
+      h_mmiss_pmiss->Fill(pmiss.Mag(),mmiss);
+      h_mmiss_tmiss->Fill(pmiss.Theta()*180./M_PI,mmiss);
 
 
-    h_mmiss_cand->Fill(mmiss);
+      h_mmiss_cand->Fill(mmiss);
 
-    // fill denominator histos
-    h_eff_p_denom->Fill(pmiss.Mag());
+      // fill denominator histos
+      h_eff_p_denom->Fill(pmiss.Mag());
+    }
     // fill denominator by angle
     for (int k=0; k<9; k++)
     {
       if (pmiss_theta>(ang_range[k]) && pmiss_theta<(ang_range[k+1]))
       {
+	auto fill_timer = stats.time(jobStage::Fill);
         mmiss_pmiss_CAND9[k]->Fill(pmiss.Mag(),mmiss);
       }
     }
     
 
     if (mmiss>0.85 && mmiss<1.05) {
+      auto fill_timer = stats.time(jobStage::Fill);
       h_cand2d->Fill(pmiss.Theta()*180./M_PI,pmiss.Mag());
     }
 
@@ -453,7 +492,10 @@ int numevent = 0;
     double W = pow(W2,0.5);
 
 
-    h_pp_ppi_denom->Fill(pp1.Mag(),ppi.Mag());
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pp_ppi_denom->Fill(pp1.Mag(),ppi.Mag());
+    }
 
     // write event to hipo file
     c12writer.writeEvent();
@@ -477,9 +519,15 @@ int numevent = 0;
       TVector3 pp2;
       pp2.SetXYZ(pp2_x,pp2_y,pp2_z);
       
-      h_pt_phi->Fill(pp2.Phi()*180./M_PI, sqrt( pow(prot[i]->par()->getPx(),2) + pow(prot[i]->par()->getPy(),2) ));
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_pt_phi->Fill(pp2.Phi()*180./M_PI, sqrt( pow(prot[i]->par()->getPx(),2) + pow(prot[i]->par()->getPy(),2) ));
+      }
       double beta_exp = pp2.Mag()/sqrt(pow(pp2.Mag(),2) + pow(mP,2) );
-      h_dtof_p->Fill(pp2.Mag(), prot[i]->getPath()/c * (1/(prot[i]->par()->getBeta()) - 1/beta_exp));
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_dtof_p->Fill(pp2.Mag(), prot[i]->getPath()/c * (1/(prot[i]->par()->getBeta()) - 1/beta_exp));
+      }
        
       // put REC::Scintillator information
       double time; double energy;
@@ -492,39 +540,52 @@ int numevent = 0;
      
 
       // ESSENTIAL PROTON CUTS
-      h_tof->Fill(time);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_tof->Fill(time);
+      }
       if (pp2_x==0 || pp2_y==0 || pp2_z==0) {continue;}
 
       // proton angular distribution
       double p_theta = pp2.Theta()*180./M_PI;
-      h_pangles2->Fill(pp2.Phi()*180./M_PI,p_theta);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_pangles2->Fill(pp2.Phi()*180./M_PI,p_theta);
+      }
       // keep only Central Detector protons
       if (p_theta<45 || p_theta>120) {continue;}
 
       // proton momentum
-      h_p_theta->Fill(p_theta,pp2.Mag());
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_p_theta->Fill(p_theta,pp2.Mag());
+      }
       if (pp2.Mag()<p_min || pp2.Mag()>p_max) {continue;}
 
       //if (energy<3) {continue;}
 
       // histos
-      h_Edep_beta->Fill(prot[i]->getBeta(),energy);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_Edep_beta->Fill(prot[i]->getBeta(),energy);
     
 
-      // FILL HISTOS FOR PROTON CANDIDATES
-      h_cos0->Fill(cos0);
-      h_pxminuspx->Fill(pp2_x-pmiss.X());
-      h_pyminuspy->Fill(pp2_y-pmiss.Y());
-      h_pzminuspz->Fill(pp2_z-pmiss.Z());
-      h_pminusp->Fill(pp2.Mag()-pmiss.Mag());
-      h_pvsp->Fill(pmiss.Mag(),pp2.Mag());
-      h_dpp_p->Fill(pmiss.Mag(),(pmiss.Mag()-pp2.Mag())/pmiss.Mag());
+	// FILL HISTOS FOR PROTON CANDIDATES
+	h_cos0->Fill(cos0);
+	h_pxminuspx->Fill(pp2_x-pmiss.X());
+	h_pyminuspy->Fill(pp2_y-pmiss.Y());
+	h_pzminuspz->Fill(pp2_z-pmiss.Z());
+	h_pminusp->Fill(pp2.Mag()-pmiss.Mag());
+	h_pvsp->Fill(pmiss.Mag(),pp2.Mag());
+	h_dpp_p->Fill(pmiss.Mag(),(pmiss.Mag()-pp2.Mag())/pmiss.Mag());
 
 
-      h_selection->Fill((pmiss.Mag()-pp2.Mag())/pmiss.Mag(),pp2.Angle(pmiss)*180./M_PI);
+	h_selection->Fill((pmiss.Mag()-pp2.Mag())/pmiss.Mag(),pp2.Angle(pmiss)*180./M_PI);
+      }
 
 
       if (mmiss>0.85 && mmiss<1.05) {
+	auto fill_timer = stats.time(jobStage::Fill);
         h_cos0_mcut->Fill(cos0);
         h_pvsp_mcut->Fill(pmiss.Mag(),pp2.Mag());
         h_dpp_p_mcut->Fill(pmiss.Mag(),(pmiss.Mag()-pp2.Mag())/pmiss.Mag());
@@ -532,25 +593,30 @@ int numevent = 0;
 
 
 
-      h_mmiss_det->Fill(mmiss);
-      h_mmiss_pp->Fill(pmiss.Mag(),mmiss);
-      h_mmiss_pt->Fill(pmiss.Theta()*180./M_PI,mmiss);
-      h_pp_ppi_numer->Fill(pp1.Mag(),ppi.Mag());
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_mmiss_det->Fill(mmiss);
+	h_mmiss_pp->Fill(pmiss.Mag(),mmiss);
+	h_mmiss_pt->Fill(pmiss.Theta()*180./M_PI,mmiss);
+	h_pp_ppi_numer->Fill(pp1.Mag(),ppi.Mag());
 
 
-      // fill numerator histos
-      h_eff_p_numer->Fill(pmiss.Mag());
+	// fill numerator histos
+	h_eff_p_numer->Fill(pmiss.Mag());
+      }
       // fill numerator by angle
       for (int k=0; k<9; k++)
       {
         if (pmiss_theta>(ang_range[k]) && pmiss_theta<(ang_range[k+1]))
         {
+	  auto fill_timer = stats.time(jobStage::Fill);
           mmiss_pmiss_DET9[k]->Fill(pmiss.Mag(),mmiss);
         }
       }
 
 
       if (mmiss>0.85 && mmiss<1.05) {
+	auto fill_timer = stats.time(jobStage::Fill);
         h_det2d->Fill(pmiss.Theta()*180./M_PI,pmiss.Mag());
       }
 
@@ -561,6 +627,8 @@ int numevent = 0;
 
   }  // closes event loop
 
+  auto write_timer = stats.time(jobStage::Write);
+
 
   c12writer.closeWriter();
 
@@ -1132,6 +1200,7 @@ h_eff_p_numer_test->Add(peff_numer_ang[i]);
 
   //f->Close();
 
+  stats.summary();
   return 0;
 
 }  // closes main function
@@ -17,6 +17,7 @@
 #include <TDatabasePDG.h>
 #include "HipoChain.h"
 #include "HipoChainWriter.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 
 using namespace std;
@@ -55,7 +56,9 @@ int main(int argc, char ** argv)
   clas12ana clasAna;
 
   clas12root::HipoChainWriter chain(outFile);
+  clas12jobstats stats("skim_events");
   chain.Add(inFile);
+  stats.addInputFile(inFile);
 
   chain.SetReaderTags({0});
   chain.db()->turnOffQADB();
@@ -93,8 +96,9 @@ int main(int argc, char ** argv)
   TH1D *epp_h = new TH1D("epp_h","(e,e'pp)",100,0,2);
   TH1D *ep_h  = new TH1D("ep_h","(e,e'p)",100,0,2);
 
-  while(chain.Next())
+  while(stats.next(chain))
     {
+      auto selection_timer = stats.time(jobStage::Selection);
       //Display completed  
       counter++;
 
@@ -112,12 +116,17 @@ int main(int argc, char ** argv)
 	  auto recoil  = clasAna.getRecoilSRC();
 
 	  if(lead.size() == 1)
-	    chain.WriteEvent();
+	    {
+	      auto write_timer = stats.time(jobStage::Write);
+	      chain.WriteEvent();
+	    }
 
 	}
 
     }
 
+  stats.summary();
+
 
   return 0;
 }
@@ -26,6 +26,7 @@
 #include <TDatabasePDG.h>
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "clas12ana.h"
 #include "eventcut/functions.h"
 #include "neutron-veto/veto_functions.h"
@@ -98,9 +99,11 @@ int main(int argc, char ** argv)
   clasAna.printParams();
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("tensor_to_scalar");
   for(int k = 8; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -434,22 +437,17 @@ int main(int argc, char ** argv)
 
 
   //Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
+    auto analysis_timer = stats.time(jobStage::Analysis);
     //Display completed  
     counter++;
-    if((counter%1000000) == 0){
-      cerr << "\n" <<counter/1000000 <<" million completed";
-    }    
 
-    if((counter%100000) == 0){
-      cerr << ".";
-    }    
 
     
-    clasAna.Run(c12);
-    auto elec = clasAna.getByPid(11);
-    auto prot = clasAna.getByPid(2212);
-    auto neut = clasAna.getByPid(2112);
+    stats.timed(jobStage::Selection,[&]{clasAna.Run(c12);});
+    auto &elec = clasAna.getByPidView(11);
+    auto &prot = clasAna.getByPidView(2212);
+    auto &neut = clasAna.getByPidView(2112);
 
 
     auto allParticles=c12->getDetParticles();
@@ -476,8 +474,11 @@ int main(int argc, char ** argv)
     double vtz_e = elec[0]->par()->getVz();
    
     // electron histograms: quality cuts
-    h_nphe->Fill(nphe,weight);
-    h_vtz_e->Fill(vtz_e,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_nphe->Fill(nphe,weight);
+      h_vtz_e->Fill(vtz_e,weight);
+    }
 
 
 
@@ -507,61 +508,85 @@ int main(int argc, char ** argv)
 
 
     // lead histos
-    h_vtzdiff_ep->Fill(vze-vzlead,weight);
-    h_chi2pid->Fill(chi2pid,weight);
-    h_dbetap->Fill(pL.Mag(),dbetap,weight);
-    h_betap->Fill(pL.Mag(),lead[0]->par()->getBeta(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_vtzdiff_ep->Fill(vze-vzlead,weight);
+      h_chi2pid->Fill(chi2pid,weight);
+      h_dbetap->Fill(pL.Mag(),dbetap,weight);
+      h_betap->Fill(pL.Mag(),lead[0]->par()->getBeta(),weight);
 
 
-    // look at TOF distributions
+      // look at TOF distributions
 
 
 
-    //// PMISS & LEAD SRC CUTS ////
+      //// PMISS & LEAD SRC CUTS ////
    
-    // theta cut, pL cut
-    h_pangles->Fill(lphi,ltheta,weight);
-    h_p_theta->Fill(ltheta,pL.Mag(),weight);
+      // theta cut, pL cut
+      h_pangles->Fill(lphi,ltheta,weight);
+      h_p_theta->Fill(ltheta,pL.Mag(),weight);
+    }
     if (ltheta<40 || ltheta>140) {continue;}
     //if (ltheta>40) {continue;}
     if (pL.Mag()<1.0) {continue;}
 
     // xB cut
-    h_q2_xb->Fill(xB,Q2,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_q2_xb->Fill(xB,Q2,weight);
+    }
     if (xB<1.2) {continue;}
     
 
     // pmiss cut
     TVector3 pmiss = pL - q;
     double pm_theta = pmiss.Theta()*180./M_PI;
-    h_pmisstheta->Fill(pm_theta,weight);
-    h_pmiss_pL->Fill(pmiss.Mag(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pmisstheta->Fill(pm_theta,weight);
+      h_pmiss_pL->Fill(pmiss.Mag(),weight);
+    }
     if (pmiss.Mag()<0.3) {continue;}
     if (pmiss.Mag()>1.0) {continue;}
 
     // Q2 cut
-    h_q2->Fill(Q2,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_q2->Fill(Q2,weight);
+    }
     if (Q2<1.5) {continue;}
 
     // p/q cut
-    h_pq->Fill(pL.Mag()/q.Mag(),theta_pq,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pq->Fill(pL.Mag()/q.Mag(),theta_pq,weight);
+    }
     if (pL.Mag()/q.Mag()>0.96) {continue;}
 
     // mmiss cut
-    h_mmiss->Fill(mmiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss->Fill(mmiss,weight);
+    }
     if (mmiss>1.1) {continue;}
 
 
-    h_pmiss_p->Fill(pmiss.Mag(),weight);
-    h_pl_count->Fill(pmiss.Mag(),weight);
-    h_psrc_count->Fill(pmiss.Mag(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pmiss_p->Fill(pmiss.Mag(),weight);
+      h_pl_count->Fill(pmiss.Mag(),weight);
+      h_psrc_count->Fill(pmiss.Mag(),weight);
+    }
 
 
 
 //// RECOIL P ////
     // look for recoil proton in CTOF
 
-    h_psize->Fill(prot.size(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_psize->Fill(prot.size(),weight);
+    }
     //if (recoil.size()>1) {continue;} // really, if there's one recoil, I should decide which is the best
 
     TVector3 p_recp;
@@ -575,7 +600,10 @@ int main(int argc, char ** argv)
       if (!is_CTOF) {continue;}
 
       // p and theta cut
-      h_prec_ptheta->Fill(p_recp.Mag(),p_recp.Theta()*180./M_PI,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_prec_ptheta->Fill(p_recp.Mag(),p_recp.Theta()*180./M_PI,weight);
+      }
       if (p_recp.Theta()*180./M_PI<45 || p_recp.Theta()*180./M_PI>120) {continue;}
       // limit to central detector acceptance
       if (p_recp.Mag()<0.3) {continue;}
@@ -594,20 +622,27 @@ int main(int argc, char ** argv)
 
 
       // get momenta/angles of recoil protons
-      h_prec_plead->Fill(p_recp.Mag(),pL.Mag(),weight);
-      h_prec_p->Fill(p_recp.Mag(),weight);
-      h_prec_angles->Fill(p_recp.Phi()*180./M_PI,p_recp.Theta()*180./M_PI,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_prec_plead->Fill(p_recp.Mag(),pL.Mag(),weight);
+	h_prec_p->Fill(p_recp.Mag(),weight);
+	h_prec_angles->Fill(p_recp.Phi()*180./M_PI,p_recp.Theta()*180./M_PI,weight);
+      }
       double p_phi = p_recp.Phi()*180./M_PI;
       if (p_phi>-120 && p_phi<-100) {continue;}
       if (p_phi>0 && p_phi<20) {continue;}
       if (p_phi>120 && p_phi<140) {continue;}
 
 
-      h_prec_plead_angle->Fill(p_recp.Angle(pL)*180./M_PI,weight);
-      h_lpangle_pmiss->Fill(pmiss.Mag(),p_recp.Angle(pL)*180./M_PI,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_prec_plead_angle->Fill(p_recp.Angle(pL)*180./M_PI,weight);
+	h_lpangle_pmiss->Fill(pmiss.Mag(),p_recp.Angle(pL)*180./M_PI,weight);
+      }
 
       // close in angle to pmiss
       p_cos0 = pmiss.Dot(p_recp) / (pmiss.Mag() * p_recp.Mag());
+      auto fill_timer = stats.time(jobStage::Fill);
       h_pcos0->Fill(p_cos0,weight);
 
       // fill observable histo
@@ -629,7 +664,10 @@ int main(int argc, char ** argv)
     // look for recoil neutron in CTOF
 
     int rec_n = -1;
-    h_nsize->Fill(neut.size(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_nsize->Fill(neut.size(),weight);
+    }
     TVector3 p_recn;
     double n_cos0; int num_neutrons_passing_cuts = 0;
 
@@ -673,7 +711,7 @@ int main(int argc, char ** argv)
       n_cos0 = pmiss.Dot(p_recn) / (pmiss.Mag() * p_recn.Mag());
 
       // calculate features for ML
-      Struct ninfo = getFeatures(neut, allParticles, i);
+      Struct ninfo = getFeatures(neut, allParticles, i, clasAna.getTrajCache());
       cnd_hits = ninfo.cnd_hits;
       cnd_energy = ninfo.cnd_energy;
       ctof_hits = ninfo.ctof_hits;
@@ -687,8 +725,11 @@ int main(int argc, char ** argv)
 
       // apply ML model
       double mvaValue = reader->EvaluateMVA("MLP");
-      h_mvaValue_MLP->Fill(mvaValue,weight);
-      h_mvaValue_BDT->Fill(mvaValue,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_mvaValue_MLP->Fill(mvaValue,weight);
+	h_mvaValue_BDT->Fill(mvaValue,weight);
+      }
 
 
 
@@ -700,20 +741,27 @@ int main(int argc, char ** argv)
      
  
       // KINEMATICS OF ALL NEUTRONS
-      h_tof_all->Fill(tof,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_tof_all->Fill(tof,weight);
+      }
 
       if (pn_mag==0) {continue;}
       if (tof<=0) {continue;}
 
-      h_theta_pn_all->Fill(pn_mag,pn_theta,weight);
-      h_cos0_all->Fill(n_cos0,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_theta_pn_all->Fill(pn_mag,pn_theta,weight);
+	h_cos0_all->Fill(n_cos0,weight);
 
-      tree->Fill();
+	tree->Fill();
+      }
 
 
       // DOUBLE HITS
       if (status>0)
       {
+	auto fill_timer = stats.time(jobStage::Fill);
         h_theta_pn_doublehits->Fill(pn_mag,pn_theta,weight);
         h_tof_doublehits->Fill(tof,weight);
         h_cos0_doublehits->Fill(n_cos0,weight);
@@ -723,8 +771,11 @@ int main(int argc, char ** argv)
 
 
       // ENERGY DEPOSITION CUT
-      h_tof_etest->Fill(tof,weight);
-      h_cos0_edep->Fill(energy,n_cos0,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_tof_etest->Fill(tof,weight);
+	h_cos0_edep->Fill(energy,n_cos0,weight);
+      }
       edep = energy;
 
       if (tof>2 && tof<8)
@@ -756,7 +807,10 @@ int main(int argc, char ** argv)
 
       // edep cut
       if (edep<5) {continue;}
-      h_tof_after_edep->Fill(tof);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_tof_after_edep->Fill(tof);
+      }
 
 
 
@@ -764,14 +818,18 @@ int main(int argc, char ** argv)
 
       if (tof>0 && tof<15)
       {
+	auto fill_timer = stats.time(jobStage::Fill);
         h_theta_pn_offtime1->Fill(pn_mag,pn_theta,weight);
         h_theta_pn_offtime2->Fill(pn_mag,pn_theta,weight);
       }
       else if (tof>26 && tof<41) // previously 26-41
       {
-        h_pmiss_offtime->Fill(pmiss.Mag(),weight);
-        h_cos0_offtime->Fill(n_cos0,weight);
-        h_angles_offtime->Fill(p_recn.Phi()*180./M_PI,p_recn.Theta()*180./M_PI,n_weight*weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_pmiss_offtime->Fill(pmiss.Mag(),weight);
+	  h_cos0_offtime->Fill(n_cos0,weight);
+	  h_angles_offtime->Fill(p_recn.Phi()*180./M_PI,p_recn.Theta()*180./M_PI,n_weight*weight);
+	}
         // assign negative weight and kinematics in signal region
         n_weight = -1*weight;
         tof = tof - 26;
@@ -779,13 +837,17 @@ int main(int argc, char ** argv)
         p_recn.SetMag( 1/sqrt(1-beta*beta)*0.939565346*path/tof/29.98);
         pn_mag = p_recn.Mag();
         n_cos0 = pmiss.Dot(p_recn) / (pmiss.Mag() * p_recn.Mag());
+	auto fill_timer = stats.time(jobStage::Fill);
         h_theta_pn_offtime2->Fill(pn_mag,pn_theta,n_weight*weight);
       }
       if (beta>0.8) {continue;} // in case we made tof too low
       if (tof>15) {continue;}
 
       // limit to central detector acceptance
-      h_nrec_ptheta->Fill(p_recn.Mag(),p_recn.Theta()*180./M_PI,n_weight*weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_nrec_ptheta->Fill(p_recn.Mag(),p_recn.Theta()*180./M_PI,n_weight*weight);
+      }
       if (p_recn.Mag()<0.3 || p_recn.Mag()>1.0) {continue;}
       if (p_recn.Theta()*180./M_PI<45 || p_recn.Theta()*180./M_PI>120) {continue;}
 
@@ -798,7 +860,10 @@ int main(int argc, char ** argv)
       // fiducial cuts - only works for tof>0 neutrons
       //if (n_weight>0)
       //{
-        h_nrec_angles->Fill(p_recn.Phi()*180./M_PI,p_recn.Theta()*180./M_PI,n_weight*weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_nrec_angles->Fill(p_recn.Phi()*180./M_PI,p_recn.Theta()*180./M_PI,n_weight*weight);
+	}
         if (n_phi>-120 && n_phi<-100) {continue;}
         if (n_phi>0 && n_phi<20) {continue;}
         if (n_phi>120 && n_phi<140) {continue;}
@@ -806,7 +871,10 @@ int main(int argc, char ** argv)
 
 
       // fill counts
-      h_pn_count->Fill(pmiss.Mag(),n_weight*weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_pn_count->Fill(pmiss.Mag(),n_weight*weight);
+      }
 
 
 
@@ -815,35 +883,43 @@ int main(int argc, char ** argv)
       if (mvaValue>mva_cutoff) // signal
       {
         // ML features
-        h_energy_s->Fill(energy,n_weight*weight);
-        h_layermult_s->Fill(layermult,n_weight*weight);
-        h_size_s->Fill(size,n_weight*weight);
-        h_cnd_hits_s->Fill(cnd_hits,n_weight*weight);
-        h_cnd_energy_s->Fill(cnd_energy,n_weight*weight);
-        h_ctof_energy_s->Fill(ctof_energy,n_weight*weight);
-        h_ctof_hits_s->Fill(ctof_hits,n_weight*weight);
-        h_anglediff_s->Fill(angle_diff,n_weight*weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_energy_s->Fill(energy,n_weight*weight);
+	  h_layermult_s->Fill(layermult,n_weight*weight);
+	  h_size_s->Fill(size,n_weight*weight);
+	  h_cnd_hits_s->Fill(cnd_hits,n_weight*weight);
+	  h_cnd_energy_s->Fill(cnd_energy,n_weight*weight);
+	  h_ctof_energy_s->Fill(ctof_energy,n_weight*weight);
+	  h_ctof_hits_s->Fill(ctof_hits,n_weight*weight);
+	  h_anglediff_s->Fill(angle_diff,n_weight*weight);
+	}
 
         rec_n = i; // pick this neutron! ... but what if there's more than 1?
 
         n_signal = n_signal + 1;
+	auto fill_timer = stats.time(jobStage::Fill);
         h_n_signal->Fill(pmiss.Mag(),n_weight*weight); // no n_weight?
 
       }
       else
       {
         // ML features
-        h_energy_b->Fill(energy,n_weight*weight);
-        h_layermult_b->Fill(layermult,n_weight*weight);
-        h_size_b->Fill(size,n_weight*weight);
-        h_cnd_hits_b->Fill(cnd_hits,n_weight*weight);
-        h_cnd_energy_b->Fill(cnd_energy,n_weight*weight);
-        h_ctof_energy_b->Fill(ctof_energy,n_weight*weight);
-        h_ctof_hits_b->Fill(ctof_hits,n_weight*weight);
-        h_anglediff_b->Fill(angle_diff,n_weight*weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_energy_b->Fill(energy,n_weight*weight);
+	  h_layermult_b->Fill(layermult,n_weight*weight);
+	  h_size_b->Fill(size,n_weight*weight);
+	  h_cnd_hits_b->Fill(cnd_hits,n_weight*weight);
+	  h_cnd_energy_b->Fill(cnd_energy,n_weight*weight);
+	  h_ctof_energy_b->Fill(ctof_energy,n_weight*weight);
+	  h_ctof_hits_b->Fill(ctof_hits,n_weight*weight);
+	  h_anglediff_b->Fill(angle_diff,n_weight*weight);
+	}
 //std::cout << rec_n << '\n'; // there's an issue here! sometimes this returns 0
 
         n_background = n_background + 1;
+	auto fill_timer = stats.time(jobStage::Fill);
         h_n_background->Fill(pmiss.Mag(),n_weight*weight); // no n_weight?
       }
 
@@ -916,6 +992,7 @@ int main(int argc, char ** argv)
 
 
 
+      auto fill_timer = stats.time(jobStage::Fill);
       h_pmiss_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
       h_pmiss_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
 
@@ -961,7 +1038,10 @@ int main(int argc, char ** argv)
     } // end loop over neutrons
 
     
-    h_nsize2->Fill(num_neutrons_passing_cuts,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_nsize2->Fill(num_neutrons_passing_cuts,weight);
+    }
 
 
 
@@ -1053,45 +1133,50 @@ int main(int argc, char ** argv)
       double neff = p0 + p1*pn.Mag();
       if (neff<=0) {continue;} // just in case
 
-      h_pmiss_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
-      h_pmiss_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_pmiss_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
+	h_pmiss_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
 
-      // add to "with recoil" p denominator if neutron meets recoil conditions
-      h_pmiss_p_wrec->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
+	// add to "with recoil" p denominator if neutron meets recoil conditions
+	h_pmiss_p_wrec->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
 
 
 
-      // histos that used to be in mvaValue>mva_cutoff section
-      h_good_nrec_angles->Fill(pn.Phi()*180./M_PI,pn.Theta()*180./M_PI,n_weight*weight);   
-      // see if neutron is close in angle to pmiss
-      h_ncos0->Fill(n_cos0,n_weight*weight);
-      // compared to pmiss
-      h_pn_pmiss->Fill(pmiss.Mag(),pn.Mag(),n_weight*weight);
+	// histos that used to be in mvaValue>mva_cutoff section
+	h_good_nrec_angles->Fill(pn.Phi()*180./M_PI,pn.Theta()*180./M_PI,n_weight*weight);   
+	// see if neutron is close in angle to pmiss
+	h_ncos0->Fill(n_cos0,n_weight*weight);
+	// compared to pmiss
+	h_pn_pmiss->Fill(pmiss.Mag(),pn.Mag(),n_weight*weight);
 
-      // get momenta/angles of recoil neutrons (this was originally for candidates)
-      h_nrec_plead->Fill(pn.Mag(),pL.Mag(),n_weight*weight);
-      h_nrec_p->Fill(pn.Mag(),n_weight*weight);
-      h_nptheta->Fill(pn.Theta()*180./M_PI,pmiss.Mag(),n_weight*weight);
-      h_nrec_plead_angle->Fill(pn.Angle(pL)*180./M_PI,n_weight*weight);
-      h_lnangle_pmiss->Fill(pmiss.Mag(),pn.Angle(pL)*180./M_PI,n_weight*weight);
+	// get momenta/angles of recoil neutrons (this was originally for candidates)
+	h_nrec_plead->Fill(pn.Mag(),pL.Mag(),n_weight*weight);
+	h_nrec_p->Fill(pn.Mag(),n_weight*weight);
+	h_nptheta->Fill(pn.Theta()*180./M_PI,pmiss.Mag(),n_weight*weight);
+	h_nrec_plead_angle->Fill(pn.Angle(pL)*180./M_PI,n_weight*weight);
+	h_lnangle_pmiss->Fill(pmiss.Mag(),pn.Angle(pL)*180./M_PI,n_weight*weight);
 
 
 
 
 
 
-      // off-time subtraction built in
-      h_pmiss_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
-      h_pmiss_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
-      h_pneutron_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
-      h_pneutron_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
-      // add to "with recoil" p denominator if neutron meets recoil conditions
-      h_pmiss_p_wrec->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
+	// off-time subtraction built in
+	h_pmiss_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
+	h_pmiss_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
+	h_pneutron_pn_uncorr->Fill(pmiss.Mag(),n_weight*weight);
+	h_pneutron_pn_corr->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
+	// add to "with recoil" p denominator if neutron meets recoil conditions
+	h_pmiss_p_wrec->Fill(pmiss.Mag(),n_weight*veto_weight*weight/neff);
+      }
 
 */
 
   }
 
+  auto write_timer = stats.time(jobStage::Write);
+
 
 
   cout<<counter<<endl;
@@ -1743,6 +1828,7 @@ int main(int argc, char ** argv)
 
   //outFile->Close(); // THIS LINE CAUSES ERRORS!
 
+  stats.summary();
 }
 
 
@@ -0,0 +1,24 @@
+#include <iostream>
+#include "clas12ana.h"
+
+using namespace std;
+
+//Parses every parameter file of Ana/cutFiles and writes the binary snapshot read by clas12ana::Init
+//usage: make_par_snapshot [output file, default cutFiles.snapshot of the build tree]
+int main(int argc, char ** argv)
+{
+  std::string out = (argc > 1) ? argv[1] : clas12ana::parSnapshotFile();
+
+  clas12ana clasAna;
+  //always from the text files, an existing snapshot may be out of date
+  clasAna.readParFiles();
+
+  if(!clasAna.writeParSnapshot(out.c_str()))
+    {
+      std::cerr << "WARNING:: Could not write parameter snapshot " << out << std::endl;
+      return 1;
+    }
+
+  cout << "Parameter snapshot written to " << out << endl;
+  return 0;
+}
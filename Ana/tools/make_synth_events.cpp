@@ -0,0 +1,29 @@
+#include <iostream>
+#include <cstdlib>
+#include "clas12synth.h"
+
+using namespace std;
+
+//Writes synthetic events (see clas12synth.h) readable by every program taking HIPO files
+//usage: make_synth_events outputfile nevents [run number, default 11 (MC)] [seed]
+int main(int argc, char ** argv)
+{
+  if(argc < 3)
+    {
+      std::cerr << "Usage: ./make_synth_events outputfile nevents [run] [seed]\n\n";
+      return -1;
+    }
+
+  synthConfig config;
+  if(argc > 3)
+    config.run = atoi(argv[3]);
+  if(argc > 4)
+    config.seed = atoi(argv[4]);
+
+  clas12synth synth(config);
+  if(!synth.write(argv[1],atol(argv[2])))
+    return 1;
+
+  cout << "Synthetic events written to " << argv[1] << endl;
+  return 0;
+}
@@ -18,6 +18,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut/eventcut.h"
 
 using namespace std;
@@ -423,9 +424,11 @@ int main(int argc, char ** argv)
   clas12databases::SetRCDBRootConnection("../rcdb.root");
 
   clas12root::HipoChain chain;
+  clas12jobstats stats("monitorPID");
   //  for(int k = 4; k < argc; k++){
     cout<<"Input file "<<argv[3]<<endl;
     chain.Add(argv[3]);
+    stats.addInputFile(argv[3]);
     //  }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -437,7 +440,7 @@ int main(int argc, char ** argv)
   if( input_energy)
     Ebeam = beam_energyIN;
 
-  while(chain.Next()==true)
+  while(stats.next(chain))
     {
       if(!input_energy && counter == 0)
 	Ebeam = rcdbData.beam_energy/1000;
@@ -446,8 +449,7 @@ int main(int argc, char ** argv)
 
       //Display completed  
       counter++;
-      if((counter%100000) == 0)
-	cerr << counter <<" completed \n";
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       // get particles by type
       auto electrons=c12->getByID(11);
@@ -466,19 +468,28 @@ int main(int argc, char ** argv)
 
       double EoP_e =  (electrons[0]->cal(PCAL)->getEnergy() +  electrons[0]->cal(ECIN)->getEnergy() +  electrons[0]->cal(ECOUT)->getEnergy()) / p_e.Mag();
       
-      h_Vcal_EoP->Fill(electrons[0]->cal(PCAL)->getLv(),EoP_e,weight);
-      h_Wcal_EoP->Fill(electrons[0]->cal(PCAL)->getLw(),EoP_e,weight);
-      h_phi_theta->Fill(p_e.Phi()*180/M_PI,p_e.Theta()*180/M_PI,weight);
-      h_sector->Fill(electrons[0]->getSector(),weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_Vcal_EoP->Fill(electrons[0]->cal(PCAL)->getLv(),EoP_e,weight);
+	h_Wcal_EoP->Fill(electrons[0]->cal(PCAL)->getLw(),EoP_e,weight);
+	h_phi_theta->Fill(p_e.Phi()*180/M_PI,p_e.Theta()*180/M_PI,weight);
+	h_sector->Fill(electrons[0]->getSector(),weight);
+      }
 
 	  
   /////////////////////////////////////
   //Electron Pid
   /////////////////////////////////////
-      h_P_EoP->Fill(p_e.Mag(),EoP_e,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_P_EoP->Fill(p_e.Mag(),EoP_e,weight);
+      }
       int nphe = electrons[0]->che(HTCC)->getNphe();
       if(nphe < 2){ continue; }
-      h_nphe->Fill(nphe,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_nphe->Fill(nphe,weight);
+      }
       if(electrons[0]->cal(ECIN)->getLv() < 14){ continue; }
       if(electrons[0]->cal(ECIN)->getLw() < 14){ continue; }
       if(EoP_e < 0.18){ continue; }
@@ -499,12 +510,15 @@ int main(int argc, char ** argv)
       double WSq = (mN*mN) - QSq + (2*nu*mN);
       //if(WSq>1.25){continue;}
       
-      h_xB->Fill(xB,weight);
-      h_QSq->Fill(QSq,weight);
-      h_WSq->Fill(WSq,weight);
-      h_xB_QSq->Fill(xB,QSq,weight);
-      h_xB_WSq->Fill(xB,WSq,weight);
-      h_QSq_WSq->Fill(QSq,WSq,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_xB->Fill(xB,weight);
+	h_QSq->Fill(QSq,weight);
+	h_WSq->Fill(WSq,weight);
+	h_xB_QSq->Fill(xB,QSq,weight);
+	h_xB_WSq->Fill(xB,WSq,weight);
+	h_QSq_WSq->Fill(QSq,WSq,weight);
+      }
 
       /*
       if((electrons.size()>0) && (num_L==1)){
@@ -513,7 +527,10 @@ int main(int argc, char ** argv)
 	TVector3 p_p_t;
 	p_p_t.SetMagThetaPhi(protons[index_L]->getP(),protons[index_L]->getTheta(),protons[index_L]->getPhi());
 	double mmiss_t = get_mmiss(p_b,p_e_t,p_p_t);
-	h_mmiss_t->Fill(mmiss_t,weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_mmiss_t->Fill(mmiss_t,weight);
+	}
 	}*/
   /////////////////////////////////////
   //All Proton Angles
@@ -530,28 +547,42 @@ int main(int argc, char ** argv)
 	double Chi2Pid_L = protons[j]->par()->getChi2Pid();
 	double vtz_diff = electrons[0]->par()->getVz()-vtz_L;
 	if(isMC){vtz_diff=0.5;}
-	h_theta_L->Fill(theta_L,weight);
-	h_theta_Lq->Fill(theta_Lq,weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_theta_L->Fill(theta_L,weight);
+	  h_theta_Lq->Fill(theta_Lq,weight);
+	}
 
 	double mmiss_t = get_mmiss(p_b,p_e,p_L);
-	h_mmiss_all->Fill(mmiss_t,weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_mmiss_all->Fill(mmiss_t,weight);
+	}
 	if((protons[j]->sci(FTOF1A)->getDetector()==12) && (protons[j]->sci(FTOF1B)->getDetector()==12)){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_mmiss_FTOF1->Fill(mmiss_t,weight);
 	}
 	else if(protons[j]->sci(FTOF2)->getDetector()==12){
-	  h_mmiss_FTOF2->Fill(mmiss_t,weight);
-	  h_mmiss_FTOF2_mag->Fill(mmiss_t,p_L.Mag(),weight);
-	  h_mmiss_FTOF2_theta->Fill(mmiss_t,theta_L,weight);
-	  h_mmiss_FTOF2_phi->Fill(mmiss_t,phi_L,weight);
-	  h_mmiss_FTOF2_chi->Fill(mmiss_t,Chi2Pid_L,weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_mmiss_FTOF2->Fill(mmiss_t,weight);
+	    h_mmiss_FTOF2_mag->Fill(mmiss_t,p_L.Mag(),weight);
+	    h_mmiss_FTOF2_theta->Fill(mmiss_t,theta_L,weight);
+	    h_mmiss_FTOF2_phi->Fill(mmiss_t,phi_L,weight);
+	    h_mmiss_FTOF2_chi->Fill(mmiss_t,Chi2Pid_L,weight);
+	  }
 
 	  /*
-	  h_mmiss_FTOF2_PCAL->Fill(mmiss_t,protons[j]->cal(PCAL)->getEnergy(),weight);
-	  h_mmiss_FTOF2_ECIN->Fill(mmiss_t,protons[j]->cal(ECIN)->getEnergy(),weight);
-	  h_mmiss_FTOF2_ECOUT->Fill(mmiss_t,protons[j]->cal(ECOUT)->getEnergy(),weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_mmiss_FTOF2_PCAL->Fill(mmiss_t,protons[j]->cal(PCAL)->getEnergy(),weight);
+	    h_mmiss_FTOF2_ECIN->Fill(mmiss_t,protons[j]->cal(ECIN)->getEnergy(),weight);
+	    h_mmiss_FTOF2_ECOUT->Fill(mmiss_t,protons[j]->cal(ECOUT)->getEnergy(),weight);
+	  }
 	  */
 	}
 	else{
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_mmiss_noFTOF->Fill(mmiss_t,weight);
 	  h_mmiss_noFTOF_theta->Fill(mmiss_t,theta_L,weight);
 	}
@@ -589,16 +620,29 @@ int main(int argc, char ** argv)
 	  double l_nL = neutrons[j]->sci(DET)->getPath();
 	  double eDep_nL = neutrons[j]->sci(DET)->getEnergy();
 	  double ToM = t_nL*100/l_nL;
-	  h_ToM_eDep_nL->Fill(ToM,eDep_nL,weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_ToM_eDep_nL->Fill(ToM,eDep_nL,weight);
+	  }
 	  if(eDep_nL>5){
-	    h_ToM_nL->Fill(ToM,weight);
-	    h_mom_ToM_nL->Fill(p_nL.Mag(),ToM,weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_ToM_nL->Fill(ToM,weight);
+	      h_mom_ToM_nL->Fill(p_nL.Mag(),ToM,weight);
+	    }
 	    if(ToM>3.5){
-	      h_mom_nL->Fill(p_nL.Mag(),weight);
-	      h_theta_nL->Fill(theta_nL,weight);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_mom_nL->Fill(p_nL.Mag(),weight);
+		h_theta_nL->Fill(theta_nL,weight);
+	      }
 	      if(theta_nL<35){
-		h_theta_nLq->Fill(theta_nLq,weight);
+		{
+		  auto fill_timer = stats.time(jobStage::Fill);
+		  h_theta_nLq->Fill(theta_nLq,weight);
+		}
 		if(theta_nLq<25){
+		  auto fill_timer = stats.time(jobStage::Fill);
 		  h_phi_e_nL->Fill(phi_diff_n,weight);
 		}
 	      }
@@ -626,33 +670,42 @@ int main(int argc, char ** argv)
 	double theta_1q = p_1.Angle(p_q) * 180 / M_PI;
 	
 
-	h_theta_L_FTOF->Fill(theta_L,weight);
-	h_theta_Lq_FTOF->Fill(theta_Lq,weight);
-
-	h_phi_e_L->Fill(phi_diff,weight);
-	h_mmiss_FTOF->Fill(mmiss,weight);
-	h_mmiss_phi_e_L->Fill(mmiss,phi_diff,weight);
-	h_xB_mmiss->Fill(xB,mmiss,weight);
-	h_pmiss_mmiss->Fill(p_miss.Mag(),mmiss,weight);
-	h_xB_theta_1q->Fill(xB,theta_1q,weight);
-	h_Loq_theta_1q->Fill(Loq,theta_1q,weight);
-	h_pmiss_theta_miss->Fill(p_miss.Mag(),theta_miss,weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_theta_L_FTOF->Fill(theta_L,weight);
+	  h_theta_Lq_FTOF->Fill(theta_Lq,weight);
+
+	  h_phi_e_L->Fill(phi_diff,weight);
+	  h_mmiss_FTOF->Fill(mmiss,weight);
+	  h_mmiss_phi_e_L->Fill(mmiss,phi_diff,weight);
+	  h_xB_mmiss->Fill(xB,mmiss,weight);
+	  h_pmiss_mmiss->Fill(p_miss.Mag(),mmiss,weight);
+	  h_xB_theta_1q->Fill(xB,theta_1q,weight);
+	  h_Loq_theta_1q->Fill(Loq,theta_1q,weight);
+	  h_pmiss_theta_miss->Fill(p_miss.Mag(),theta_miss,weight);
+	}
   /////////////////////////////////////
   //Lead SRC Proton Checks
   /////////////////////////////////////
 	if(QSq>1.5){
 	  if(p_miss.Mag()>0.25){
 	    if((mmiss>0.84) && (mmiss<1.04)){
-	      h_pmiss->Fill(p_miss.Mag(),weight);
-	      h_mmiss->Fill(mmiss,weight);
-	      h_pmiss_theta_miss_SRC->Fill(p_miss.Mag(),theta_miss,weight);
-	      h_xB_Loq_SRC->Fill(xB,Loq,weight);
+	      {
+		auto fill_timer = stats.time(jobStage::Fill);
+		h_pmiss->Fill(p_miss.Mag(),weight);
+		h_mmiss->Fill(mmiss,weight);
+		h_pmiss_theta_miss_SRC->Fill(p_miss.Mag(),theta_miss,weight);
+		h_xB_Loq_SRC->Fill(xB,Loq,weight);
+	      }
 	      isSRC_loose=true;	      
 	      if((Loq > 0.62) && (Loq < 0.96)){
 		if(xB > 1.2){
-		  h_pmiss_tight->Fill(p_miss.Mag(),weight);
-		  h_mmiss_tight->Fill(mmiss,weight);
-		  h_pmiss_theta_miss_SRC_tight->Fill(p_miss.Mag(),theta_miss,weight);	       
+		  {
+		    auto fill_timer = stats.time(jobStage::Fill);
+		    h_pmiss_tight->Fill(p_miss.Mag(),weight);
+		    h_mmiss_tight->Fill(mmiss,weight);
+		    h_pmiss_theta_miss_SRC_tight->Fill(p_miss.Mag(),theta_miss,weight);	       
+		  }
 		  isSRC_tight=true;
 		}
 	      }
@@ -666,8 +719,12 @@ int main(int argc, char ** argv)
   //Recoil Nucleons
   /////////////////////////////////////
       if(isSRC_loose){
-	h_num_R->Fill(protons.size()-1,1);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_num_R->Fill(protons.size()-1,1);
+	}
 	if(isSRC_tight){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_num_R_tight->Fill(protons.size()-1,1);
 	}
       }		
@@ -681,13 +738,19 @@ int main(int argc, char ** argv)
 	TVector3 p_R;
 	p_R.SetMagThetaPhi(protons[j]->getP(),protons[j]->getTheta(),protons[j]->getPhi());
 	if(isSRC_loose){
-	  h_p_2->Fill(p_R.Mag(),weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_p_2->Fill(p_R.Mag(),weight);
+	  }
 	  if(p_R.Mag()>mom_2){
 	    index_2=j;
 	    mom_2=p_R.Mag();
 	  }
 	  if(isSRC_tight){
-	    h_p_2_tight->Fill(p_R.Mag(),weight);
+	    {
+	      auto fill_timer = stats.time(jobStage::Fill);
+	      h_p_2_tight->Fill(p_R.Mag(),weight);
+	    }
 	    if(p_R.Mag()>mom_2_tight){
 	      index_2_tight=j;
 	      mom_2_tight=p_R.Mag();
@@ -716,8 +779,12 @@ int main(int argc, char ** argv)
 	TVector3 vy = p_2.Cross(p_q).Unit();
 	TVector3 vx = vt.Cross(vy);
 
-	h_p_2_high->Fill(p_2.Mag(),weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_p_2_high->Fill(p_2.Mag(),weight);
+	}
 	if(p_2.Mag()>0.25){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_p_rel->Fill(p_rel.Mag(),weight);
 	  h_p_cm->Fill(p_cm.Mag(),weight);
 	  h_p_t_cm->Fill(p_cm.Dot(vt),weight);
@@ -744,8 +811,12 @@ int main(int argc, char ** argv)
 	TVector3 vy = p_2.Cross(p_q).Unit();
 	TVector3 vx = vt.Cross(vy);
 
-	h_p_2_high_tight->Fill(p_2.Mag(),weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_p_2_high_tight->Fill(p_2.Mag(),weight);
+	}
 	if(p_2.Mag()>0.25){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_p_rel_tight->Fill(p_rel.Mag(),weight);
 	  h_p_cm_tight->Fill(p_cm.Mag(),weight);
 	  h_p_t_cm_tight->Fill(p_cm.Dot(vt),weight);
@@ -758,6 +829,7 @@ int main(int argc, char ** argv)
   }
     cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -1030,6 +1102,7 @@ int main(int argc, char ** argv)
 
 
 
+  stats.summary();
 }
 
 
@@ -19,6 +19,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut/eventcut.h"
 #include "eventcut/functions.h"
 
@@ -57,9 +58,11 @@ int main(int argc, char ** argv)
   eventcut myCut(Ebeam,argv[5]);
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("monitor_en");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -341,15 +344,10 @@ int main(int argc, char ** argv)
   int counter = 0;
 
   //Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       // get particles by type
       auto allParticles = c12->getDetParticles();
@@ -369,19 +367,28 @@ int main(int argc, char ** argv)
   /////////////////////////////////////
   //Electron fiducials
   /////////////////////////////////////      
-      h_phi_theta->Fill(p_e.Phi()*180/M_PI,p_e.Theta()*180/M_PI,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_phi_theta->Fill(p_e.Phi()*180/M_PI,p_e.Theta()*180/M_PI,weight);
+      }
       if(EoP_e<=0){ continue; }
       int esector = electrons[0]->getSector();
-      h_sector->Fill(esector,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_sector->Fill(esector,weight);
+      }
 
 
   /////////////////////////////////////
   //Electron Pid
   /////////////////////////////////////
-      h_nphe->Fill(nphe,weight);
-      h_vtz_e->Fill(vtz_e,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_nphe->Fill(nphe,weight);
+	h_vtz_e->Fill(vtz_e,weight);
+      }
 
-      if(!myCut.electroncut(c12)){continue;}
+      if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})){continue;}
 
   /////////////////////////////////////
   //Electron Kinematics  
@@ -395,13 +402,16 @@ int main(int argc, char ** argv)
       double theta_e = p_e.Theta() * 180 / M_PI;
       //if(WSq>1.25){continue;}
 
-      h_xB->Fill(xB,weight);
-      h_QSq->Fill(QSq,weight);
-      h_WSq->Fill(WSq,weight);
-      h_xB_QSq->Fill(xB,QSq,weight);
-      h_xB_WSq->Fill(xB,WSq,weight);
-      h_QSq_WSq->Fill(QSq,WSq,weight);
-      h_mom_theta[esector-1]->Fill(p_e.Mag(),theta_e,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_xB->Fill(xB,weight);
+	h_QSq->Fill(QSq,weight);
+	h_WSq->Fill(WSq,weight);
+	h_xB_QSq->Fill(xB,QSq,weight);
+	h_xB_WSq->Fill(xB,WSq,weight);
+	h_QSq_WSq->Fill(QSq,WSq,weight);
+	h_mom_theta[esector-1]->Fill(p_e.Mag(),theta_e,weight);
+      }
 
   /////////////////////////////////////
   //Neutral Particle Information
@@ -420,9 +430,11 @@ int main(int argc, char ** argv)
 
           int PID = allParticles[j]->getPid();
           if(PID==2112){
+	    auto fill_timer = stats.time(jobStage::Fill);
             h_mom_beta_neutron_ECAL_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
           }  
           if(PID==22){
+	    auto fill_timer = stats.time(jobStage::Fill);
             h_mom_beta_photon_ECAL_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
           }
 	}
@@ -430,9 +442,11 @@ int main(int argc, char ** argv)
  	  
 	  int PID = allParticles[j]->getPid();
 	  if(PID==2112){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_neutron_CND_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);  
 	  }
 	  if(PID==22){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_photon_CND_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);  
 	  }
 	}
@@ -476,6 +490,7 @@ int main(int argc, char ** argv)
 
 	if(PCAL || ECin || ECout){
           nn_ECAL_good += 1;
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_phi_e_n_ECAL->Fill(phi_diff,weight);
 
 	  h_theta_n_ECAL->Fill(theta_n,weight);
@@ -491,16 +506,19 @@ int main(int argc, char ** argv)
           if (theta_n<40 || theta_n>140) {continue;}
 
           nn_CND_good += 1;
-	  h_phi_e_n_CND->Fill(phi_diff,weight);
-
-	  h_theta_n_CND->Fill(theta_n,weight);
-	  h_theta_nq_CND->Fill(theta_nq,weight);	
-	  h_phi_theta_n_CND->Fill(phi_n,theta_n,weight);
-	  h_mom_beta_n_CND->Fill(p_n.Mag(),beta_n,weight);
-	  h_timediff_n_CND->Fill(time_frommom_n-time_frombeta_n,weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_phi_e_n_CND->Fill(phi_diff,weight);
+
+	    h_theta_n_CND->Fill(theta_n,weight);
+	    h_theta_nq_CND->Fill(theta_nq,weight);	
+	    h_phi_theta_n_CND->Fill(phi_n,theta_n,weight);
+	    h_mom_beta_n_CND->Fill(p_n.Mag(),beta_n,weight);
+	    h_timediff_n_CND->Fill(time_frommom_n-time_frombeta_n,weight);
 	  
-	  h_mom_theta_n_CND->Fill(p_n.Mag(),theta_n,weight);
-          h_phi_mom_n_CND->Fill(phi_n,p_n.Mag(),weight);
+	    h_mom_theta_n_CND->Fill(p_n.Mag(),theta_n,weight);
+	    h_phi_mom_n_CND->Fill(phi_n,p_n.Mag(),weight);
+	  }
 
 
           
@@ -513,14 +531,18 @@ int main(int argc, char ** argv)
 
 
           // fill histos with extra bank info
+	  auto fill_timer = stats.time(jobStage::Fill);
           h_dedx_CND->Fill(p_n.Mag()/mN,dedx,weight);
           h_cluster_CND->Fill(csize,layermult,weight);
 	}
 
 
       }
-      h_nsize_ECAL->Fill(nn_ECAL,nn_ECAL_good,weight);
-      h_nsize_CND->Fill(nn_CND,nn_CND_good,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_nsize_ECAL->Fill(nn_ECAL,nn_ECAL_good,weight);
+	h_nsize_CND->Fill(nn_CND,nn_CND_good,weight);
+      }
 
 
       // CND::hits banks info
@@ -550,6 +572,7 @@ int main(int argc, char ** argv)
 
 
         // fill histograms
+	auto fill_timer = stats.time(jobStage::Fill);
         h_sec_lay->Fill(sector,layer,weight);
 
         h_hits_xy->Fill(x,y,weight);
@@ -571,6 +594,7 @@ int main(int argc, char ** argv)
       // CND::clusters banks info
       for (auto iRow=0; iRow < c12->getBank(cnd_clusters)->getRows(); iRow++){
         int nhits = c12->getBank(cnd_clusters)->getInt(cnd_clusters_nhits,iRow);
+	auto fill_timer = stats.time(jobStage::Fill);
         h_cl_nhits->Fill(nhits,weight);
       }
 
@@ -630,8 +654,12 @@ int main(int argc, char ** argv)
 
         // "good neutrons" start here
         if(CND){
-          h_pn_angles->Fill( dphi_pn , dtheta_pn , weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_pn_angles->Fill( dphi_pn , dtheta_pn , weight);
+	  }
           if (dtheta_pn>-15) {continue;}
+	  auto fill_timer = stats.time(jobStage::Fill);
           h_pn_pmiss->Fill(p_miss.Mag(),p_n.Mag(),weight);
           h_cos0->Fill(cos0,weight);
           h_theta_phi_p->Fill(p_p.Theta()*180./M_PI,p_p.Phi()*180./M_PI,weight);
@@ -644,6 +672,7 @@ int main(int argc, char ** argv)
 
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -955,6 +984,7 @@ int main(int argc, char ** argv)
   myCanvas->Print(fileName,"pdf");
 
   outFile->Close();
+  stats.summary();
 }
 
 
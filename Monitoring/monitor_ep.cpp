@@ -19,6 +19,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut/eventcut.h"
 #include "eventcut/functions.h"
 
@@ -57,9 +58,11 @@ int main(int argc, char ** argv)
   eventcut myCut(Ebeam,argv[5]);
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("monitor_ep");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -356,15 +359,10 @@ int main(int argc, char ** argv)
   int counter = 0;
 
   //Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       // get particles by type
       auto allParticles = c12->getDetParticles();
@@ -385,22 +383,31 @@ int main(int argc, char ** argv)
   /////////////////////////////////////
   //Electron fiducials
   /////////////////////////////////////      
-      h_phi_theta->Fill(p_e.Phi()*180/M_PI,p_e.Theta()*180/M_PI,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_phi_theta->Fill(p_e.Phi()*180/M_PI,p_e.Theta()*180/M_PI,weight);
+      }
       if(EoP_e<=0){ continue; }
       int esector = electrons[0]->getSector();
-      h_sector->Fill(esector,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_sector->Fill(esector,weight);
 
-      h_Vcal_EoP[esector-1]->Fill(electrons[0]->cal(PCAL)->getLv(),EoP_e,weight);
-      h_Wcal_EoP[esector-1]->Fill(electrons[0]->cal(PCAL)->getLw(),EoP_e,weight);
+	h_Vcal_EoP[esector-1]->Fill(electrons[0]->cal(PCAL)->getLv(),EoP_e,weight);
+	h_Wcal_EoP[esector-1]->Fill(electrons[0]->cal(PCAL)->getLw(),EoP_e,weight);
+      }
   /////////////////////////////////////
   //Electron Pid
   /////////////////////////////////////
-      h_mom_EoP[esector-1]->Fill(p_e.Mag(),EoP_e,weight);
-      h_nphe->Fill(nphe,weight);
-      h_vtz_e->Fill(vtz_e,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_mom_EoP[esector-1]->Fill(p_e.Mag(),EoP_e,weight);
+	h_nphe->Fill(nphe,weight);
+	h_vtz_e->Fill(vtz_e,weight);
+      }
 
 
-      if(!myCut.electroncut(c12)){continue;}      
+      if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})){continue;}      
   /////////////////////////////////////
   //Electron Kinematics  
   /////////////////////////////////////
@@ -413,19 +420,23 @@ int main(int argc, char ** argv)
       double theta_e = p_e.Theta() * 180 / M_PI;
       //if(WSq>1.25){continue;}
 
-      h_xB->Fill(xB,weight);
-      h_QSq->Fill(QSq,weight);
-      h_WSq->Fill(WSq,weight);
-      h_W->Fill(sqrt(WSq),weight);
-      h_xB_QSq->Fill(xB,QSq,weight);
-      h_xB_WSq->Fill(xB,WSq,weight);
-      h_QSq_WSq->Fill(QSq,WSq,weight);
-      h_mom_theta[esector-1]->Fill(p_e.Mag(),theta_e,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_xB->Fill(xB,weight);
+	h_QSq->Fill(QSq,weight);
+	h_WSq->Fill(WSq,weight);
+	h_W->Fill(sqrt(WSq),weight);
+	h_xB_QSq->Fill(xB,QSq,weight);
+	h_xB_WSq->Fill(xB,WSq,weight);
+	h_QSq_WSq->Fill(QSq,WSq,weight);
+	h_mom_theta[esector-1]->Fill(p_e.Mag(),theta_e,weight);
+      }
 
   /////////////////////////////////////
   //Electron Kinematics with SRC kinematics
   /////////////////////////////////////
       if((xB>1) && (QSq>1.5)){
+	auto fill_timer = stats.time(jobStage::Fill);
 	h_mom_theta_eSRC->Fill(p_e.Mag(),theta_e,weight);
 	h_xB_theta_eSRC->Fill(xB,theta_e,weight);
 	h_thetaq_theta_eSRC->Fill(theta_q,theta_e,weight);
@@ -444,26 +455,35 @@ int main(int argc, char ** argv)
 	bool FTOF2 = (allParticles[j]->sci(clas12::FTOF2)->getDetector() == 12);
 	bool CTOF = (allParticles[j]->sci(clas12::CTOF)->getDetector() == 4);
 	if(FTOF1A || FTOF1B || FTOF2){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_mom_beta_hadplus_FTOF->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
 	}
 	if(CTOF){
-	  h_mom_beta_hadplus_CTOF->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
-	  h_mom_beta_hadplus_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
+	  {
+	    auto fill_timer = stats.time(jobStage::Fill);
+	    h_mom_beta_hadplus_CTOF->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
+	    h_mom_beta_hadplus_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
+	  }
  	  
 	  int PID = allParticles[j]->getPid();
 	  if(PID==2212){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_proton_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);  
 	  }
 	  if(PID==211){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_pion_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);  
 	  }
 	  if(PID==321){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_kaon_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);  
 	  }
 	  if(PID==45){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_deuteron_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);
 	  }
 	  if(PID==0){
+	    auto fill_timer = stats.time(jobStage::Fill);
 	    h_mom_beta_0_CTOF_zoom->Fill(allParticles[j]->getP(),allParticles[j]->par()->getBeta(),weight);  
 	  }
 
@@ -496,6 +516,7 @@ int main(int argc, char ** argv)
 	bool CTOF = (protons[j]->sci(clas12::CTOF)->getDetector() == 4);
 
 	if(FTOF1A || FTOF1B || FTOF2){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_chiSq_p_FTOF->Fill(Chi2Pid_p,weight);
 	  h_vtz_p_FTOF->Fill(vtz_p,weight);
 	  h_vtz_ep_delta_FTOF->Fill(vtz_ep_delta,weight);
@@ -512,6 +533,7 @@ int main(int argc, char ** argv)
 	}
 
 	if(CTOF){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_chiSq_p_CTOF->Fill(Chi2Pid_p,weight);
 	  h_vtz_p_CTOF->Fill(vtz_p,weight);
 	  h_vtz_ep_delta_CTOF->Fill(vtz_ep_delta,weight);
@@ -531,7 +553,7 @@ int main(int argc, char ** argv)
   /////////////////////////////////////
   //Lead Proton Checks
   /////////////////////////////////////
-      int index_L = myCut.leadnucleoncut(c12);
+      int index_L = stats.timed(jobStage::Selection,[&]{return myCut.leadnucleoncut(c12);});
       if(index_L < 0){ continue; }
       TVector3 p_L;
       p_L.SetMagThetaPhi(protons[index_L]->getP(),protons[index_L]->getTheta(),protons[index_L]->getPhi());
@@ -553,6 +575,7 @@ int main(int argc, char ** argv)
       bool CTOF =   (protons[index_L]->sci(clas12::CTOF)->getDetector() == 4);
 
       if(FTOF1A || FTOF1B || FTOF2){
+	auto fill_timer = stats.time(jobStage::Fill);
 	h_theta_p_Lead_FTOF->Fill(theta_L,weight);
 	h_theta_pq_Lead_FTOF->Fill(theta_Lq,weight);
 	h_mom_theta_p_Lead_FTOF->Fill(p_L.Mag(),theta_L,weight);
@@ -575,6 +598,7 @@ int main(int argc, char ** argv)
 	h_mmiss_momT_p_Lead_FTOF->Fill(mmiss,p_L.Perp(),weight);
       }
       if(CTOF){
+	auto fill_timer = stats.time(jobStage::Fill);
 	h_theta_p_Lead_CTOF->Fill(theta_L,weight);
 	h_theta_pq_Lead_CTOF->Fill(theta_Lq,weight);
 	h_mom_theta_p_Lead_CTOF->Fill(p_L.Mag(),theta_L,weight);
@@ -599,6 +623,7 @@ int main(int argc, char ** argv)
   }
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -1009,6 +1034,7 @@ int main(int argc, char ** argv)
   myCanvas->Print(fileName,"pdf");
 
   outFile->Close();
+  stats.summary();
 }
 
 
@@ -19,6 +19,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut/eventcut.h"
 #include "eventcut/functions.h"
 
@@ -57,9 +58,11 @@ int main(int argc, char ** argv)
   eventcut myCut(Ebeam,argv[5]);
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("monitor_epn");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -212,15 +215,10 @@ int main(int argc, char ** argv)
   int counter = 0;
 
   //Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       // get particles by type
       auto electrons=c12->getByID(11);
@@ -230,7 +228,7 @@ int main(int argc, char ** argv)
       if(isMC){weight=c12->mcevent()->getWeight();}
       TVector3 	p_b(0,0,Ebeam);
 
-      if(!myCut.electroncut(c12)){continue;}      
+      if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})){continue;}      
 
       TVector3 p_e;
       p_e.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
@@ -245,7 +243,7 @@ int main(int argc, char ** argv)
   /////////////////////////////////////
   //Lead Proton Checks
   /////////////////////////////////////
-      int index_L = myCut.leadnucleoncut(c12);
+      int index_L = stats.timed(jobStage::Selection,[&]{return myCut.leadnucleoncut(c12);});
       if(index_L < 0){ continue; }
       TVector3 p_L;
       p_L.SetMagThetaPhi(protons[index_L]->getP(),protons[index_L]->getTheta(),protons[index_L]->getPhi());
@@ -261,55 +259,68 @@ int main(int argc, char ** argv)
       double theta_1q = p_1.Angle(p_q) * 180 / M_PI;
       double vtz_p = protons[index_L]->par()->getVz();
 
-      h_theta_p_Lead->Fill(theta_L,weight);
-      h_theta_pq_Lead->Fill(theta_Lq,weight);
-      h_mom_theta_p_Lead->Fill(p_L.Mag(),theta_L,weight);
-      h_phi_e_p_Lead->Fill(phi_diff,weight);
-      h_xB_Lead->Fill(xB,weight);
-      h_vtz_e_vtz_p_Lead->Fill(vtz_e,vtz_p,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_theta_p_Lead->Fill(theta_L,weight);
+	h_theta_pq_Lead->Fill(theta_Lq,weight);
+	h_mom_theta_p_Lead->Fill(p_L.Mag(),theta_L,weight);
+	h_phi_e_p_Lead->Fill(phi_diff,weight);
+	h_xB_Lead->Fill(xB,weight);
+	h_vtz_e_vtz_p_Lead->Fill(vtz_e,vtz_p,weight);
       
-      h_pmiss_Lead->Fill(p_miss.Mag(),weight);
-      h_pmiss_thetamiss_Lead->Fill(p_miss.Mag(),theta_miss,weight);
-      h_xB_theta_1q_Lead->Fill(xB,theta_1q,weight);
-      h_Loq_theta_1q_Lead->Fill(Loq,theta_1q,weight);
+	h_pmiss_Lead->Fill(p_miss.Mag(),weight);
+	h_pmiss_thetamiss_Lead->Fill(p_miss.Mag(),theta_miss,weight);
+	h_xB_theta_1q_Lead->Fill(xB,theta_1q,weight);
+	h_Loq_theta_1q_Lead->Fill(Loq,theta_1q,weight);
       
-      h_mmiss_Lead->Fill(mmiss,weight);
-      h_mmiss_phi_e_p_Lead->Fill(mmiss,phi_diff,weight);
-      h_mmiss_xB_Lead->Fill(mmiss,xB,weight);
-      h_mmiss_pmiss_Lead->Fill(mmiss,p_miss.Mag(),weight);
-      h_mmiss_theta_1q_Lead->Fill(mmiss,theta_1q,weight);
-      h_mmiss_theta_p_Lead->Fill(mmiss,theta_L,weight);
-      h_mmiss_mom_p_Lead->Fill(mmiss,p_L.Mag(),weight);
-      h_mmiss_momT_p_Lead->Fill(mmiss,p_L.Perp(),weight);
+	h_mmiss_Lead->Fill(mmiss,weight);
+	h_mmiss_phi_e_p_Lead->Fill(mmiss,phi_diff,weight);
+	h_mmiss_xB_Lead->Fill(mmiss,xB,weight);
+	h_mmiss_pmiss_Lead->Fill(mmiss,p_miss.Mag(),weight);
+	h_mmiss_theta_1q_Lead->Fill(mmiss,theta_1q,weight);
+	h_mmiss_theta_p_Lead->Fill(mmiss,theta_L,weight);
+	h_mmiss_mom_p_Lead->Fill(mmiss,p_L.Mag(),weight);
+	h_mmiss_momT_p_Lead->Fill(mmiss,p_L.Perp(),weight);
+      }
         
   /////////////////////////////////////
   //Lead SRC Proton Checks
   /////////////////////////////////////
-      if(!myCut.leadSRCnucleoncut(c12,index_L)){continue;}
+      if(!stats.timed(jobStage::Selection,[&]{return myCut.leadSRCnucleoncut(c12,index_L);})){continue;}
 
-      h_xB_SRC->Fill(xB,weight);
-      h_pmiss_SRC->Fill(p_miss.Mag(),weight);
-      h_mmiss_SRC->Fill(mmiss,weight);
-      h_pmiss_theta_miss_SRC->Fill(p_miss.Mag(),theta_miss,weight);
-      h_pmiss_theta_L_SRC->Fill(p_miss.Mag(),theta_L,weight);
-      h_xB_Loq_SRC->Fill(xB,Loq,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_xB_SRC->Fill(xB,weight);
+	h_pmiss_SRC->Fill(p_miss.Mag(),weight);
+	h_mmiss_SRC->Fill(mmiss,weight);
+	h_pmiss_theta_miss_SRC->Fill(p_miss.Mag(),theta_miss,weight);
+	h_pmiss_theta_L_SRC->Fill(p_miss.Mag(),theta_L,weight);
+	h_xB_Loq_SRC->Fill(xB,Loq,weight);
+      }
 
   /////////////////////////////////////
   //Recoil Nucleons
   /////////////////////////////////////
       for(int j = 0; j < neutrons.size(); j++){
 	//if(j==index_L){continue;}
-	h_p_2_AllRec->Fill(neutrons[j]->getP(),weight);
-	h_chiSq_rec_AllRec->Fill(neutrons[j]->par()->getChi2Pid(),weight);
+	{
+	  auto fill_timer = stats.time(jobStage::Fill);
+	  h_p_2_AllRec->Fill(neutrons[j]->getP(),weight);
+	  h_chiSq_rec_AllRec->Fill(neutrons[j]->par()->getChi2Pid(),weight);
+	}
 //std::cout << neutrons[j]->par()->getChi2Pid() << '\n';
+	auto fill_timer = stats.time(jobStage::Fill);
 	h_mom_beta_rec_AllRec->Fill(neutrons[j]->getP(),neutrons[j]->par()->getBeta(),weight);
       }
-      h_count_AllRec->Fill(neutrons.size()-1,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_count_AllRec->Fill(neutrons.size()-1,weight);
+      }
 
   /////////////////////////////////////
   //Recoil SRC Proton Checks
   /////////////////////////////////////
-      int index_R = myCut.recoilSRCnucleoncut(c12,index_L);
+      int index_R = stats.timed(jobStage::Selection,[&]{return myCut.recoilSRCnucleoncut(c12,index_L);});
       if(index_R < 0){ continue; }
       TVector3 p_2;
       p_2.SetMagThetaPhi(neutrons[index_R]->getP(),neutrons[index_R]->getTheta(),neutrons[index_R]->getPhi());
@@ -327,17 +338,20 @@ int main(int argc, char ** argv)
       double tofm = (neutrons[index_R]->getTime())/(neutrons[index_R]->getPath()/10.);
       double tofphi = neutrons[index_R]->getPhi()*180./M_PI;
       
-      h_p_2_Rec->Fill(neutrons[index_R]->getP(),weight);
-      h_p_rel_Rec->Fill(p_rel.Mag(),weight);
-      h_p_cm_Rec->Fill(p_cm.Mag(),weight);
-      h_p_t_cm_Rec->Fill(p_cm.Dot(vt),weight);
-      h_p_y_cm_Rec->Fill(p_cm.Dot(vy),weight);
-      h_p_x_cm_Rec->Fill(p_cm.Dot(vx),weight);
-      h_theta_rel_Rec->Fill(theta_rel,weight);
-      h_p_cm_theta_rel_Rec->Fill(p_cm.Mag(),theta_rel,weight);
-      h_nacc->Fill(neutrons[index_R]->getPhi()*180./M_PI,neutrons[index_R]->getTheta()*180./M_PI,weight);
-      h_nbeta->Fill(neutrons[index_R]->getBeta(),weight);
-      h_tofm->Fill(tofm);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_p_2_Rec->Fill(neutrons[index_R]->getP(),weight);
+	h_p_rel_Rec->Fill(p_rel.Mag(),weight);
+	h_p_cm_Rec->Fill(p_cm.Mag(),weight);
+	h_p_t_cm_Rec->Fill(p_cm.Dot(vt),weight);
+	h_p_y_cm_Rec->Fill(p_cm.Dot(vy),weight);
+	h_p_x_cm_Rec->Fill(p_cm.Dot(vx),weight);
+	h_theta_rel_Rec->Fill(theta_rel,weight);
+	h_p_cm_theta_rel_Rec->Fill(p_cm.Mag(),theta_rel,weight);
+	h_nacc->Fill(neutrons[index_R]->getPhi()*180./M_PI,neutrons[index_R]->getTheta()*180./M_PI,weight);
+	h_nbeta->Fill(neutrons[index_R]->getBeta(),weight);
+	h_tofm->Fill(tofm);
+      }
 
   /////////////////////////////////////
   //Deuterium Momentum Analysis
@@ -345,16 +359,22 @@ int main(int argc, char ** argv)
   TVector3 vecX( neutrons[index_R]->par()->getPx(), neutrons[index_R]->par()->getPy(), neutrons[index_R]->par()->getPz() );
   double cos0 = p_miss.Dot(vecX) / (p_miss.Mag() * vecX.Mag() );
 
-  h_pmiss_pn->Fill(neutrons[index_R]->getP(),p_miss.Mag(),weight);
-  h_cos0->Fill(cos0,weight);
+  {
+    auto fill_timer = stats.time(jobStage::Fill);
+    h_pmiss_pn->Fill(neutrons[index_R]->getP(),p_miss.Mag(),weight);
+    h_cos0->Fill(cos0,weight);
+  }
 
   /////////////////////////////////////
   //Deuterium with cuts
   /////////////////////////////////////
   if (cos0<0.95) { continue; }
   
-  h_pmiss_pn_cut->Fill(neutrons[index_R]->getP(),p_miss.Mag(),weight);
-  h_cos0_cut->Fill(cos0,weight);
+  {
+    auto fill_timer = stats.time(jobStage::Fill);
+    h_pmiss_pn_cut->Fill(neutrons[index_R]->getP(),p_miss.Mag(),weight);
+    h_cos0_cut->Fill(cos0,weight);
+  }
 
 
 
@@ -362,6 +382,7 @@ int main(int argc, char ** argv)
   }
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -601,6 +622,7 @@ int main(int argc, char ** argv)
   myCanvas->Print(fileName,"pdf");
 
   outFile->Close();
+  stats.summary();
 }
 
 
@@ -19,6 +19,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut/eventcut.h"
 #include "eventcut/functions.h"
 
@@ -58,9 +59,11 @@ int main(int argc, char ** argv)
   eventcut myCut(Ebeam,argv[5]);
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("monitor_epp");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -252,15 +255,10 @@ int main(int argc, char ** argv)
   int counter = 0;
 
   //Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
       //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cerr << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cerr << ".";
-      }    
+      auto analysis_timer = stats.time(jobStage::Analysis);
 
       // get particles by type
       auto electrons=c12->getByID(11);
@@ -270,7 +268,7 @@ int main(int argc, char ** argv)
       if(isMC){weight=c12->mcevent()->getWeight();}
       TVector3 	p_b(0,0,Ebeam);
 
-      if(!myCut.electroncut(c12)){continue;}      
+      if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})){continue;}      
 
       TVector3 p_e;
       p_e.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
@@ -285,7 +283,7 @@ int main(int argc, char ** argv)
   /////////////////////////////////////
   //Lead Proton Checks
   /////////////////////////////////////
-      int index_L = myCut.leadnucleoncut(c12);
+      int index_L = stats.timed(jobStage::Selection,[&]{return myCut.leadnucleoncut(c12);});
       if(index_L < 0){ continue; }
       TVector3 p_L;
       p_L.SetMagThetaPhi(protons[index_L]->getP(),protons[index_L]->getTheta(),protons[index_L]->getPhi());
@@ -301,34 +299,38 @@ int main(int argc, char ** argv)
       double theta_1q = p_1.Angle(p_q) * 180 / M_PI;
       double vtz_p = protons[index_L]->par()->getVz();
 
-      h_theta_p_Lead->Fill(theta_L,weight);
-      h_mom_p_Lead->Fill(p_L.Mag(),weight);
-      h_phi_p_Lead->Fill(phi_L,weight);
-      h_theta_pq_Lead->Fill(theta_Lq,weight);
-      h_mom_theta_p_Lead->Fill(p_L.Mag(),theta_L,weight);
-      h_phi_e_p_Lead->Fill(phi_diff,weight);
-      h_xB_Lead->Fill(xB,weight);
-      h_Q2_Lead->Fill(QSq,weight);
-      h_xB_Q2_Lead->Fill(xB,QSq,weight);
-      h_vtz_e_vtz_p_Lead->Fill(vtz_e,vtz_p,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_theta_p_Lead->Fill(theta_L,weight);
+	h_mom_p_Lead->Fill(p_L.Mag(),weight);
+	h_phi_p_Lead->Fill(phi_L,weight);
+	h_theta_pq_Lead->Fill(theta_Lq,weight);
+	h_mom_theta_p_Lead->Fill(p_L.Mag(),theta_L,weight);
+	h_phi_e_p_Lead->Fill(phi_diff,weight);
+	h_xB_Lead->Fill(xB,weight);
+	h_Q2_Lead->Fill(QSq,weight);
+	h_xB_Q2_Lead->Fill(xB,QSq,weight);
+	h_vtz_e_vtz_p_Lead->Fill(vtz_e,vtz_p,weight);
       
-      h_pmiss_Lead->Fill(p_miss.Mag(),weight);
-      h_pmiss_thetamiss_Lead->Fill(p_miss.Mag(),theta_miss,weight);
-      h_xB_theta_1q_Lead->Fill(xB,theta_1q,weight);
-      h_Loq_theta_1q_Lead->Fill(Loq,theta_1q,weight);
+	h_pmiss_Lead->Fill(p_miss.Mag(),weight);
+	h_pmiss_thetamiss_Lead->Fill(p_miss.Mag(),theta_miss,weight);
+	h_xB_theta_1q_Lead->Fill(xB,theta_1q,weight);
+	h_Loq_theta_1q_Lead->Fill(Loq,theta_1q,weight);
       
-      h_mmiss_Lead->Fill(mmiss,weight);
-      h_mmiss_phi_e_p_Lead->Fill(mmiss,phi_diff,weight);
-      h_mmiss_xB_Lead->Fill(mmiss,xB,weight);
-      h_mmiss_pmiss_Lead->Fill(mmiss,p_miss.Mag(),weight);
-      h_mmiss_theta_1q_Lead->Fill(mmiss,theta_1q,weight);
-      h_mmiss_theta_p_Lead->Fill(mmiss,theta_L,weight);
-      h_mmiss_mom_p_Lead->Fill(mmiss,p_L.Mag(),weight);
-      h_mmiss_momT_p_Lead->Fill(mmiss,p_L.Perp(),weight);
+	h_mmiss_Lead->Fill(mmiss,weight);
+	h_mmiss_phi_e_p_Lead->Fill(mmiss,phi_diff,weight);
+	h_mmiss_xB_Lead->Fill(mmiss,xB,weight);
+	h_mmiss_pmiss_Lead->Fill(mmiss,p_miss.Mag(),weight);
+	h_mmiss_theta_1q_Lead->Fill(mmiss,theta_1q,weight);
+	h_mmiss_theta_p_Lead->Fill(mmiss,theta_L,weight);
+	h_mmiss_mom_p_Lead->Fill(mmiss,p_L.Mag(),weight);
+	h_mmiss_momT_p_Lead->Fill(mmiss,p_L.Perp(),weight);
+      }
 
       
       if((p_miss.Theta()>(M_PI/2)) && pointsToBand(p_miss.Theta(),p_miss.Phi(),vtz_p)){
 	if(p_miss.Mag()>0.2){
+	  auto fill_timer = stats.time(jobStage::Fill);
 	  h_pmiss_BAND->Fill(p_miss.Mag(),weight);
 	  h_thetamiss_BAND->Fill(theta_miss,weight);
 	  h_mmiss_BAND->Fill(mmiss,weight);
@@ -338,21 +340,24 @@ int main(int argc, char ** argv)
   /////////////////////////////////////
   //Lead SRC Proton Checks
   /////////////////////////////////////
-      if(!myCut.leadSRCnucleoncut(c12,index_L)){continue;}
-
-      h_xB_SRC->Fill(xB,weight);
-      h_Q2_SRC->Fill(QSq,weight);
-      h_W_SRC->Fill(sqrt(WSq),weight);
-      h_pmiss_SRC->Fill(p_miss.Mag(),weight);
-      h_mmiss_SRC->Fill(mmiss,weight);
-
-      h_pmiss_theta_miss_SRC->Fill(p_miss.Mag(),theta_miss,weight);
-      h_pmiss_xB_SRC->Fill(p_miss.Mag(),xB,weight);
-      h_pmiss_theta_L_SRC->Fill(p_miss.Mag(),theta_L,weight);
-      h_xB_Loq_SRC->Fill(xB,Loq,weight);
-      h_mmiss_xB_SRC->Fill(mmiss,xB,weight);
-      h_mmiss_mom_p_SRC->Fill(mmiss,p_L.Mag(),weight);
-      h_mmiss_theta_p_SRC->Fill(mmiss,theta_L,weight);
+      if(!stats.timed(jobStage::Selection,[&]{return myCut.leadSRCnucleoncut(c12,index_L);})){continue;}
+
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_xB_SRC->Fill(xB,weight);
+	h_Q2_SRC->Fill(QSq,weight);
+	h_W_SRC->Fill(sqrt(WSq),weight);
+	h_pmiss_SRC->Fill(p_miss.Mag(),weight);
+	h_mmiss_SRC->Fill(mmiss,weight);
+
+	h_pmiss_theta_miss_SRC->Fill(p_miss.Mag(),theta_miss,weight);
+	h_pmiss_xB_SRC->Fill(p_miss.Mag(),xB,weight);
+	h_pmiss_theta_L_SRC->Fill(p_miss.Mag(),theta_L,weight);
+	h_xB_Loq_SRC->Fill(xB,Loq,weight);
+	h_mmiss_xB_SRC->Fill(mmiss,xB,weight);
+	h_mmiss_mom_p_SRC->Fill(mmiss,p_L.Mag(),weight);
+	h_mmiss_theta_p_SRC->Fill(mmiss,theta_L,weight);
+      }
 
 
   /////////////////////////////////////
@@ -374,6 +379,7 @@ int main(int argc, char ** argv)
 	double time_frombeta_p = path_p / (c*beta_p);
 	double time_diff = time_frombeta_p-time_frommom_p;
 
+	auto fill_timer = stats.time(jobStage::Fill);
 	h_p_rec_AllRec->Fill(mom,weight);
 	h_theta_rec_AllRec->Fill(theta,weight);
 	h_phi_rec_AllRec->Fill(phi,weight);
@@ -395,14 +401,20 @@ int main(int argc, char ** argv)
 	h_p_rec_vtzdiff_rec_AllRec->Fill(mom,vtz_e-vtz_p,weight);
 	
       }
-      h_count_AllRec->Fill(protons.size()-1,weight);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_count_AllRec->Fill(protons.size()-1,weight);
+      }
 
   /////////////////////////////////////
   //Recoil SRC Proton Checks
   /////////////////////////////////////
-      int index_R = myCut.recoilSRCnucleoncut(c12,index_L);
+      int index_R = stats.timed(jobStage::Selection,[&]{return myCut.recoilSRCnucleoncut(c12,index_L);});
       if(index_R < 0){ continue; }
-      //h_vtz_e_vtz_rec_AllRec->Fill(vtz_e,protons[index_R]->par()->getVz(),weight);      
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	//h_vtz_e_vtz_rec_AllRec->Fill(vtz_e,protons[index_R]->par()->getVz(),weight);      
+      }
       TVector3 p_2;
       p_2.SetMagThetaPhi(protons[index_R]->getP(),protons[index_R]->getTheta(),protons[index_R]->getPhi());
       TVector3 p_rel = p_1-p_2;
@@ -415,6 +427,7 @@ int main(int argc, char ** argv)
       TVector3 vy = p_2.Cross(p_q).Unit();
       TVector3 vx = vt.Cross(vy);
       
+      auto fill_timer = stats.time(jobStage::Fill);
       h_p_2_Rec->Fill(protons[index_R]->getP(),weight);
       h_pmiss_Rec->Fill(p_miss.Mag(),weight);
       h_p_rel_Rec->Fill(p_rel.Mag(),weight);
@@ -428,6 +441,7 @@ int main(int argc, char ** argv)
   }
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
 
   /////////////////////////////////////////////////////
   //Now create the output PDFs
@@ -715,6 +729,7 @@ int main(int argc, char ** argv)
     hist_list_2[i]->Write();
   }
   outFile->Close();
+  stats.summary();
 }
 
 
@@ -21,6 +21,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut/eventcut.h"
 #include "eventcut/functions.h"
 
@@ -97,9 +98,11 @@ int main(int argc, char ** argv)
   eventcut myCut(Ebeam,argv[5]);
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("neff_d_pcdn_old");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -268,16 +271,10 @@ int main(int argc, char ** argv)
 
 
   // Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
     // display completed
     counter++;
-    if((counter%1000000) == 0){
-      cerr << '\n' << counter/1000000 << " million completed";
-    }
-
-    if((counter%100000) == 0){
-      cerr << ".";
-    }
+    auto analysis_timer = stats.time(jobStage::Analysis);
 
     // get particles by type
     auto elec=c12->getByID(11);
@@ -293,7 +290,7 @@ int main(int argc, char ** argv)
 
 
     // GENERAL EVENT SELECTION
-    if(!myCut.electroncut(c12)) {continue;}
+    if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})) {continue;}
     if(prot.size()!=1) {continue;}
     if(elec.size()!=1) {continue;}
     //if(phot.size()>0) {continue;}
@@ -331,9 +328,12 @@ int main(int argc, char ** argv)
     if(!is_CD) {continue;}
 
     // protons histos
-    h_pvertex->Fill(vzp-vze,weight);
-    h_dbetap->Fill(pp.Mag(),dbeta,weight);
-    h_pchipid->Fill(chipid,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pvertex->Fill(vzp-vze,weight);
+      h_dbetap->Fill(pp.Mag(),dbeta,weight);
+      h_pchipid->Fill(chipid,weight);
+    }
 
     // proton cuts
     if ((vzp-vze)<-4. || (vzp-vze)>4.) {continue;}
@@ -348,7 +348,10 @@ int main(int argc, char ** argv)
     double thetamiss = pmiss.Theta()*180./M_PI;
 
     // cut on theta component of pmiss
-    h_thetamiss_before->Fill(thetamiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_thetamiss_before->Fill(thetamiss,weight);
+    }
     if (thetamiss<40.) {continue;}
     if (thetamiss>140.) {continue;}
 
@@ -357,21 +360,27 @@ int main(int argc, char ** argv)
     if (pmiss.Mag() > 1.25) {continue;} // beta = 0.8, p = 1.2528
 
     // xb cut
-    h_mmiss_xb->Fill(xB,mmiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_xb->Fill(xB,mmiss,weight);
+    }
     if (xB<0.6) {continue;}
 
 
-    h_theta_ppmiss->Fill(pmiss.Angle(pp)*180./M_PI,weight);
-    //if ((pmiss.Angle(pp)*180./M_PI)<40.) {continue;}  // CD ONLY (I THINK)
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_theta_ppmiss->Fill(pmiss.Angle(pp)*180./M_PI,weight);
+      //if ((pmiss.Angle(pp)*180./M_PI)<40.) {continue;}  // CD ONLY (I THINK)
     
-    h_mmiss_pmiss->Fill(pmiss.Mag(),mmiss,weight);
-    h_mmiss_pmissCAND->Fill(pmiss.Mag(),mmiss,weight);
-    h_mmiss_theta->Fill(thetamiss,mmiss,weight);
-    h_mmiss_thetaCAND->Fill(thetamiss,mmiss,weight);
+      h_mmiss_pmiss->Fill(pmiss.Mag(),mmiss,weight);
+      h_mmiss_pmissCAND->Fill(pmiss.Mag(),mmiss,weight);
+      h_mmiss_theta->Fill(thetamiss,mmiss,weight);
+      h_mmiss_thetaCAND->Fill(thetamiss,mmiss,weight);
 
 
-    if (mmiss>Mlow && mmiss<Mhigh) { h_neff_pmiss_denom_ssb->Fill(pmiss.Mag(),weight);}
-    if (mmiss>Mlow && mmiss<Mhigh) { h_neff_thetamiss_denom_ssb->Fill(thetamiss,weight);}
+      if (mmiss>Mlow && mmiss<Mhigh) { h_neff_pmiss_denom_ssb->Fill(pmiss.Mag(),weight);}
+      if (mmiss>Mlow && mmiss<Mhigh) { h_neff_thetamiss_denom_ssb->Fill(thetamiss,weight);}
+    }
 
 
     // REQUIRE A NEUTRON HERE
@@ -379,7 +388,10 @@ int main(int argc, char ** argv)
 
     // NEUTRONS
     double sz = neut.size();
-    h_nsize->Fill(sz,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_nsize->Fill(sz,weight);
+    }
 
 
     int pick = -1;
@@ -465,15 +477,18 @@ int main(int argc, char ** argv)
 
 
     // fill histos with good neutrons
-    h_tof->Fill(tof_n,weight);
-    h_nangles->Fill(n_phi,n_theta,weight);
-    h_dphi->Fill(dphi,weight);
-    h_pmiss_pn->Fill(pn.Mag(),pmiss.Mag(),weight);
-    h_dtheta_dphi->Fill(dphi,pmiss.Theta()*180./M_PI - neut[pick]->getTheta()*180./M_PI,weight);
-    h_theta_edep->Fill(neut[pick]->getTheta()*180./M_PI,edep,weight);
-    //h_mmiss_beta_after->Fill(beta_n,mmiss,weight);
-    //h_beta_pmiss->Fill(pmiss.Mag(),beta_n,weight);
-    h_cos0->Fill(cos0,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_tof->Fill(tof_n,weight);
+      h_nangles->Fill(n_phi,n_theta,weight);
+      h_dphi->Fill(dphi,weight);
+      h_pmiss_pn->Fill(pn.Mag(),pmiss.Mag(),weight);
+      h_dtheta_dphi->Fill(dphi,pmiss.Theta()*180./M_PI - neut[pick]->getTheta()*180./M_PI,weight);
+      h_theta_edep->Fill(neut[pick]->getTheta()*180./M_PI,edep,weight);
+      //h_mmiss_beta_after->Fill(beta_n,mmiss,weight);
+      //h_beta_pmiss->Fill(pmiss.Mag(),beta_n,weight);
+      h_cos0->Fill(cos0,weight);
+    }
 
 
 
@@ -481,23 +496,33 @@ int main(int argc, char ** argv)
     if (cos0 < 0.9) {continue;}
 
     // after requiring pn along pmiss
-    h_pmiss_pn_cut->Fill(pn.Mag(),pmiss.Mag(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pmiss_pn_cut->Fill(pn.Mag(),pmiss.Mag(),weight);
 
-    if (mmiss>1.15) {h_pmiss_pn_bkg->Fill(pn.Mag(),pmiss.Mag(),weight);}
-    if (mmiss<1.05) {h_pmiss_pn_sig->Fill(pn.Mag(),pmiss.Mag(),weight);}
-    if (mmiss>1.15) {h_dp_p_bkg->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
-    if (mmiss<1.05) {h_dp_p_sig->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
+      if (mmiss>1.15) {h_pmiss_pn_bkg->Fill(pn.Mag(),pmiss.Mag(),weight);}
+      if (mmiss<1.05) {h_pmiss_pn_sig->Fill(pn.Mag(),pmiss.Mag(),weight);}
+      if (mmiss>1.15) {h_dp_p_bkg->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
+      if (mmiss<1.05) {h_dp_p_sig->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
+    }
 
     if (std::abs(pmiss.Mag()-pn.Mag())>0.2) {continue;}
 
-    h_mmiss_withn->Fill(mmiss,weight);
-    h_pmiss_theta->Fill(neut[pick]->getTheta()*180./M_PI,pmiss.Mag(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_withn->Fill(mmiss,weight);
+      h_pmiss_theta->Fill(neut[pick]->getTheta()*180./M_PI,pmiss.Mag(),weight);
+    }
 
     // cut out fake neutron background
     double theta_np = pn.Angle(pp)*180./M_PI;
-    h_theta_np->Fill(theta_np,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_theta_np->Fill(theta_np,weight);
+    }
 
     if (is_CD && theta_np<40.) {continue;}
+    auto fill_timer = stats.time(jobStage::Fill);
     h_pmiss_pn_cutbkg->Fill(pn.Mag(),pmiss.Mag(),weight); // CTOF p only
     h_pmiss_theta_cutbkg->Fill(n_theta,pmiss.Mag(),weight);
 
@@ -517,6 +542,7 @@ int main(int argc, char ** argv)
 
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -941,6 +967,7 @@ int main(int argc, char ** argv)
   myCanvas->Print(fileName,"pdf");
 
   outFile->Close();
+  stats.summary();
 }
 
 
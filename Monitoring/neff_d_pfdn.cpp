@@ -21,6 +21,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut.h"
 #include "functions.h"
 
@@ -96,9 +97,11 @@ int main(int argc, char ** argv)
   eventcut myCut(Ebeam,argv[5]);
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("neff_d_pfdn");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -276,16 +279,10 @@ int main(int argc, char ** argv)
 
 
   // Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
     // display completed
     counter++;
-    if((counter%1000000) == 0){
-      cerr << '\n' << counter/1000000 << " million completed";
-    }
-
-    if((counter%100000) == 0){
-      cerr << ".";
-    }
+    auto analysis_timer = stats.time(jobStage::Analysis);
 
     // get particles by type
     auto elec=c12->getByID(11);
@@ -301,7 +298,7 @@ int main(int argc, char ** argv)
 
 
     // GENERAL EVENT SELECTION
-    if(!myCut.electroncut(c12)) {continue;}
+    if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})) {continue;}
     if(prot.size()!=1) {continue;}
     if(elec.size()!=1) {continue;}
     //if(phot.size()>0) {continue;}
@@ -339,9 +336,12 @@ int main(int argc, char ** argv)
     if(!is_FD) {continue;}
 
     // protons histos
-    h_pvertex->Fill(vzp-vze,weight);
-    h_dbetap->Fill(pp.Mag(),dbeta,weight);
-    h_pchipid->Fill(chipid,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pvertex->Fill(vzp-vze,weight);
+      h_dbetap->Fill(pp.Mag(),dbeta,weight);
+      h_pchipid->Fill(chipid,weight);
+    }
 
     // proton cuts
     if ((vzp-vze)<-3. || (vzp-vze)>4.) {continue;}
@@ -355,25 +355,34 @@ int main(int argc, char ** argv)
     double thetamiss = pmiss.Theta()*180./M_PI;
 
     // cut on theta component of pmiss
-    h_thetamiss_before->Fill(thetamiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_thetamiss_before->Fill(thetamiss,weight);
+    }
     if (thetamiss<40.) {continue;}
     if (thetamiss>140.) {continue;}
 
     // xb dependence
-    h_mmiss_xb->Fill(xB,mmiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_xb->Fill(xB,mmiss,weight);
+    }
     //if (xB<0.7) {continue;}
 
     if (pmiss.Mag() < 0.243) {continue;} // beta = 0.2, p = 0.1918, beta = 0.25, p = 0.243 // was 0.243
     if (pmiss.Mag() > 1.25) {continue;} // beta = 0.8, p = 1.2533
 
 
-    h_theta_ppmiss->Fill(pmiss.Angle(pp)*180./M_PI,weight);
-    //if ((pmiss.Angle(pp)*180./M_PI)<40.) {continue;}  // CD ONLY (I THINK)
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_theta_ppmiss->Fill(pmiss.Angle(pp)*180./M_PI,weight);
+      //if ((pmiss.Angle(pp)*180./M_PI)<40.) {continue;}  // CD ONLY (I THINK)
     
-    h_mmiss_pmiss->Fill(pmiss.Mag(),mmiss,weight);
-    h_mmiss_pmissCAND->Fill(pmiss.Mag(),mmiss,weight);
-    h_mmiss_theta->Fill(thetamiss,mmiss,weight);
-    h_mmiss_thetaCAND->Fill(thetamiss,mmiss,weight);
+      h_mmiss_pmiss->Fill(pmiss.Mag(),mmiss,weight);
+      h_mmiss_pmissCAND->Fill(pmiss.Mag(),mmiss,weight);
+      h_mmiss_theta->Fill(thetamiss,mmiss,weight);
+      h_mmiss_thetaCAND->Fill(thetamiss,mmiss,weight);
+    }
 
     for (int i=0; i<neff_pbins; i++){
       if (mmiss>Mlow && mmiss<Mhigh) { h_neff_pmiss_denom_ssb->Fill(pmiss.Mag(),weight);}  }
@@ -387,7 +396,10 @@ int main(int argc, char ** argv)
 
     // NEUTRONS
     double sz = neut.size();
-    h_nsize->Fill(sz,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_nsize->Fill(sz,weight);
+    }
 
 
     int pick = -1;
@@ -474,15 +486,18 @@ int main(int argc, char ** argv)
 
 
     // fill histos with good neutrons
-    h_tof->Fill(tof_n,weight);
-    h_nangles->Fill(n_phi,n_theta,weight);
-    h_dphi->Fill(dphi,weight);
-    h_pmiss_pn->Fill(pn.Mag(),pmiss.Mag(),weight);
-    h_dtheta_dphi->Fill(dphi,pmiss.Theta()*180./M_PI - neut[pick]->getTheta()*180./M_PI,weight);
-    h_theta_edep->Fill(neut[pick]->getTheta()*180./M_PI,edep,weight);
-    //h_mmiss_beta_after->Fill(beta_n,mmiss,weight);
-    //h_beta_pmiss->Fill(pmiss.Mag(),beta_n,weight);
-    h_cos0->Fill(cos0,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_tof->Fill(tof_n,weight);
+      h_nangles->Fill(n_phi,n_theta,weight);
+      h_dphi->Fill(dphi,weight);
+      h_pmiss_pn->Fill(pn.Mag(),pmiss.Mag(),weight);
+      h_dtheta_dphi->Fill(dphi,pmiss.Theta()*180./M_PI - neut[pick]->getTheta()*180./M_PI,weight);
+      h_theta_edep->Fill(neut[pick]->getTheta()*180./M_PI,edep,weight);
+      //h_mmiss_beta_after->Fill(beta_n,mmiss,weight);
+      //h_beta_pmiss->Fill(pmiss.Mag(),beta_n,weight);
+      h_cos0->Fill(cos0,weight);
+    }
 
 
 
@@ -490,31 +505,40 @@ int main(int argc, char ** argv)
     if (cos0 < 0.9) {continue;}
 
     // after requiring pn along pmiss
-    h_pmiss_pn_cut->Fill(pn.Mag(),pmiss.Mag(),weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pmiss_pn_cut->Fill(pn.Mag(),pmiss.Mag(),weight);
 
-    if (mmiss>1.15) {h_pmiss_pn_bkg->Fill(pn.Mag(),pmiss.Mag(),weight);}
-    if (mmiss<1.05) {h_pmiss_pn_sig->Fill(pn.Mag(),pmiss.Mag(),weight);}
-    if (mmiss>1.15) {h_dp_p_bkg->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
-    if (mmiss<1.05) {h_dp_p_sig->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
+      if (mmiss>1.15) {h_pmiss_pn_bkg->Fill(pn.Mag(),pmiss.Mag(),weight);}
+      if (mmiss<1.05) {h_pmiss_pn_sig->Fill(pn.Mag(),pmiss.Mag(),weight);}
+      if (mmiss>1.15) {h_dp_p_bkg->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
+      if (mmiss<1.05) {h_dp_p_sig->Fill(pmiss.Mag(),pmiss.Mag()-pn.Mag(),weight);}
 
-    h_pmiss_theta->Fill(neut[pick]->getTheta()*180./M_PI,pmiss.Mag(),weight);
+      h_pmiss_theta->Fill(neut[pick]->getTheta()*180./M_PI,pmiss.Mag(),weight);
+    }
 
     if (std::abs(pmiss.Mag()-pn.Mag())>0.2) {continue;}
 
-    h_mmiss_withn->Fill(mmiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_withn->Fill(mmiss,weight);
+    }
 
 
     // cut out fake neutron background
     double theta_np = pn.Angle(pp)*180./M_PI;
-    h_theta_np->Fill(theta_np,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_theta_np->Fill(theta_np,weight);
 
-    h_pmiss_pn_cutbkg->Fill(pn.Mag(),pmiss.Mag(),weight); // CTOF p only
-    h_pmiss_theta_cutbkg->Fill(n_theta,pmiss.Mag(),weight);
+      h_pmiss_pn_cutbkg->Fill(pn.Mag(),pmiss.Mag(),weight); // CTOF p only
+      h_pmiss_theta_cutbkg->Fill(n_theta,pmiss.Mag(),weight);
 
     
 
-    h_mmiss_pmissDET->Fill(pmiss.Mag(),mmiss,weight);
-    h_mmiss_thetaDET->Fill(thetamiss,mmiss,weight);
+      h_mmiss_pmissDET->Fill(pmiss.Mag(),mmiss,weight);
+      h_mmiss_thetaDET->Fill(thetamiss,mmiss,weight);
+    }
 
 
     for (int i=0; i<neff_pbins; i++){
@@ -529,6 +553,7 @@ int main(int argc, char ** argv)
 
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -1119,6 +1144,7 @@ int main(int argc, char ** argv)
   myCanvas->Print(fileName,"pdf");
 
   outFile->Close();
+  stats.summary();
 }
 
 
@@ -20,6 +20,7 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
 #include "eventcut.h"
 #include "functions.h"
 
@@ -100,9 +101,11 @@ int main(int argc, char ** argv)
 
   myCut.print_cuts();
   clas12root::HipoChain chain;
+  clas12jobstats stats("neff_h_epin");
   for(int k = 6; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -288,16 +291,10 @@ int main(int argc, char ** argv)
 
 
   //Define cut class
-  while(chain.Next()==true){
+  while(stats.next(chain)){
     //Display completed  
     counter++;
-    if((counter%1000000) == 0){
-      cerr << "\n" <<counter/1000000 <<" million completed";
-    }    
-
-    if((counter%100000) == 0){
-      cerr << ".";
-    }    
+    auto analysis_timer = stats.time(jobStage::Analysis);
 
     // get particles by type
     auto elec=c12->getByID(11);
@@ -314,7 +311,7 @@ int main(int argc, char ** argv)
 
 
     // GENERAL EVENT SELECTION
-    if(!myCut.electroncut(c12)){continue;}
+    if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})){continue;}
     if (prot.size() != 0) {continue;} // before p>0 // hen !=0
     if (pip.size() != 1) {continue;} 
     if (elec.size() != 1) {continue;} // before e>1 // then !=1
@@ -340,16 +337,22 @@ int main(int argc, char ** argv)
     for (int i=0; i<allParticles.size(); i++)
       {
       int pid = allParticles[i]->par()->getPid();
-      h_pid->Fill(pid);
+      {
+	auto fill_timer = stats.time(jobStage::Fill);
+	h_pid->Fill(pid);
+      }
       if (pid!=2112 && pid!=11 && pid!=211 && pid!=22 && pid!=0) {trash=1;}
       //if (pid!=2112 && pid!=11 && pid!=211) {trash=1;} // TEMP
       }
     if (trash==1) {continue;}
 
     // pion histos
-    h_pivertex->Fill(vzpi-vze,weight);
-    h_dbetap->Fill(p_pip.Mag(),dbeta,weight);
-    h_pitheta->Fill(pitheta,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_pivertex->Fill(vzpi-vze,weight);
+      h_dbetap->Fill(p_pip.Mag(),dbeta,weight);
+      h_pitheta->Fill(pitheta,weight);
+    }
 
 
     // pion cuts
@@ -368,7 +371,10 @@ int main(int argc, char ** argv)
     double thetamiss = pmiss.Theta()*180/M_PI;
 
     // thetamiss histo
-    h_thetamiss->Fill(thetamiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_thetamiss->Fill(thetamiss,weight);
+    }
 
     // missing momentum cuts
     if (thetamiss<40.) {continue;}
@@ -376,15 +382,22 @@ int main(int argc, char ** argv)
     if (pmiss.Mag() < 0.2) {continue;} // beta=0.2  // previously 0.1918
     if (pmiss.Mag() > 1.2) {continue;} // beta=0.8  // previoulsy 1.2528
 
-    h_mmiss_theta_denom->Fill(thetamiss,mmiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_theta_denom->Fill(thetamiss,mmiss,weight);
+    }
 
 
 
 
-   h_mmiss_cand->Fill(mmiss,weight);   
+   {
+     auto fill_timer = stats.time(jobStage::Fill);
+     h_mmiss_cand->Fill(mmiss,weight);   
+   }
 
     if (mmiss>0.85 && mmiss<1.05)
     {
+      auto fill_timer = stats.time(jobStage::Fill);
       h_neff_thetamiss_denom->Fill(thetamiss,weight);
       h_neff_phimiss_denom->Fill(pmiss.Phi()*180/M_PI);
       h_neff_pmiss_denom->Fill(pmiss.Mag(),weight);
@@ -396,10 +409,13 @@ int main(int argc, char ** argv)
     }
 
 
-    h_mmiss_pmiss_allt_denom->Fill(pmiss.Mag(),mmiss,weight);
-    if (thetamiss>t1 && thetamiss<t2) {h_mmiss_pmiss_int1_denom->Fill(pmiss.Mag(),mmiss,weight);}
-    else if (thetamiss>t2 && thetamiss<t3) {h_mmiss_pmiss_int2_denom->Fill(pmiss.Mag(),mmiss,weight);}
-    else if (thetamiss>t3 && thetamiss<t4) {h_mmiss_pmiss_int3_denom->Fill(pmiss.Mag(),mmiss,weight);}
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_pmiss_allt_denom->Fill(pmiss.Mag(),mmiss,weight);
+      if (thetamiss>t1 && thetamiss<t2) {h_mmiss_pmiss_int1_denom->Fill(pmiss.Mag(),mmiss,weight);}
+      else if (thetamiss>t2 && thetamiss<t3) {h_mmiss_pmiss_int2_denom->Fill(pmiss.Mag(),mmiss,weight);}
+      else if (thetamiss>t3 && thetamiss<t4) {h_mmiss_pmiss_int3_denom->Fill(pmiss.Mag(),mmiss,weight);}
+    }
 
 
 
@@ -408,7 +424,10 @@ int main(int argc, char ** argv)
 
     // NEUTRON NUMBER
     double sz = neut.size();
-    h_nsize->Fill(sz);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_nsize->Fill(sz);
+    }
 
 
     int pick = -1;
@@ -486,15 +505,18 @@ int main(int argc, char ** argv)
     double dphi = pmiss.Phi()*180./M_PI - neut[pick]->getPhi()*180./M_PI;
 
     // neutron histos
-    h_tof->Fill(tof_n,weight);
-    h_nangles->Fill(n_phi,n_theta,weight);
-    h_mmiss_beta->Fill(beta_n,mmiss,weight);
-
-    // more neutron histos
-    h_pmiss_pn->Fill(pn.Mag(),pmiss.Mag(),weight);
-    h_beta_pmiss->Fill(pmiss.Mag(),beta_n,weight);
-    h_cos0->Fill(cos0,weight);
-    h_dphi->Fill(dphi,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_tof->Fill(tof_n,weight);
+      h_nangles->Fill(n_phi,n_theta,weight);
+      h_mmiss_beta->Fill(beta_n,mmiss,weight);
+
+      // more neutron histos
+      h_pmiss_pn->Fill(pn.Mag(),pmiss.Mag(),weight);
+      h_beta_pmiss->Fill(pmiss.Mag(),beta_n,weight);
+      h_cos0->Fill(cos0,weight);
+      h_dphi->Fill(dphi,weight);
+    }
 
     // exclusive cuts (requiring info from other final state particles)
     if (cos0 < 0.9) {continue;}
@@ -504,17 +526,21 @@ int main(int argc, char ** argv)
     // histos after requiring pn along pmiss
     
 
-    h_mmiss_theta_numer->Fill(thetamiss,mmiss,weight);
+    {
+      auto fill_timer = stats.time(jobStage::Fill);
+      h_mmiss_theta_numer->Fill(thetamiss,mmiss,weight);
 
 
-    h_p_theta->Fill(n_theta,pn.Mag(),weight);
-    h_p_phi->Fill(n_phi,pn.Mag(),weight);
-    //h_pmiss_theta->Fill(neut[pick]->getTheta()*180./M_PI,pmiss.Mag(),weight);
-    h_pmiss_thetamiss->Fill(thetamiss,pmiss.Mag(),weight);
-    h_pmiss_pn_cut->Fill(pn.Mag(),pmiss.Mag(),weight);
-    h_mmiss_withn->Fill(mmiss,weight);
+      h_p_theta->Fill(n_theta,pn.Mag(),weight);
+      h_p_phi->Fill(n_phi,pn.Mag(),weight);
+      //h_pmiss_theta->Fill(neut[pick]->getTheta()*180./M_PI,pmiss.Mag(),weight);
+      h_pmiss_thetamiss->Fill(thetamiss,pmiss.Mag(),weight);
+      h_pmiss_pn_cut->Fill(pn.Mag(),pmiss.Mag(),weight);
+      h_mmiss_withn->Fill(mmiss,weight);
+    }
     if (mmiss>0.85 && mmiss<1.05)
     {
+      auto fill_timer = stats.time(jobStage::Fill);
       h_neff_thetamiss_numer->Fill(thetamiss,weight);
       h_neff_phimiss_numer->Fill(pmiss.Phi()*180/M_PI);
       h_neff_pmiss_numer->Fill(pmiss.Mag(),weight);
@@ -526,6 +552,7 @@ int main(int argc, char ** argv)
     }
 
 
+    auto fill_timer = stats.time(jobStage::Fill);
     h_mmiss_pmiss_allt_numer->Fill(pmiss.Mag(),mmiss,weight);
     if (thetamiss>t1 && thetamiss<t2) {h_mmiss_pmiss_int1_numer->Fill(pmiss.Mag(),mmiss,weight);}
     else if (thetamiss>t2 && thetamiss<t3) {h_mmiss_pmiss_int2_numer->Fill(pmiss.Mag(),mmiss,weight);}
@@ -538,6 +565,7 @@ int main(int argc, char ** argv)
 
   cout<<counter<<endl;
 
+  auto write_timer = stats.time(jobStage::Write);
   outFile->cd();
   for(int i=0; i<hist_list_1.size(); i++){
     hist_list_1[i]->Write();
@@ -1262,6 +1290,7 @@ std::cout << "The neutron efficiency is " << h_mmiss_withn->Integral(0,200)/h_mm
   myCanvas->Print(fileName,"pdf");
 
   outFile->Close();
+  stats.summary();
 }
 
 
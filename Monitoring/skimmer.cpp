@@ -6,6 +6,8 @@
 #include <chrono>
 #include <vector>
 #include <typeinfo>
+#include <memory>
+#include <sstream>
 
 #include <TFile.h>
 #include <TTree.h>
@@ -20,6 +22,8 @@
 #include "clas12reader.h"
 #include "clas12writer.h"
 #include "HipoChain.h"
+#include "clas12jobstats.h"
+#include "clas12skimindex.h"
 #include "eventcut/eventcut.h"
 //#include "functions.h"
 
@@ -29,8 +33,33 @@ using namespace clas12;
 void Usage()
 {
   std::cerr << "Usage: ./code <Ebeam(GeV)> <path/to/cutfile.txt> <path/to/output.hipo> <path/to/input.hipo> \n";
+  std::cerr << "Several skims in one pass: comma separated cut files and outputs, e.g.\n"
+	    << "       ./code 5.98 ep.txt,epp.txt ep.hipo,epp.hipo <path/to/input.hipo> \n"
+	    << "An output ending in .idx is an index of the selected events instead of a copy.\n";
 }
 
+std::vector<std::string> splitList(const char *list)
+{
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while(getline(ss,item,','))
+    if(!item.empty())
+      items.push_back(item);
+  return items;
+}
+
+//one selection of the skim, with its own writer
+struct skimOutput
+{
+  std::string cutFile;
+  std::string outName;
+  std::unique_ptr<eventcut> cut;
+  std::unique_ptr<clas12writer> writer;
+  std::unique_ptr<skimIndexWriter> index;
+  int count = 0;
+};
+
 
 int main(int argc, char ** argv)
 {
@@ -43,20 +72,47 @@ int main(int argc, char ** argv)
     }
 
   /////////////////////////////////////
-  //Set cut object with Ebeam and cutfile
-  eventcut myCut(atof(argv[1]),argv[2]);
-  myCut.print_cuts();
+  //Set a cut object with Ebeam and cutfile
+  //and a c12writer for the output hipo file of every selection
+  std::vector<std::string> cutFiles = splitList(argv[2]);
+  std::vector<std::string> outNames = splitList(argv[3]);
+  if(cutFiles.empty() || cutFiles.size() != outNames.size())
+    {
+      std::cerr<<"Give one output file for each cut file.\n";
+      Usage();
+      return -1;
+    }
 
-  //make c12writer for the output hipo file
-  char * outName = argv[3];
-  cout<<"Ouput file "<< outName <<endl;
-  clas12writer c12writer(outName);
+  std::vector<skimOutput> skims(cutFiles.size());
+  for(size_t i = 0; i < skims.size(); i++){
+    skims[i].cutFile = cutFiles[i];
+    skims[i].outName = outNames[i];
+    skims[i].cut.reset(new eventcut(atof(argv[1]),&skims[i].cutFile[0]));
+    skims[i].cut->print_cuts();
+    cout<<"Ouput file "<< skims[i].outName <<endl;
+    const std::string &out = skims[i].outName;
+    if(out.size() > 4 && out.compare(out.size()-4,4,".idx") == 0){
+      skims[i].index.reset(new skimIndexWriter(out,{0}));
+      if(!skims[i].index->isOpen()){ return -1; }
+      //no event filters and the QADB is off, the events read are the positions
+      skims[i].index->setFiltered(false);
+    }
+    else{
+      skims[i].writer.reset(new clas12writer(out.c_str()));
+    }
+    //the candidates are read once per event for all selections with the same PIDs,
+    //by the first of them, whose electroncut is called first in the loop below
+    for(size_t j = 0; j < i; j++)
+      if(skims[i].cut->shareSnapshot(*skims[j].cut)){ break; }
+  }
 
   //make hipochain that contains input files
   clas12root::HipoChain chain;
+  clas12jobstats stats("skimmer");
   for(int k = 4; k < argc; k++){
     cout<<"Input file "<<argv[k]<<endl;
     chain.Add(argv[k]);
+    stats.addInputFile(argv[k]);
   }
   auto config_c12=chain.GetC12Reader();
   chain.SetReaderTags({0});
@@ -71,7 +127,7 @@ int main(int argc, char ** argv)
   const std::unique_ptr<clas12::clas12reader>& c12=chain.C12ref();
   chain.db()->turnOffQADB();
   int counter = 0;
-  int cutcounter = 0;
+  long file_entry = 0; //events read in the current file, for the index outputs
 
 
 
@@ -158,23 +214,22 @@ auto scint_layermult = config_c12->getBankOrder(scintextras,"layermult");*/
 
   
 
-  while(chain.Next()==true){
+  while(stats.next(chain)){
 
-      //Display completed  
       counter++;
-      if((counter%1000000) == 0){
-	cout << "\n" <<counter/1000000 <<" million completed";
-      }    
-      if((counter%100000) == 0){
-	cout << ".";
-      }    
 
       //if multiple files in chain
       //we need to update when file changes
       if(currc12!=c12.get()){
 	currc12=c12.get();
-	//assign a reader to the writer
-	c12writer.assignReader(*currc12);
+	file_entry = 0;
+	//assign a reader to the writers
+	for(auto &skim : skims)
+	  if(skim.writer)
+	    skim.writer->assignReader(*currc12);
+      }
+      else{
+	file_entry++;
       }
 
   /////////////////////////////////////
@@ -182,19 +237,40 @@ auto scint_layermult = config_c12->getBankOrder(scintextras,"layermult");*/
   //Lead Proton Checks
   //Lead SRC Proton Checks
   //Recoil Proton Checks
+  //for every selection, the event is read and decoded once for all
+  //and the candidates once for the selections with the same PIDs
   /////////////////////////////////////      
-      if(!myCut.electroncut(c12)){continue;}      
-      int index_L = myCut.leadnucleoncut(c12);
-      if(index_L < 0){ continue; }
-      if(!myCut.leadSRCnucleoncut(c12,index_L)){continue;}      
-      int index_R = myCut.recoilSRCnucleoncut(c12,index_L);
-      if(index_R < 0){ continue; }
-      
-      cutcounter++;
-      c12writer.writeEvent(); 
+      for(auto &skim : skims){
+	eventcut &myCut = *skim.cut;
+	{
+	  auto selection_timer = stats.time(jobStage::Selection);
+	  if(!myCut.electroncut(c12)){continue;}      
+	  int index_L = myCut.leadnucleoncut(c12);
+	  if(index_L < 0){ continue; }
+	  if(!myCut.leadSRCnucleoncut(c12,index_L)){continue;}      
+	  int index_R = myCut.recoilSRCnucleoncut(c12,index_L);
+	  if(index_R < 0){ continue; }
+	}
+
+	skim.count++;
+	auto write_timer = stats.time(jobStage::Write);
+	if(skim.index)
+	  skim.index->add(*c12,file_entry);
+	else
+	  skim.writer->writeEvent(); 
+      }
   }
 
-  c12writer.closeWriter();
-  cout<<cutcounter<<" events written to:\n" << outName <<endl;
+  for(auto &skim : skims){
+    {
+      auto write_timer = stats.time(jobStage::Write);
+      if(skim.index)
+	skim.index->close();
+      else
+	skim.writer->closeWriter();
+    }
+    cout<<skim.count<<" events written to:\n" << skim.outName <<endl;
+  }
+  stats.summary();
 }
 
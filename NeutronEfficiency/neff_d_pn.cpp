@@ -409,10 +409,10 @@ int main(int argc, char ** argv)
 
     // get particles by type
     clasAna.Run(c12);
-    auto elec = clasAna.getByPid(11);
-    auto prot = clasAna.getByPid(2212);
-    auto neut = clasAna.getByPid(2112);
-    auto phot = clasAna.getByPid(22);
+    auto &elec = clasAna.getByPidView(11);
+    auto &prot = clasAna.getByPidView(2212);
+    auto &neut = clasAna.getByPidView(2112);
+    auto &phot = clasAna.getByPidView(22);
     auto allParticles=c12->getDetParticles();
     double weight = 1;
     if(isMC){weight=c12->mcevent()->getWeight();}
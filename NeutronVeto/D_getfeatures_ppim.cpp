@@ -464,7 +464,7 @@ int numevent = 0;
       if (status!=0) {continue;}
 
       // GET ML FEATURES FOR THIS NEUTRON
-      Struct ninfo = getFeatures(neut, allParticles, i);
+      Struct ninfo = getFeatures(neut, allParticles, i, clasAna->getTrajCache());
       cnd_hits = ninfo.cnd_hits;
       ctof_hits = ninfo.ctof_hits;
       cnd_energy = ninfo.cnd_energy;
@@ -325,7 +325,7 @@ if (beta>1) {continue;}
 
 
     // function for CND & CTOF nearby hits and energy
-    Struct ninfo = getFeatures(nucl, allParticles, i);
+    Struct ninfo = getFeatures(nucl, allParticles, i, clasAna.getTrajCache());
     cnd_hits = ninfo.cnd_hits;
     ctof_hits = ninfo.ctof_hits;
     cnd_energy = ninfo.cnd_energy;
@@ -0,0 +1,111 @@
+#ifndef BENCH_HH
+#define BENCH_HH
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <atomic>
+#include <cstdio>
+
+//#############
+//Minimal timing harness for the library benchmarks
+//Every sample is one event (or one synthetic input for the pure functions). The time of a
+//sample is taken with steady_clock, minus the measured cost of an empty sample. Heap
+//allocations are counted by the operator new defined in bench_alloc.cpp.
+//#############
+
+extern std::atomic<long> bench_allocs;
+
+struct benchEntry
+{
+  std::string name;
+  long events = 0;
+  double ns = 0;
+  long allocs = 0;
+};
+
+class benchSuite
+{
+
+ public:
+  benchSuite()
+    {
+      //duration measured for an empty sample, subtracted from every sample
+      const int n = 100000;
+      double total = 0;
+      for(int i = 0; i < n; i++)
+	{
+	  auto a = std::chrono::steady_clock::now();
+	  auto b = std::chrono::steady_clock::now();
+	  total += std::chrono::duration<double,std::nano>(b - a).count();
+	}
+      overhead = total/n;
+    };
+
+  //entries are kept in the order they are first used, references stay valid as entries are added
+  benchEntry& entry(const std::string &name)
+  {
+    for(auto &e : entries)
+      if(e.name == name)
+	return e;
+    entries.push_back(benchEntry());
+    entries.back().name = name;
+    return entries.back();
+  };
+
+  //one sample of f, which should store its result in sink
+  template<class F>
+    void time(benchEntry &e, F &&f)
+  {
+    long a0 = bench_allocs.load(std::memory_order_relaxed);
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    e.allocs += bench_allocs.load(std::memory_order_relaxed) - a0;
+    e.ns += std::chrono::duration<double,std::nano>(t1 - t0).count() - overhead;
+    e.events++;
+  };
+
+  void print() const
+  {
+    printf("%-40s %12s %14s %16s\n","benchmark","events","ns/event","allocs/event");
+    for(auto &e : entries)
+      printf("%-40s %12ld %14.1f %16.2f\n",e.name.c_str(),e.events,perEvent(e.ns,e),perEvent(e.allocs,e));
+  };
+
+  //one object per benchmark, compare files of two commits entry by entry
+  bool writeJSON(const std::string &filename, const std::string &commit, const std::string &build, const std::string &input) const
+  {
+    std::ofstream out(filename);
+    if(!out.is_open())
+      return false;
+
+    out << "{\n  \"commit\": \"" << commit << "\",\n  \"build\": \"" << build << "\",\n  \"input\": \"" << input << "\",\n"
+	<< "  \"timer_overhead_ns\": " << overhead << ",\n  \"benchmarks\": [\n";
+    for(size_t i = 0; i < entries.size(); i++)
+      {
+	const benchEntry &e = entries[i];
+	out << "    {\"name\": \"" << e.name << "\", \"events\": " << e.events
+	    << ", \"ns_per_event\": " << perEvent(e.ns,e)
+	    << ", \"allocs_per_event\": " << perEvent(e.allocs,e) << "}"
+	    << (i + 1 < entries.size() ? ",\n" : "\n");
+      }
+    out << "  ]\n}\n";
+    return out.good();
+  };
+
+  //results are added here so the compiler keeps the benchmarked calls
+  volatile double sink = 0;
+
+ private:
+
+  static double perEvent(double x, const benchEntry &e) {return e.events > 0 ? x/e.events : 0;};
+
+  double overhead = 0;
+  std::deque<benchEntry> entries;
+};
+
+#endif
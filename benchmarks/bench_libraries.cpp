@@ -0,0 +1,216 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <TRandom3.h>
+#include <TVector3.h>
+#include "HipoChain.h"
+#include "clas12ana.h"
+#include "eventcut/eventcut.h"
+#include "neutron-veto/veto_functions.h"
+#include "reweighter.h"
+#include "gcfSRC.hh"
+#include "eNCrossSection.hh"
+#include "clas12synth.h"
+#include "bench.h"
+
+using namespace std;
+using namespace clas12;
+
+#ifndef BENCH_COMMIT
+#define BENCH_COMMIT "unknown"
+#endif
+#ifndef BENCH_BUILD
+#define BENCH_BUILD "unknown"
+#endif
+
+void Usage()
+{
+  std::cerr << "Usage: ./benchmarks [-o out.json] [-n max events] [-s samples] [-c cutfile] [-E beam energy] [-Z Z -N N] [-g synthetic events] [inputfile_1 ...]\n"
+	    << "Without input files (or -g) only the functions taking plain numbers (gcfSRC, eNCrossSection) are run.\n\n";
+}
+
+int main(int argc, char ** argv)
+{
+  std::string outFile = "benchmarks.json";
+  std::string cutFile = std::string(_CLAS12ANA_DIR) + "/Monitoring/example_cut_file.txt";
+  long maxEvents = 10000;
+  int samples = 100000;
+  double Ebeam = 5.98;
+  int Z = 6, N = 6;
+  long synthEvents = 0;
+  std::vector<std::string> inFiles;
+
+  for(int i = 1; i < argc; i++)
+    {
+      std::string arg = argv[i];
+      bool has_value = (i + 1 < argc);
+      if(arg == "-h")
+	{
+	  Usage();
+	  return 0;
+	}
+      else if(arg == "-o" && has_value)
+	outFile = argv[++i];
+      else if(arg == "-n" && has_value)
+	maxEvents = atol(argv[++i]);
+      else if(arg == "-s" && has_value)
+	samples = atoi(argv[++i]);
+      else if(arg == "-c" && has_value)
+	cutFile = argv[++i];
+      else if(arg == "-E" && has_value)
+	Ebeam = atof(argv[++i]);
+      else if(arg == "-Z" && has_value)
+	Z = atoi(argv[++i]);
+      else if(arg == "-N" && has_value)
+	N = atoi(argv[++i]);
+      else if(arg == "-g" && has_value)
+	synthEvents = atol(argv[++i]);
+      else if(arg[0] == '-')
+	{
+	  Usage();
+	  return -1;
+	}
+      else
+	inFiles.push_back(arg);
+    }
+
+  //synthetic events instead of data, the file is removed at exit
+  synthConfig synth_config;
+  synth_config.beam_energy = Ebeam;
+  clas12synth synth(synth_config);
+  std::string synthFile;
+  if(synthEvents > 0)
+    {
+      synthFile = synth.writeTemp(synthEvents);
+      if(synthFile.empty())
+	return -1;
+      inFiles.push_back(synthFile);
+    }
+
+  benchSuite bench;
+
+  /////////////////////////////////////
+  //Functions of plain numbers, synthetic inputs
+  /////////////////////////////////////
+  TRandom3 rand(12345);
+  gcfSRC gcf(Z,N,AV18);
+  eNCrossSection cs(cc1,kelly);
+
+  struct csInput
+  {
+    TVector3 k;
+    TVector3 p;
+    bool isProton;
+  };
+  std::vector<double> krel(samples);
+  std::vector<int> lead_type(samples),rec_type(samples);
+  std::vector<csInput> cs_inputs(samples);
+  for(int i = 0; i < samples; i++)
+    {
+      krel[i] = rand.Uniform(0.25,1.0);
+      lead_type[i] = rand.Rndm() < 0.5 ? pCode : nCode;
+      rec_type[i] = rand.Rndm() < 0.5 ? pCode : nCode;
+
+      //electron at 8-40 degrees, nucleon of 0.3-3 GeV/c
+      cs_inputs[i].k.SetMagThetaPhi(rand.Uniform(1,Ebeam - 0.5),rand.Uniform(8,40)*M_PI/180,rand.Uniform(-M_PI,M_PI));
+      cs_inputs[i].p.SetMagThetaPhi(rand.Uniform(0.3,3),rand.Uniform(10,120)*M_PI/180,rand.Uniform(-M_PI,M_PI));
+      cs_inputs[i].isProton = rand.Rndm() < 0.5;
+    }
+
+  auto &b_gets = bench.entry("gcfSRC::get_S");
+  for(int i = 0; i < samples; i++)
+    bench.time(b_gets,[&]{bench.sink += gcf.get_S(krel[i],lead_type[i],rec_type[i]);});
+
+  auto &b_sigma = bench.entry("eNCrossSection::sigma_eN");
+  for(int i = 0; i < samples; i++)
+    bench.time(b_sigma,[&]{bench.sink += cs.sigma_eN(Ebeam,cs_inputs[i].k,cs_inputs[i].p,cs_inputs[i].isProton);});
+
+  /////////////////////////////////////
+  //Functions of the event, read from the input files
+  /////////////////////////////////////
+  std::string input;
+  if(!inFiles.empty())
+    {
+      clas12root::HipoChain chain;
+      for(auto &file : inFiles)
+	{
+	  cout << "Input file " << file << endl;
+	  chain.Add(file.c_str());
+	  input += (input.empty() ? "" : " ") + (file == synthFile ? "synthetic:" + std::to_string(synthEvents) : file);
+	}
+      chain.SetReaderTags({0});
+      chain.db()->turnOffQADB();
+      auto &c12 = chain.C12ref();
+
+      clas12ana clasAna;
+      eventcut myCut(Ebeam,const_cast<char*>(cutFile.c_str()));
+      reweighter newWeight(Ebeam,Z,N);
+
+      //entries in the order they are printed
+      auto &b_run = bench.entry("clas12ana::Run");
+      auto &b_ecut = bench.entry("eventcut::electroncut");
+      auto &b_lcut = bench.entry("eventcut::leadnucleoncut");
+      auto &b_lsrc = bench.entry("eventcut::leadSRCnucleoncut");
+      auto &b_rsrc = bench.entry("eventcut::recoilSRCnucleoncut");
+      auto &b_feat = bench.entry("getFeatures (all neutrons)");
+      auto &b_cvt = bench.entry("getCVTdiff (all neutrons)");
+      auto &b_wep = bench.entry("reweighter::get_weight_ep");
+      auto &b_wepp = bench.entry("reweighter::get_weight_epp");
+
+      //the veto features get their own traj cache, cleared before each family, so that they
+      //are not timed on the lookups of Run's edge cuts or of the other family
+      clas12trajcache traj_cache;
+
+      long nevents = 0;
+      while(nevents < maxEvents && chain.Next())
+	{
+	  nevents++;
+	  bench.time(b_run,[&]{clasAna.Run(c12);});
+
+	  //every family is timed on every event, independently of the previous ones
+	  int index_L = -1;
+	  bench.time(b_ecut,[&]{bench.sink += myCut.electroncut(c12);});
+	  bench.time(b_lcut,[&]{index_L = myCut.leadnucleoncut(c12);});
+	  if(index_L >= 0)
+	    {
+	      bench.time(b_lsrc,[&]{bench.sink += myCut.leadSRCnucleoncut(c12,index_L);});
+	      bench.time(b_rsrc,[&]{bench.sink += myCut.recoilSRCnucleoncut(c12,index_L);});
+	    }
+
+	  auto neutrons = clasAna.getByPid(2112);
+	  if(!neutrons.empty())
+	    {
+	      auto allParticles = c12->getDetParticles();
+	      traj_cache.Clear();
+	      bench.time(b_feat,[&]{
+		  for(size_t i = 0; i < neutrons.size(); i++)
+		    bench.sink += getFeatures(neutrons,allParticles,i,traj_cache).energy;
+		});
+	      traj_cache.Clear();
+	      bench.time(b_cvt,[&]{
+		  for(size_t i = 0; i < neutrons.size(); i++)
+		    bench.sink += getCVTdiff(neutrons,allParticles,i,traj_cache);
+		});
+	    }
+
+	  //lead and recoil nucleon are rows 1 and 2 of MC::Lund
+	  if(c12->mcparts()->getRows() >= 3)
+	    {
+	      bench.time(b_wep,[&]{bench.sink += newWeight.get_weight_ep(c12->mcparts());});
+	      bench.time(b_wepp,[&]{bench.sink += newWeight.get_weight_epp(c12->mcparts());});
+	    }
+	}
+    }
+
+  bench.print();
+  if(!bench.writeJSON(outFile,BENCH_COMMIT,BENCH_BUILD,input))
+    {
+      std::cerr << "WARNING:: Could not write " << outFile << std::endl;
+      return -1;
+    }
+  cout << "Results written to " << outFile << endl;
+
+  return 0;
+}
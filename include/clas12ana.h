@@ -15,9 +15,22 @@
  #include "TFile.h"
  #include "TCanvas.h"
  #include <sstream>
+ #include <memory>
+ #include <algorithm>
  #include "clas12debug.h"
+ #include "clas12cutfunctions.h"
+ #include "clas12trajcache.h"
+ #include "clas12srckin.h"
+ #include "clas12cutflow.h"
+ #include "clas12elkernel.h"
 
  #define CLAS12ANA_DIR _CLAS12ANA_DIR
+ //parameter snapshot, written to the build tree by the par_snapshot target
+ #ifdef _CLAS12ANA_SNAPSHOT
+ #define CLAS12ANA_SNAPSHOT _CLAS12ANA_SNAPSHOT
+ #else
+ #define CLAS12ANA_SNAPSHOT _CLAS12ANA_DIR "/Ana/cutFiles/cutFiles.snapshot"
+ #endif
 
  using namespace std;
  using namespace clas12;
@@ -26,6 +39,88 @@
  //Analysis suite for CLAS12 analysis
  //#############
 
+ //identifiers of the cuts cached per particle by clas12ana::Run
+ enum class CutId : unsigned int
+ {
+   Nphe,       //HTCC photo electron min cut
+   EcalSF,     //ECAL SF vs energy cuts
+   EcalP,      //ECAL SF vs momentum cuts
+   EcalDiag,   //ECAL diagonal SF cut
+   EcalEdge,   //PCAL edge cuts
+   ElMom,      //minimum electron momentum
+   Pid,        //chi2pid cuts
+   ProtonPid,  //CD proton TOF vs momentum cut
+   Vertex,     //vertex cuts
+   DCEdge,     //DC edge cuts
+   CDEdge,     //CD edge cuts
+   CDRegion,   //CD region cut
+   VertexCorr, //electron <-> particle vertex correlation
+   GhostTrack, //not a ghost track
+   NCuts
+ };
+
+ static_assert(electronBlock::cut_nphe == static_cast<int>(CutId::Nphe) && electronBlock::cut_sf == static_cast<int>(CutId::EcalSF) &&
+	       electronBlock::cut_p == static_cast<int>(CutId::EcalP) && electronBlock::cut_diag == static_cast<int>(CutId::EcalDiag) &&
+	       electronBlock::cut_edge == static_cast<int>(CutId::EcalEdge) && electronBlock::cut_mom == static_cast<int>(CutId::ElMom) &&
+	       electronBlock::cut_vertex == static_cast<int>(CutId::Vertex), "electronBlock cut bits must follow CutId");
+
+ //#############
+ //Cut sets for clas12ana::Run<Cuts>
+ //runtimeCuts follows the set*Cuts flags (what Run(c12) uses), fixedCuts<...> applies
+ //exactly the listed cuts whatever the flags are; the other cuts and their bank access
+ //are compiled out. Nphe and ElMom are always applied.
+ //#############
+ struct runtimeCuts
+ {
+   static constexpr bool runtime = true;
+   static constexpr bool on(CutId) {return true;}
+ };
+
+ template<CutId... Ids>
+ struct fixedCuts
+ {
+   static constexpr bool runtime = false;
+   static constexpr bool on(CutId cut) {return (false || ... || (cut == Ids));}
+ };
+
+ //same cuts as the default flags of clas12ana
+ using defaultCuts = fixedCuts<CutId::EcalSF, CutId::EcalP, CutId::EcalDiag, CutId::EcalEdge, CutId::Pid, CutId::ProtonPid,
+			       CutId::Vertex, CutId::DCEdge, CutId::CDEdge, CutId::VertexCorr, CutId::GhostTrack>;
+
+ //#############
+ //Parameter sets selected by run number, see Ana/cutFiles/run_ranges.par
+ //#############
+ struct anaParSet
+ {
+   std::string file;
+   std::map<int, std::vector<double> > pid_cuts_cd;
+   std::map<int, std::vector<double> > pid_cuts_fd;
+   std::map<int, std::vector<double> > vertex_z_cuts_cd;
+   std::map<int, std::vector<double> > vertex_z_cuts_fd;
+ };
+
+ struct ecalParSet
+ {
+   std::string file;
+   double par[7][6] = {}; //sector, parameter
+ };
+
+ struct runInterval
+ {
+   int run_min = 0;
+   int run_max = 0;
+   int ana = -1; //index of the parameter set, -1 keeps the one currently loaded
+   int sf  = -1;
+   int pi  = -1;
+ };
+
+ //bit i is set for CutId i; a cut is only evaluated when the selection needs it
+ struct cutMask
+ {
+   unsigned int evaluated = 0;
+   unsigned int passed    = 0;
+ };
+
  class clas12ana : public clas12reader
  {
 
@@ -49,6 +144,10 @@
      };
 
    void Init();
+
+   //new instance with the same cut parameters and flags, e.g. one per worker thread
+   std::unique_ptr<clas12ana> clone() const;
+   void copyParameters(const clas12ana &other);
    void WriteSFEcalCuts();
    void InitSFEcalCuts();
    void InitSFPCuts();
@@ -56,12 +155,23 @@
    void readInputSRCParam(const char* inFile);
    void readEcalPPar(const char* filename);
    void readEcalSFPar(const char* filename);
+   void readRunRanges(const char* filename);
    void printParams();
 
+   //all parameter files of Ana/cutFiles, from the binary snapshot (make_par_snapshot) when
+   //it is up to date with the text files, see clas12anasnapshot.h
+   void readParFiles();
+   bool readParSnapshot(const char* filename);
+   bool writeParSnapshot(const char* filename);
+   static std::string parSnapshotFile()  {return CLAS12ANA_SNAPSHOT;};
+
    //   void InitDebugPlots();
    void Clear();
    void clearInputParam();
    void Run(const std::unique_ptr<clas12::clas12reader>& c12);
+   //same selection with a compile-time cut set, e.g. Run<defaultCuts>(c12)
+   template<class Cuts>
+     void Run(const std::unique_ptr<clas12::clas12reader>& c12);
 
    double getSF(const region_part_ptr &p);
 
@@ -80,6 +190,15 @@
 
    void setDebugPlots(bool flag = true)  {debug_plots = flag;};
    void setDebugFile(TString file)  {debug_out_file = file;};
+   TString getDebugFile() const     {return debug_out_file;};
+   void setDebugBinningFile(TString file)  {debug_c.setBinningFile(file);};
+   //fill the debug plots for every n-th event, or for n random events per run
+   void setDebugPrescale(int n)   {debug_c.setPrescale(n);};
+   void setDebugReservoir(int n)  {debug_c.setReservoir(n);};
+   bool getDebugPlots() const       {return debug_plots;};
+
+   //REC::Traj lookups of the current event, shared by the edge cuts and debug plots
+   clas12trajcache& getTrajCache()  {return traj_cache;};
 
    void checkCutParametersCut();
  
@@ -87,66 +206,50 @@
 
    TVector3 getCOM(TLorentzVector l, TLorentzVector r, TLorentzVector q);
 
+   //particles of this event passing the cuts; the view stays valid until the next Run()
+   const std::vector<region_part_ptr>& getByPidView(int pid) const
+     {
+       return this->*pid_buckets[pidBucket(pid)];
+     }
+
    std::vector<region_part_ptr> getByPid(int pid)
      {
-       if( pid == 11)
-	 return electrons;
-       else if( pid == 2212)
-	 return protons;
-       else if( pid == 2112)
-	 return neutrons;
-       else if( pid == 45)
-	 return deuterons;
-       else if( pid == 211)
-	 return piplus;
-       else if( pid == -211)
-	 return piminus;
-       else if( pid == 321)
-	 return kplus;
-       else if( pid == -321)
-	 return kminus;
-       else if( pid == 0)
-	 return neutrals;
-       else
-	 return otherpart;
+       return getByPidView(pid);
+     }
+
+   //calls f(p,pid) for every particle selected in this event, pid as assigned by the cuts
+   //(the REC::Particle pid for the other particles, 9999 for the CD protons failing the PID cuts)
+   template<class F>
+     void forEachSelected(F f) const
+     {
+       for(int b = 0; b < n_pid_buckets; b++)
+	 for(auto &p : this->*pid_buckets[b])
+	   {
+	     int pid = bucket_pid[b];
+	     //a proton among the other particles was set to 9999 by setByPid
+	     if(b == b_other && p->par()->getPid() != 2212)
+	       pid = p->par()->getPid();
+	     f(p,pid);
+	   }
      }
 
 
-   void setByPid(const region_part_ptr &p)
+   template<class Cuts = runtimeCuts>
+     void setByPid(const region_part_ptr &p)
      {
        int pid = p->par()->getPid();
 
-       if(checkProtonPidCut(p) && f_protonpidCuts)
+       bool proton_pid = cutOn<Cuts,CutId::ProtonPid>(f_protonpidCuts);
+       if(proton_pid && passed(p,CutId::ProtonPid))
 	 pid = 2212;
-
-       if(!checkProtonPidCut(p) && f_protonpidCuts && 
-	  f_pidCuts && p->getRegion() == clas12::CD && pid == 2212 )
+       else if(proton_pid && cutOn<Cuts,CutId::Pid>(f_pidCuts) && p->getRegion() == clas12::CD && pid == 2212 )
        	 pid = 9999;
 
-       if(pid == 11)
-	 electrons.push_back(p);
-       else if(pid == 2212)
-	 {
-	   //is a proton if not a ghost track and check for PID by TOF vs momentum assignment
-	   if(!(checkGhostTrackCD(p) && f_ghostTrackCuts))
-	     protons.push_back(p);
-	 }
-       else if(pid == 2112)
-	 neutrons.push_back(p);
-       else if(pid == 45)
-	  deuterons.push_back(p);
-       else if(pid == 211)
-	  piplus.push_back(p);
-       else if(pid == -211)
-	  piminus.push_back(p);
-       else if(pid == 321)
-	  kplus.push_back(p);
-       else if(pid == -321)
-	  kminus.push_back(p);
-       else if(pid == 0)
-	 neutrals.push_back(p);
-       else 
-	 otherpart.push_back(p);
+       //is a proton if not a ghost track, checked in setGhostTracks once all candidates are known
+       if(pid == 2212)
+	 proton_candidates.push_back(p);
+       else
+	 (this->*pid_buckets[pidBucket(pid)]).push_back(p);
 
      }
 
@@ -163,9 +266,67 @@
    bool CDEdgeCuts(const region_part_ptr &p);
 
    bool checkGhostTrackCD(const region_part_ptr &p);
+   void setGhostTracks() {setGhostTracks(f_ghostTrackCuts);};
+   void setGhostTracks(bool apply);
 
    bool checkVertexCorrelation(const region_part_ptr &el,const region_part_ptr &p);
 
+   //cut results of the current event, evaluated at most once per particle
+   //passed() evaluates the cut if Run did not need it yet
+   bool passed(const region_part_ptr &p, CutId cut);
+   //vertex cut, with the proton limits for proton PID candidates when Cuts applies the proton PID
+   template<class Cuts = runtimeCuts>
+     bool passedVertex(const region_part_ptr &p)
+     {
+       return passed(p,CutId::Vertex,[&]{return checkVertexAs<Cuts>(p);});
+     }
+   cutMask getCutMask(const region_part_ptr &p) const;
+
+   //electron cuts for a block of candidates gathered over many events (see clas12elkernel.h)
+   //Run keeps the per-particle cuts, which stop at the first failed cut of a candidate
+   //uses the parameters of run and the current flags; the DC edge cut is not included
+   void selectElectrons(electronBlock &block, int run);
+
+   template<class Cuts = runtimeCuts>
+     electronCutPars getElectronCutPars() const
+     {
+       auto bit = [](CutId cut){return 1u << static_cast<unsigned int>(cut);};
+
+       electronCutPars pars;
+       pars.cuts = bit(CutId::Nphe) | bit(CutId::ElMom);
+       if(cutOn<Cuts,CutId::EcalSF>(f_ecalSFCuts))     pars.cuts |= bit(CutId::EcalSF);
+       if(cutOn<Cuts,CutId::EcalP>(f_ecalPCuts))       pars.cuts |= bit(CutId::EcalP);
+       if(cutOn<Cuts,CutId::EcalDiag>(f_ecalDiagCuts)) pars.cuts |= bit(CutId::EcalDiag);
+       if(cutOn<Cuts,CutId::EcalEdge>(f_ecalEdgeCuts)) pars.cuts |= bit(CutId::EcalEdge);
+       if(cutOn<Cuts,CutId::Vertex>(f_vertexCuts))     pars.cuts |= bit(CutId::Vertex);
+
+       pars.pcal_energy_cut = pcal_energy_cut;
+       pars.ecal_edge_cut   = ecal_edge_cut;
+       pars.ecal_diag_cut   = ecal_diag_cut;
+       pars.vx[0] = vertex_x_cuts.at(0);
+       pars.vx[1] = vertex_x_cuts.at(1);
+       pars.vy[0] = vertex_y_cuts.at(0);
+       pars.vy[1] = vertex_y_cuts.at(1);
+
+       auto fd = vertex_z_cuts_fd.find(11);
+       pars.has_vz_fd = fd != vertex_z_cuts_fd.end();
+       if(pars.has_vz_fd)
+	 std::copy(fd->second.begin(),fd->second.begin() + 2,pars.vz_fd);
+       auto cd = vertex_z_cuts_cd.find(11);
+       pars.has_vz_cd = cd != vertex_z_cuts_cd.end();
+       if(pars.has_vz_cd)
+	 std::copy(cd->second.begin(),cd->second.begin() + 2,pars.vz_cd);
+
+       pars.sf_table = &ecal_sf_table;
+       pars.p_table  = &ecal_p_table;
+       return pars;
+     }
+
+   //per run cut flow, only filled when built with CLAS12ANA_CUTFLOW > 0 (see clas12cutflow.h)
+   void printCutFlow(std::ostream &out = std::cout) const {cut_flow.print(out,cut_names);};
+   void writeCutFlow(TString file) const                  {cut_flow.write(file,cut_names);};
+   void addCutFlow(const clas12ana &other)                {cut_flow.add(other.cut_flow);};
+
    bool CDRegionCuts(const region_part_ptr &p);
 
    void setVxcuts(double min, double max){vertex_x_cuts.at(0)=min; vertex_x_cuts.at(1)=max;};
@@ -181,11 +342,61 @@
    void getLeadRecoilSRC(TLorentzVector beam, TLorentzVector target, TLorentzVector el);
    std::vector<region_part_ptr> getLeadSRC(){return lead_proton;};
    std::vector<region_part_ptr> getRecoilSRC(){return recoil_proton;};
+   //kinematics of every proton from the last getLeadRecoilSRC call, same order as getByPidView(2212)
+   const srcKinematics& getSRCKinematics() const {return src_kin;};
    std::vector<region_part_ptr> getByPid(std::vector<region_part_ptr> particles, int pid);
 
 
   private:
 
+   //used by clone(), the parameters are copied instead of read by Init
+   struct noInit {};
+   clas12ana(bool debug, noInit): debug_plots{debug} {};
+
+   //flag of a cut for the cut set Cuts, a constant unless Cuts::runtime
+   template<class Cuts, CutId cut>
+     bool cutOn(bool flag) const
+     {
+       if constexpr (Cuts::runtime)
+	 return flag;
+       else
+	 return Cuts::on(cut);
+     }
+
+   bool evaluateCut(const region_part_ptr &p, CutId cut);
+   bool checkVertex(const region_part_ptr &p, int pid);
+
+   template<class Cuts>
+     bool checkVertexAs(const region_part_ptr &p)
+     {
+       int pid = p->par()->getPid();
+       if(cutOn<Cuts,CutId::ProtonPid>(f_protonpidCuts) && passed(p,CutId::ProtonPid))
+	 pid = 2212;
+
+       return checkVertex(p,pid);
+     }
+
+   //result of cut for p, evaluate() is only called the first time in the event
+   template<class F>
+     bool passed(const region_part_ptr &p, CutId cut, F &&evaluate)
+     {
+       unsigned int bit = 1u << static_cast<unsigned int>(cut);
+       const cutMask &mask = cutMaskAt(p);
+
+       if(mask.evaluated & bit)
+	 return mask.passed & bit;
+
+       //evaluate may fill other bits first (vertex needs the proton PID), which can resize cut_masks
+       auto t0 = cut_flow.start();
+       bool pass = evaluate();
+       cut_flow.record(current_run,static_cast<int>(cut),pass,t0);
+       setCutResult(p,cut,pass);
+
+       return pass;
+     }
+   cutMask& cutMaskAt(const region_part_ptr &p);
+   void setCutResult(const region_part_ptr &p, CutId cut, bool pass);
+
    clas12debug debug_c; //debug class for plotting general plots
    TString debug_out_file = "debugPlots.root";
 
@@ -200,27 +411,84 @@
    std::vector<region_part_ptr> kminus;
    std::vector<region_part_ptr> otherpart;
 
+   //PID indexed bucket table, pidBucket(pid) gives the slot of the particle vector
+   enum {b_electron, b_proton, b_neutron, b_deuteron, b_piplus, b_piminus, b_kplus, b_kminus, b_neutral, b_other, n_pid_buckets};
+   static std::vector<region_part_ptr> clas12ana::* const pid_buckets[n_pid_buckets];
+   static constexpr int bucket_pid[n_pid_buckets] = {11, 2212, 2112, 45, 211, -211, 321, -321, 0, 9999};
+
+   static int pidBucket(int pid)
+     {
+       switch(pid)
+	 {
+	 case 11:   return b_electron;
+	 case 2212: return b_proton;
+	 case 2112: return b_neutron;
+	 case 45:   return b_deuteron;
+	 case 211:  return b_piplus;
+	 case -211: return b_piminus;
+	 case 321:  return b_kplus;
+	 case -321: return b_kminus;
+	 case 0:    return b_neutral;
+	 default:   return b_other;
+	 }
+     }
+
+   std::vector<cutMask> cut_masks;      //indexed by REC::Particle row, reset every event
+   region_part_ptr trigger_el = nullptr; //electron used for the vertex correlation cut
+   std::vector<region_part_ptr> proton_candidates; //protons before the ghost track pass
+   std::vector<int> ghost_ctof;        //sorted CTOF components and thetas of the accepted
+   std::vector<double> ghost_theta_cd; //protons, used by the ghost track pass
+   std::vector<double> ghost_theta_fd;
+   clas12trajcache traj_cache;
+   srcKinematics src_kin;
+
+   cutFlowPolicy<static_cast<int>(CutId::NCuts)> cut_flow;
+   static const char* const cut_names[static_cast<int>(CutId::NCuts)];
+
    //SRC 
    std::vector<region_part_ptr> lead_proton;
    std::vector<region_part_ptr> recoil_proton;
 
    //prototype function for fitting ECAL electron cuts
-   TF1 *ecal_p_fcn[2][7];  //0 upper 1 lower fiducial
-   TF1 *ecal_sf_fcn[2][7]; //0 upper 1 lower fiducial
+   //only built for WriteSFEcalCuts, the cuts use the tables below
+   TF1 *ecal_p_fcn[2][7] = {};  //0 upper 1 lower fiducial
+   TF1 *ecal_sf_fcn[2][7] = {}; //0 upper 1 lower fiducial
 
-   TF1 *ecal_p_mean_fcn[7];  //mean function for plotting
-   TF1 *ecal_sf_mean_fcn[7]; //mean function for plotting
+   TF1 *ecal_p_mean_fcn[7] = {};  //mean function for plotting
+   TF1 *ecal_sf_mean_fcn[7] = {}; //mean function for plotting
+   void buildSFFunctions();
 
-   //proton pid TOF vs momentum
-   TF1 *proton_pid_mean  = new TF1("proton_pid_mean","[0]*(1 + ([1]/(x-[3])) + ([2]/pow(x-[3],2)))",0,10); 
-   TF1 *proton_pid_sigma = new TF1("proton_pid_sigma","[0]*(1 + ([1]/(x-[3])) + ([2]/pow(x-[3],2)))",0,10); 
+   //proton pid TOF vs momentum, [0]*(1 + ([1]/(x-[3])) + ([2]/pow(x-[3],2)))
+   static constexpr double proton_pid_mean_par[4]  = {0.0152222,0.816844,-0.0950375,0.255628};
+   static constexpr double proton_pid_sigma_par[4] = {0.0760525,0.240862,-0.000276433,0.229085};
 
    double ecal_p_fcn_par[7][6];  //sector, parameter
    double ecal_sf_fcn_par[7][6]; //sector, parameter
 
+   //compiled copies of the functions above used when applying the cuts
+   sfCutTable ecal_p_table;
+   sfCutTable ecal_sf_table;
+   protonPidTable proton_pid_table;
+
    int current_run     = -1;
    int previous_run    = -1;
    int current_cut_run = -1;
+
+   //run range registry, all files parsed once in readRunRanges
+   bool parseInputParam(const char* filename, anaParSet &set);
+   bool parseEcalPar(const char* filename, double par[7][6]);
+   void applyInputParam(const anaParSet &set);
+   int addAnaParSet(const std::string &file);
+   int addEcalParSet(std::vector<ecalParSet> &sets, const std::string &file);
+   const runInterval* findRunInterval(int run) const;
+
+   std::vector<anaParSet> ana_par_sets;
+   std::vector<ecalParSet> sf_par_sets;
+   std::vector<ecalParSet> pi_par_sets;
+   std::vector<runInterval> run_intervals; //sorted by run_min
+   int applied_ana = -1;
+   int applied_sf  = -1;
+   int applied_pi  = -1;
    int sigma_cut   = 3;
 
    bool f_ecalSFCuts         = true;
@@ -287,7 +555,130 @@
    double event_mult = 0; //charged particle multiplicity 
 
    bool debug_plots = false;
+   bool debug_event = false; //debug plots filled for the current event
+
  };
 
+ //cuts applied by Run<Cuts>; the f_*Cuts flags are only read when Cuts::runtime
+ template<class Cuts>
+ void clas12ana::Run(const std::unique_ptr<clas12::clas12reader>& c12)
+ {
+   Clear();
+   current_run = c12->runconfig()->getRun();
+   checkCutParameters(); //check run number has the right cuts 
+
+   //debug plots may only be filled for a sample of the events
+   debug_event = debug_plots && debug_c.beginEvent(current_run);
+
+
+
+   auto particles = c12->getDetParticles(); //particles is now a std::vector of particles for this event
+   auto electrons_det = c12->getByID(11);
+
+   //DEBUG plots
+   if(debug_event)
+     {
+       for(auto el : electrons_det)
+	 debug_c.fillBeforeEl(el);
+     }
+
+   std::for_each(electrons_det.begin(),electrons_det.end(),[this](const region_part_ptr &el)
+		 {
+		   if(!((!passed(el,CutId::Nphe))                       || //Photo electron min cut
+			(cutOn<Cuts,CutId::EcalSF>(f_ecalSFCuts)     && !passed(el,CutId::EcalSF))   || //ECAL SF cuts
+			(cutOn<Cuts,CutId::EcalP>(f_ecalPCuts)       && !passed(el,CutId::EcalP))    || //ECAL SF cuts
+			(cutOn<Cuts,CutId::EcalDiag>(f_ecalDiagCuts) && !passed(el,CutId::EcalDiag)) || //ECAL Diagonoal SF cuts
+			(cutOn<Cuts,CutId::EcalEdge>(f_ecalEdgeCuts) && !passed(el,CutId::EcalEdge)) || //ECAL edge cuts
+			(cutOn<Cuts,CutId::Vertex>(f_vertexCuts)     && !passedVertex<Cuts>(el))     || //Vertex cut
+			(cutOn<Cuts,CutId::DCEdge>(f_DCEdgeCuts)     && !passed(el,CutId::DCEdge))   || //DC edge cut
+			(!passed(el,CutId::ElMom))) ) // minium 800 MeV/c cut for electrons in class     
+		     setByPid<Cuts>(el);
+		 });
+  
+  
+   if(debug_event)
+     {
+       for(auto el : electrons)
+	 debug_c.fillAfterEl(el);
+     }
+  
+  
+   if(electrons.size() == 1) //good trigger electron
+     {
+      
+       if(debug_event)
+	 {
+	   for(auto p : particles)
+	     if(p->par()->getPid() == 2212 || p->par()->getPid() == -211 || p->par()->getPid() == 211)
+	       debug_c.fillBeforePart(p);
+	 }
+      
+      
+       /*
+	 This may be a strange way to check the cuts, maybe there is a better way
+	 We need to ensure that the flag f_cuts is on otherwise we don't want to apply any cut
+	 The below logic will return particles that did not pass any cut (for only cut flags that are on
+	 Then I will invert the logic using !(logic) to return when the particle do pass all cuts
+	
+	 (!checkPidCut(p) && f_pidCuts)    ||             //PID cuts
+	 (!checkVertex(p) && f_vertexCuts) ||  //Vertex cut
+	 (!CDEdgeCuts(p)  && f_CDEdgeCuts) ||  //CD edge cut
+	 (!CDRegionCuts(p)  && f_CDRegionCuts) ||  //CD edge cut
+	 (!DCEdgeCuts(p) && f_DCEdgeCuts)  || //DC edge cut
+	 (!checkVertexCorrelation(electrons_det[0],p) && f_corr_vertexCuts) //Vertex correlation cut between electron
+       */
+      
+       trigger_el = electrons_det[0];
+
+       std::for_each(particles.begin(),particles.end(),[this](const region_part_ptr &p)
+		     {
+		       //neutrals and electrons don't follow cuts below, skip them 
+		       if(p->par()->getCharge() == 0 && p->par()->getPid() != 11 )
+			 {
+			   setByPid<Cuts>(p);
+			   return;
+			 }
+		       else if(p->par()->getPid() != 11  && electrons.size() > 0)
+			 {
+			   ++event_mult; //charge particles
+
+
+			   bool check_pid_cuts = ((cutOn<Cuts,CutId::ProtonPid>(f_protonpidCuts) && passed(p,CutId::ProtonPid)) || //check if in proton PID cuts or chi2pid cuts
+						  (cutOn<Cuts,CutId::Pid>(f_pidCuts) && passed(p,CutId::Pid)) || // if proton pid cuts if off but pid cuts on just use chi2pid
+						  (!cutOn<Cuts,CutId::ProtonPid>(f_protonpidCuts) && !cutOn<Cuts,CutId::Pid>(f_pidCuts)));                 // if no pid cuts are specified let all particles pass pid 
+			  
+			   if( !( (!check_pid_cuts)                                   || //PID cuts
+				  (cutOn<Cuts,CutId::Vertex>(f_vertexCuts)          && !passedVertex<Cuts>(p))       || //Vertex cut
+				  (cutOn<Cuts,CutId::CDEdge>(f_CDEdgeCuts)          && !passed(p,CutId::CDEdge))     || //CD edge cut
+				  (cutOn<Cuts,CutId::CDRegion>(f_CDRegionCuts)      && !passed(p,CutId::CDRegion))   || //CD edge cut
+				  (cutOn<Cuts,CutId::DCEdge>(f_DCEdgeCuts)          && !passed(p,CutId::DCEdge))     || //DC edge cut
+				  (cutOn<Cuts,CutId::VertexCorr>(f_corr_vertexCuts) && !passed(p,CutId::VertexCorr))) ) //Vertex correlation cut between electron
+			     setByPid<Cuts>(p);
+			 }
+		     });
+
+       setGhostTracks(cutOn<Cuts,CutId::GhostTrack>(f_ghostTrackCuts));
+      
+      
+       if(debug_event)
+	 {
+	  
+	   for(auto p : protons)
+	     debug_c.fillAfterPart(p);
+	   for(auto p : piplus)
+	     debug_c.fillAfterPart(p);
+	   for(auto p : piminus)
+	     debug_c.fillAfterPart(p);
+	  
+	   for(auto el : electrons)
+	     debug_c.fillAfterEl(el);
+	  
+	 }
+
+     }//good electron loop
+  
+  
+ }
+
 #endif
 
@@ -0,0 +1,245 @@
+ #ifndef CLAS12ANASNAPSHOT_HH
+ #define CLAS12ANASNAPSHOT_HH
+
+ #include <iostream>
+ #include <fstream>
+ #include <string>
+ #include <vector>
+ #include <map>
+ #include <algorithm>
+ #include <cstring>
+ #include <cstdint>
+ #include <type_traits>
+ #include <filesystem>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+
+ //#############
+ //Binary snapshot of the Ana/cutFiles parameters
+ //make_par_snapshot parses the cut files once and writes the parsed values (run ranges,
+ //PID/vertex sets, ECal SF parameters, SRC cuts) to one file. clas12ana::Init maps the
+ //snapshot and copies the values instead of parsing the text files, as long as the version
+ //and the stamp (names, sizes and modification times) of the .par/.dat files it was made
+ //from match. Otherwise the text files are read as before.
+ //#############
+
+ const char par_snapshot_magic[8] = {'C','1','2','A','S','N','A','P'};
+ const uint32_t par_snapshot_version = 2;
+
+ //FNV-1a over the names, sizes and modification times of every .par and .dat file in dir,
+ //cheap enough for every start-up; the build regenerates the snapshot when a file changes
+ inline uint64_t parFilesStamp(const std::string &dir)
+ {
+   struct fileStamp
+   {
+     std::string name;
+     uint64_t size;
+     int64_t mtime;
+   };
+   std::vector<fileStamp> files;
+   std::error_code ec;
+   for(auto &entry : std::filesystem::directory_iterator(dir,ec))
+     {
+       std::string ext = entry.path().extension().string();
+       if(entry.is_regular_file() && (ext == ".par" || ext == ".dat"))
+	 files.push_back({entry.path().filename().string(),entry.file_size(),
+			  (int64_t)entry.last_write_time().time_since_epoch().count()});
+     }
+   std::sort(files.begin(),files.end(),[](const fileStamp &a, const fileStamp &b){return a.name < b.name;});
+
+   uint64_t hash = 14695981039346656037ULL;
+   auto add = [&hash](const void *data, size_t n)
+     {
+       for(size_t i = 0; i < n; i++)
+	 {
+	   hash ^= static_cast<const unsigned char*>(data)[i];
+	   hash *= 1099511628211ULL;
+	 }
+     };
+
+   for(auto &file : files)
+     {
+       add(file.name.c_str(),file.name.size() + 1);
+       add(&file.size,sizeof(file.size));
+       add(&file.mtime,sizeof(file.mtime));
+     }
+   return hash;
+ }
+
+ //append only buffer written to the snapshot file
+ struct parSnapshotWriter
+ {
+   std::string buf;
+
+   template<class T>
+     void put(const T &value)
+   {
+     static_assert(std::is_trivially_copyable<T>::value,"only plain values are stored as bytes");
+     buf.append(reinterpret_cast<const char*>(&value),sizeof(T));
+   };
+
+   void put(const std::string &s)
+   {
+     put<uint32_t>(s.size());
+     buf.append(s);
+   };
+
+   void put(const std::vector<double> &v)
+   {
+     put<uint32_t>(v.size());
+     buf.append(reinterpret_cast<const char*>(v.data()),v.size()*sizeof(double));
+   };
+
+   void put(const std::map<int, std::vector<double> > &m)
+   {
+     put<uint32_t>(m.size());
+     for(auto &entry : m)
+       {
+	 put<int32_t>(entry.first);
+	 put(entry.second);
+       }
+   };
+
+   //header first, then the values
+   bool write(const char *filename, uint64_t stamp) const
+   {
+     std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+     if(!out.is_open())
+       return false;
+     out.write(par_snapshot_magic,sizeof(par_snapshot_magic));
+     out.write(reinterpret_cast<const char*>(&par_snapshot_version),sizeof(par_snapshot_version));
+     out.write(reinterpret_cast<const char*>(&stamp),sizeof(stamp));
+     out.write(buf.data(),buf.size());
+     return out.good();
+   };
+ };
+
+ //read-only mapping of a snapshot file, every read is bounds checked
+ class parSnapshotReader
+ {
+
+  public:
+   parSnapshotReader(const char *filename)
+     {
+       int fd = open(filename,O_RDONLY);
+       if(fd < 0)
+	 return;
+
+       struct stat st;
+       if(fstat(fd,&st) == 0 && st.st_size > 0)
+	 {
+	   void *data = mmap(nullptr,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+	   if(data != MAP_FAILED)
+	     {
+	       begin = static_cast<const char*>(data);
+	       size = st.st_size;
+	       cur = begin;
+	       good = true;
+	     }
+	 }
+       close(fd);
+     };
+
+   ~parSnapshotReader()
+     {
+       if(begin)
+	 munmap(const_cast<char*>(begin),size);
+     };
+
+   parSnapshotReader(const parSnapshotReader&) = delete;
+   parSnapshotReader& operator=(const parSnapshotReader&) = delete;
+
+   bool isOpen() const {return begin != nullptr;};
+   //false once any read ran past the end of the file
+   bool ok() const {return good;};
+   bool atEnd() const {return cur == begin + size;};
+
+   //magic, version and stamp of the header
+   bool readHeader(uint64_t &stamp)
+   {
+     char magic[sizeof(par_snapshot_magic)];
+     if(!take(magic,sizeof(magic)) || std::memcmp(magic,par_snapshot_magic,sizeof(magic)) != 0)
+       return good = false;
+     return get<uint32_t>() == par_snapshot_version && take(&stamp,sizeof(stamp));
+   };
+
+   template<class T>
+     T get()
+   {
+     static_assert(std::is_trivially_copyable<T>::value,"only plain values are stored as bytes");
+     T value{};
+     take(&value,sizeof(T));
+     return value;
+   };
+
+   template<class T>
+     void get(T *dest, size_t n)
+   {
+     static_assert(std::is_trivially_copyable<T>::value,"only plain values are stored as bytes");
+     take(dest,n*sizeof(T));
+   };
+
+   void get(std::string &s)
+   {
+     uint32_t n = get<uint32_t>();
+     if(!check(n))
+       return;
+     s.assign(cur,n);
+     cur += n;
+   };
+
+   void get(std::vector<double> &v)
+   {
+     uint32_t n = get<uint32_t>();
+     if(!check(size_t(n)*sizeof(double)))
+       return;
+     v.resize(n);
+     take(v.data(),n*sizeof(double));
+   };
+
+   void get(std::map<int, std::vector<double> > &m)
+   {
+     m.clear();
+     uint32_t n = get<uint32_t>();
+     for(uint32_t i = 0; i < n && good; i++)
+       {
+	 int32_t key = get<int32_t>();
+	 get(m[key]);
+       }
+   };
+
+   //count of the following entries, rejected if larger than the rest of the file
+   uint32_t getCount()
+   {
+     uint32_t n = get<uint32_t>();
+     return check(n) ? n : 0;
+   };
+
+  private:
+
+   bool check(size_t n)
+   {
+     if(good && size_t(begin + size - cur) >= n)
+       return true;
+     good = false;
+     return false;
+   };
+
+   bool take(void *dest, size_t n)
+   {
+     if(!check(n))
+       return false;
+     std::memcpy(dest,cur,n);
+     cur += n;
+     return true;
+   };
+
+   const char *begin = nullptr;
+   const char *cur = nullptr;
+   size_t size = 0;
+   bool good = false;
+ };
+
+ #endif
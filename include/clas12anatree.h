@@ -0,0 +1,105 @@
+ #ifndef CLAS12ANATREE_HH
+ #define CLAS12ANATREE_HH
+
+ #include <iostream>
+ #include <memory>
+ #include "TFile.h"
+ #include "TTree.h"
+ #include "TChain.h"
+ #include "TString.h"
+ #include "clas12ana.h"
+
+ //#############
+ //Columnar output of the events and particles selected by clas12ana.
+ //One branch per quantity (fixed size arrays with a particle counter), so
+ //downstream code can read only the columns it needs without decoding HIPO
+ //or rerunning the cuts. The same struct is used to write and to read back.
+ //#############
+
+ struct anaTreeEvent
+ {
+   static const int max_part = 100;
+
+   //event
+   int   run = 0;
+   int   event = 0;
+   float start_time = 0;
+   float weight = 1;
+
+   //electron kinematics, filled when clas12ana selected exactly one electron
+   float q2 = 0;
+   float xb = 0;
+   float nu = 0;
+   float w  = 0;
+
+   //selected particles
+   int   npart = 0;
+   int   pid[max_part];      //pid assigned by clas12ana, 9999 for CD protons failing the PID cuts
+   int   pid_rec[max_part];  //REC::Particle pid
+   int   pindex[max_part];   //REC::Particle row
+   int   charge[max_part];
+   int   region[max_part];   //clas12::FT/FD/CD
+   int   sector[max_part];
+   int   status[max_part];
+   float px[max_part];
+   float py[max_part];
+   float pz[max_part];
+   float vx[max_part];
+   float vy[max_part];
+   float vz[max_part];
+   float beta[max_part];
+   float chi2pid[max_part];
+   float path[max_part];
+   float time[max_part];
+   unsigned int cut_evaluated[max_part]; //bit i set if CutId i was evaluated
+   unsigned int cut_passed[max_part];    //bit i set if CutId i passed
+   int   src[max_part];      //1 lead, 2 recoil if getLeadRecoilSRC was called before filling
+
+   void Branch(TTree *tree);
+   void SetBranchAddress(TTree *tree);
+ };
+
+
+ class clas12anatree
+ {
+
+  public:
+   clas12anatree(TString file, double beam_E, TString tree_name = "clas12ana");
+   ~clas12anatree(){Close();};
+
+   //writes the particles clas12ana selected in the current event
+   void Fill(const std::unique_ptr<clas12::clas12reader>& c12, clas12ana &ana, double weight = 1);
+   void Close();
+
+   anaTreeEvent& getEvent()  {return ev;};
+
+  private:
+   std::unique_ptr<TFile> out_file;
+   TTree *tree = nullptr;
+   anaTreeEvent ev;
+   double beam_energy = 0;
+   double mass_proton = 0.938272; //GeV/c2
+   bool warned_truncated = false;
+
+ };
+
+
+ class clas12anatreereader
+ {
+
+  public:
+   clas12anatreereader(TString tree_name = "clas12ana") : chain(tree_name) {ev.SetBranchAddress(&chain);};
+
+   void Add(TString file)  {chain.Add(file);};
+   bool Next()             {return chain.GetEntry(entry++) > 0;};
+   const anaTreeEvent& getEvent() const  {return ev;};
+   TChain& getChain()      {return chain;};
+
+  private:
+   TChain chain;
+   anaTreeEvent ev;
+   long long entry = 0;
+
+ };
+
+ #endif
@@ -0,0 +1,175 @@
+ #ifndef CLAS12CUTFLOW_HH
+ #define CLAS12CUTFLOW_HH
+
+ #include <iostream>
+ #include <iomanip>
+ #include <map>
+ #include <array>
+ #include <chrono>
+ #include <type_traits>
+ #include "TH1D.h"
+ #include "TFile.h"
+ #include "TString.h"
+ #include "clas12anaconfig.h"
+
+ //#############
+ //Cut flow instrumentation for clas12ana, chosen at compile time with
+ //CLAS12ANA_CUTFLOW (CMake cache variable of the same name):
+ // 0 - off, all calls are empty and compile away (default)
+ // 1 - per run pass/fail counters for every cut
+ // 2 - counters and time spent evaluating every cut, without the cuts it evaluates itself
+ //The level changes the layout of clas12ana, it is written to clas12anaconfig.h in the
+ //build tree so that every user of clas12ana.h sees the level libClas12Ana was built with.
+ //#############
+
+ struct cutFlowOff
+ {
+   static constexpr bool enabled = false;
+
+   struct timer {};
+   timer start() const {return {};}
+   void record(int, int, bool, const timer&) {}
+   void add(const cutFlowOff&) {}
+
+   void print(std::ostream &out, const char* const*) const
+   {
+     out << "clas12ana cut flow is not enabled, build with -DCLAS12ANA_CUTFLOW=1 (counters) or 2 (counters and timing)" << std::endl;
+   }
+   void write(TString, const char* const*) const {}
+ };
+
+
+ template<int NCuts, bool Timing>
+ class cutFlowCounter
+ {
+
+  public:
+   static constexpr bool enabled = true;
+
+   struct cutCount
+   {
+     long evaluated = 0;
+     long passed = 0;
+     double time_ns = 0;
+   };
+   typedef std::array<cutCount,NCuts> runCounts;
+
+   struct cutTimer
+   {
+     std::chrono::steady_clock::time_point t0;
+     double recorded_ns; //time recorded by all cuts when this one started
+   };
+   typedef typename std::conditional<Timing,cutTimer,char>::type timer;
+
+   timer start() const
+   {
+     if constexpr (Timing)
+       return {std::chrono::steady_clock::now(),recorded_ns};
+     else
+       return 0;
+   }
+
+   void record(int run, int cut, bool pass, const timer &t0)
+   {
+     if(run != last_run || !last_counts)
+       {
+	 last_counts = &counts[run];
+	 last_run = run;
+       }
+
+     cutCount &c = (*last_counts)[cut];
+     c.evaluated++;
+     c.passed += pass;
+     if constexpr (Timing)
+       {
+	 //cuts evaluated inside this one (vertex asks the proton PID) were recorded since
+	 //t0, only the rest is the time of this cut
+	 double dt = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - t0.t0).count();
+	 dt -= recorded_ns - t0.recorded_ns;
+	 c.time_ns += dt;
+	 recorded_ns += dt;
+       }
+   }
+
+   //sum of another recorder, e.g. from a worker thread
+   void add(const cutFlowCounter &other)
+   {
+     for(auto &run : other.counts)
+       for(int i = 0; i < NCuts; i++)
+	 {
+	   cutCount &c = counts[run.first][i];
+	   c.evaluated += run.second[i].evaluated;
+	   c.passed    += run.second[i].passed;
+	   c.time_ns   += run.second[i].time_ns;
+	 }
+     last_counts = nullptr;
+   }
+
+   const std::map<int,runCounts>& getCounts() const {return counts;}
+
+   void print(std::ostream &out, const char* const* names) const
+   {
+     for(auto &run : counts)
+       {
+	 out << "clas12ana cut flow for run " << run.first << std::endl;
+	 out << std::setw(12) << "cut" << std::setw(14) << "evaluated" << std::setw(14) << "passed" << std::setw(12) << "rejected";
+	 if(Timing)
+	   out << std::setw(14) << "total (ms)" << std::setw(12) << "ns/call";
+	 out << std::endl;
+
+	 for(int i = 0; i < NCuts; i++)
+	   {
+	     const cutCount &c = run.second[i];
+	     if(c.evaluated == 0)
+	       continue;
+	     out << std::setw(12) << names[i] << std::setw(14) << c.evaluated << std::setw(14) << c.passed
+		 << std::setw(11) << std::fixed << std::setprecision(2) << 100.*(c.evaluated - c.passed)/c.evaluated << "%";
+	     if(Timing)
+	       out << std::setw(14) << std::setprecision(3) << c.time_ns*1e-6 << std::setw(12) << std::setprecision(1) << c.time_ns/c.evaluated;
+	     out << std::endl;
+	   }
+       }
+   }
+
+   //one histogram per run and quantity, bins labelled by cut name
+   void write(TString file, const char* const* names) const
+   {
+     TFile out_file(file,"RECREATE");
+     for(auto &run : counts)
+       {
+	 TH1D evaluated(Form("cutflow_evaluated_%d",run.first),Form("Cut flow run %d;;Evaluated",run.first),NCuts,0,NCuts);
+	 TH1D passed(Form("cutflow_passed_%d",run.first),Form("Cut flow run %d;;Passed",run.first),NCuts,0,NCuts);
+	 TH1D time(Form("cutflow_time_%d",run.first),Form("Cut flow run %d;;Time (ns)",run.first),NCuts,0,NCuts);
+
+	 for(int i = 0; i < NCuts; i++)
+	   {
+	     evaluated.GetXaxis()->SetBinLabel(i+1,names[i]);
+	     passed.GetXaxis()->SetBinLabel(i+1,names[i]);
+	     time.GetXaxis()->SetBinLabel(i+1,names[i]);
+	     evaluated.SetBinContent(i+1,run.second[i].evaluated);
+	     passed.SetBinContent(i+1,run.second[i].passed);
+	     time.SetBinContent(i+1,run.second[i].time_ns);
+	   }
+
+	 evaluated.Write();
+	 passed.Write();
+	 if(Timing)
+	   time.Write();
+       }
+     out_file.Close();
+   }
+
+  private:
+   std::map<int,runCounts> counts;
+   runCounts *last_counts = nullptr;
+   int last_run = 0;
+   double recorded_ns = 0; //sum of the recorded cut times, for nested cuts
+
+ };
+
+
+ template<int NCuts>
+   using cutFlowPolicy = typename std::conditional<(CLAS12ANA_CUTFLOW == 0), cutFlowOff,
+						   cutFlowCounter<NCuts,(CLAS12ANA_CUTFLOW > 1)> >::type;
+
+ #endif
@@ -0,0 +1,106 @@
+ #ifndef CLAS12CUTFUNCTIONS_HH
+ #define CLAS12CUTFUNCTIONS_HH
+
+ #include <cmath>
+
+ //#############
+ //Compiled versions of the clas12ana cut functions.
+ //The expressions are written in the same operation order as the TF1
+ //formulas they replace so the cut limits are bit for bit identical.
+ //#############
+
+ //SF cut band per sector: [0] + [1]/x + [2]/pow(x,2) -/+ [6]*( [3] + [4]/x + [5]/pow(x,2))
+ struct sfCutTable
+ {
+   static const int n_sectors = 7; //index 0 unused, sectors 1-6
+   static const int n_par = 6;
+
+   //coefficient major so that a batch over candidates reads contiguous memory per coefficient
+   double par[n_par][n_sectors] = {};
+   double nsigma = 3;
+
+   void set(const double fcn_par[n_sectors][n_par], double sigma)
+   {
+     for(int i = 0; i < n_sectors; i++)
+       for(int j = 0; j < n_par; j++)
+	 par[j][i] = fcn_par[i][j];
+     nsigma = sigma;
+   }
+
+   inline double lower(int s, double x) const
+   {
+     return par[0][s] + par[1][s]/x + par[2][s]/pow(x,2) - nsigma*( par[3][s] + par[4][s]/x + par[5][s]/pow(x,2));
+   }
+
+   inline double upper(int s, double x) const
+   {
+     return par[0][s] + par[1][s]/x + par[2][s]/pow(x,2) + nsigma*( par[3][s] + par[4][s]/x + par[5][s]/pow(x,2));
+   }
+
+   inline bool inside(int s, double x, double sf) const
+   {
+     return sf < upper(s,x) && sf > lower(s,x);
+   }
+
+   //batch version: sector[i], x[i] -> low[i], up[i] for n candidates
+   void limits(const int *sector, const double *x, int n, double *low, double *up) const
+   {
+     for(int i = 0; i < n; i++)
+       {
+	 int s = sector[i];
+	 double mean  = par[0][s] + par[1][s]/x[i] + par[2][s]/pow(x[i],2);
+	 double width = nsigma*( par[3][s] + par[4][s]/x[i] + par[5][s]/pow(x[i],2));
+	 low[i] = mean - width;
+	 up[i]  = mean + width;
+       }
+   }
+
+   //batch version of inside(): pass[i] = 1 if sf[i] is inside the band
+   void inside(const int *sector, const double *x, const double *sf, int n, unsigned char *pass) const
+   {
+     for(int i = 0; i < n; i++)
+       {
+	 int s = sector[i];
+	 double mean  = par[0][s] + par[1][s]/x[i] + par[2][s]/pow(x[i],2);
+	 double width = nsigma*( par[3][s] + par[4][s]/x[i] + par[5][s]/pow(x[i],2));
+	 pass[i] = (sf[i] < mean + width) & (sf[i] > mean - width);
+       }
+   }
+ };
+
+
+ //proton TOF difference band in the CD: [0]*(1 + ([1]/(x-[3])) + ([2]/pow(x-[3],2)))
+ struct protonPidTable
+ {
+   double mean[4]  = {};
+   double sigma[4] = {};
+
+   static inline double eval(const double *par, double x)
+   {
+     return par[0]*(1 + (par[1]/(x-par[3])) + (par[2]/pow(x-par[3],2)));
+   }
+
+   inline double lower(double mom, double nsigma) const
+   {
+     return eval(mean,mom) - nsigma*eval(sigma,mom);
+   }
+
+   inline double upper(double mom, double nsigma) const
+   {
+     return eval(mean,mom) + nsigma*eval(sigma,mom);
+   }
+
+   //batch version: mom[i] -> low[i], up[i] for n candidates
+   void limits(const double *mom, int n, double nsigma, double *low, double *up) const
+   {
+     for(int i = 0; i < n; i++)
+       {
+	 double m = eval(mean,mom[i]);
+	 double w = nsigma*eval(sigma,mom[i]);
+	 low[i] = m - w;
+	 up[i]  = m + w;
+       }
+   }
+ };
+
+ #endif
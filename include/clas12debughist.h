@@ -0,0 +1,157 @@
+ #ifndef CLAS12DEBUGHIST_HH
+ #define CLAS12DEBUGHIST_HH
+
+ #include <vector>
+ #include <unordered_map>
+ #include <string>
+ #include "TString.h"
+ #include "TH1D.h"
+ #include "TH2D.h"
+
+ //#############
+ //Light-weight histogram used for the clas12debug plots.
+ //Contents are stored in a dense array for small histograms and as a map of the filled
+ //bins for the large 2D maps (PID, DC hit maps), which start mostly empty. A map that
+ //fills up to where the array would be smaller is converted to the array.
+ //Global bin numbers follow ROOT (under/overflow included) and a TH1D/TH2D is only
+ //created when the histogram is written.
+ //#############
+
+ struct debugBinning
+ {
+   int nx = 0;
+   double xmin = 0;
+   double xmax = 0;
+   int ny = 0; //0 for 1D
+   double ymin = 0;
+   double ymax = 0;
+ };
+
+ class debugHist
+ {
+
+  public:
+   debugHist(TString name, TString title, int nx, double xmin, double xmax);
+   debugHist(TString name, TString title, int nx, double xmin, double xmax, int ny, double ymin, double ymax);
+
+   //same meaning as TH1::Fill(x,w) for 1D and TH2::Fill(x,y) for 2D
+   void Fill(double x)
+   {
+     fillBin(findBin(x,bins.nx,bins.xmin,bins.xmax),1);
+   };
+   void Fill(double a, double b)
+   {
+     if(bins.ny == 0)
+       fillBin(findBin(a,bins.nx,bins.xmin,bins.xmax),b);
+     else
+       fillBin(findBin(a,bins.nx,bins.xmin,bins.xmax) + (bins.nx + 2)*findBin(b,bins.ny,bins.ymin,bins.ymax),1);
+   };
+   void Fill(double x, double y, double w)
+   {
+     fillBin(findBin(x,bins.nx,bins.xmin,bins.xmax) + (bins.nx + 2)*findBin(y,bins.ny,bins.ymin,bins.ymax),w);
+   };
+
+   //fill recorded for reservoir sampling, added later with addBin
+   struct fillRecord
+   {
+     debugHist *h;
+     int bin;
+     float w;
+   };
+
+   //while set, fills are appended to record instead of the contents
+   void setRecord(std::vector<fillRecord> *r) {record = r;};
+   //weight applied to every fill, e.g. the prescale factor
+   void setFillWeight(double w) {fill_weight = w;};
+
+   void addBin(int bin, double w)
+   {
+     entries++;
+     if(w != 1)
+       enableSumw2();
+
+     if(sparse_bins)
+       {
+	 sparse[bin] += w;
+	 if(has_sumw2)
+	   sparse_sumw2[bin] += w*w;
+	 if(sparse.size() > max_sparse_filled)
+	   toDense();
+       }
+     else
+       {
+	 dense[bin] += w;
+	 if(has_sumw2)
+	   dense_sumw2[bin] += w*w;
+       }
+   };
+
+   //changing the binning clears the contents
+   void setBinning(const debugBinning &b);
+   const debugBinning& getBinning() const {return bins;};
+
+   void Reset();
+   void Add(const debugHist &other);
+
+   const TString& GetName() const {return name;};
+   double getEntries() const {return entries;};
+   bool isSparse() const {return sparse_bins;};
+   size_t memoryUsage() const;
+
+   //conversion to ROOT, the caller owns the returned histogram
+   TH1* toROOT() const;
+   void Write() const;
+   void Draw(const char *option = "") const;
+
+  private:
+
+   static int findBin(double x, int n, double min, double max)
+   {
+     //ROOT convention: 0 underflow, n+1 overflow (NaN included)
+     if(x < min)
+       return 0;
+     if(!(x < max))
+       return n + 1;
+     return 1 + int(n*(x - min)/(max - min));
+   };
+
+   void fillBin(int bin, double w)
+   {
+     if(record)
+       record->push_back({this,bin,float(w)});
+     else
+       addBin(bin,w*fill_weight);
+   };
+
+   void enableSumw2();
+   void toDense();
+   int nBins() const {return (bins.nx + 2)*(bins.ny > 0 ? bins.ny + 2 : 1);};
+
+   //above this many bins the contents start in a map
+   static constexpr int max_dense_bins = 20000;
+   //approximate memory of a filled bin in the map (node and bucket)
+   static constexpr size_t sparse_bin_size = sizeof(std::pair<const int,double>) + 3*sizeof(void*);
+
+   TString name;
+   TString title;
+   debugBinning bins;
+
+   bool sparse_bins = false;
+   size_t max_sparse_filled = 0; //filled bins of the map above which the array is smaller
+   bool has_sumw2 = false;
+   double entries = 0;
+   double fill_weight = 1;
+   std::vector<fillRecord> *record = nullptr;
+
+   std::vector<double> dense;
+   std::vector<double> dense_sumw2;
+   std::unordered_map<int,double> sparse;
+   std::unordered_map<int,double> sparse_sumw2;
+ };
+
+ //binning overrides read from file, "name nx xmin xmax [ny ymin ymax]" per line
+ //a name ending in * applies to all histograms starting with that prefix
+ std::vector<std::pair<std::string,debugBinning>> readDebugBinning(const char *filename);
+ bool applyDebugBinning(const std::vector<std::pair<std::string,debugBinning>> &binning, debugHist &h);
+
+#endif
@@ -0,0 +1,219 @@
+ #ifndef CLAS12ELKERNEL_HH
+ #define CLAS12ELKERNEL_HH
+
+ #include <vector>
+ #include <algorithm>
+ #include <iostream>
+ #include <initializer_list>
+ #include "region_particle.h"
+ #include "clas12cutfunctions.h"
+
+ //#############
+ //Batched electron selection
+ //The fields used by the electron cuts are gathered once per candidate into one array
+ //per quantity, for one event or a block of many events. Only the fields of the cuts to be
+ //evaluated need to be gathered. Each cut is then a branch-free
+ //loop over the block, which the compiler can vectorise. Derived quantities (SF, diagonal
+ //ratio) are formed at gather time with the same expressions as the clas12ana cuts, so the
+ //results are identical to the per-particle cuts. Candidates are pid 11 particles.
+ //#############
+
+ //cut values of the electron cuts, bit i of cuts set for CutId i to evaluate
+ struct electronCutPars
+ {
+   unsigned int cuts = 0;
+
+   double nphe_min = 2;
+   double mom_min = 0.8;
+   double pcal_energy_cut = 0;
+   double ecal_edge_cut = 0;
+   double ecal_diag_cut = 0;
+   double diag_mom_min = 4.5;
+
+   double vx[2] = {-99,99};
+   double vy[2] = {-99,99};
+   bool has_vz_fd = false;
+   bool has_vz_cd = false;
+   double vz_fd[2] = {};
+   double vz_cd[2] = {};
+
+   const sfCutTable *sf_table = nullptr; //SF vs PCAL energy
+   const sfCutTable *p_table = nullptr;  //SF vs momentum
+ };
+
+ struct electronBlock
+ {
+   std::vector<long> event;  //caller supplied event number (or index) of each candidate
+   std::vector<int> sector;  //0 if outside 1-6
+   std::vector<int> region;
+   std::vector<double> nphe;
+   std::vector<double> mom;
+   std::vector<double> pcal_energy;
+   std::vector<double> sf;
+   std::vector<double> diag;
+   std::vector<double> pcal_lv;
+   std::vector<double> pcal_lw;
+   std::vector<double> vx;
+   std::vector<double> vy;
+   std::vector<double> vz;
+
+   //output, CutId bits per candidate
+   std::vector<unsigned int> evaluated;
+   std::vector<unsigned int> passed;
+
+   int size() const {return event.size();};
+
+   void clear()
+   {
+     for(auto v : {&sector,&region})
+       v->clear();
+     for(auto v : {&nphe,&mom,&pcal_energy,&sf,&diag,&pcal_lv,&pcal_lw,&vx,&vy,&vz})
+       v->clear();
+     event.clear();
+     evaluated.clear();
+     passed.clear();
+     gathered = ~0u;
+   };
+
+   //gathers the fields of the cuts in cuts (CutId bits), the same for every candidate of the block
+   void add(const clas12::region_part_ptr &el, long ev, unsigned int cuts = ~0u)
+   {
+     auto need = [cuts](std::initializer_list<int> ids)
+       {
+	 for(int id : ids)
+	   if(cuts & (1u << id))
+	     return true;
+	 return false;
+       };
+     gathered &= cuts;
+     event.push_back(ev);
+
+     double p = el->par()->getP();
+     if(need({cut_sf,cut_p}))
+       {
+	 int s = el->getSector();
+	 sector.push_back(s >= 1 && s <= 6 ? s : 0);
+	 //same expression as clas12ana::getSF
+	 sf.push_back((el->cal(clas12::PCAL)->getEnergy() +  el->cal(clas12::ECIN)->getEnergy() +  el->cal(clas12::ECOUT)->getEnergy()) / el->par()->getP());
+       }
+     if(need({cut_sf}))
+       pcal_energy.push_back(el->cal(clas12::PCAL)->getEnergy());
+     if(need({cut_nphe}))
+       nphe.push_back(el->che(clas12::HTCC)->getNphe());
+     if(need({cut_mom,cut_p,cut_diag}))
+       mom.push_back(p);
+     //same expression as clas12ana::checkEcalDiagCuts
+     if(need({cut_diag}))
+       diag.push_back((el->cal(clas12::PCAL)->getEnergy() + el->cal(clas12::ECIN)->getEnergy())/p);
+     if(need({cut_edge}))
+       {
+	 pcal_lv.push_back(el->cal(clas12::PCAL)->getLv());
+	 pcal_lw.push_back(el->cal(clas12::PCAL)->getLw());
+       }
+     if(need({cut_vertex}))
+       {
+	 region.push_back(el->getRegion());
+	 vx.push_back(el->par()->getVx());
+	 vy.push_back(el->par()->getVy());
+	 vz.push_back(el->par()->getVz());
+       }
+   };
+
+   //apply the cuts in pars.cuts to every candidate
+   void select(const electronCutPars &pars)
+   {
+     int n = size();
+     evaluated.assign(n,0);
+     passed.assign(n,0);
+     ok.resize(n);
+     if(pars.cuts & ~gathered)
+       std::cerr << "WARNING:: electronBlock::select, the fields of some cuts were not gathered, those cuts are not applied" << std::endl;
+     const unsigned int cuts = pars.cuts & gathered;
+
+     if(cuts & (1u << cut_nphe))
+       {
+	 for(int i = 0; i < n; i++)
+	   ok[i] = !(nphe[i] <= pars.nphe_min);
+	 setBits(cut_nphe);
+       }
+
+     if((cuts & (1u << cut_sf)) && pars.sf_table)
+       {
+	 pars.sf_table->inside(sector.data(),pcal_energy.data(),sf.data(),n,ok.data());
+	 for(int i = 0; i < n; i++)
+	   ok[i] &= !(pcal_energy[i] < pars.pcal_energy_cut);
+	 setBits(cut_sf);
+       }
+
+     if((cuts & (1u << cut_p)) && pars.p_table)
+       {
+	 pars.p_table->inside(sector.data(),mom.data(),sf.data(),n,ok.data());
+	 setBits(cut_p);
+       }
+
+     if(cuts & (1u << cut_diag))
+       {
+	 for(int i = 0; i < n; i++)
+	   ok[i] = (diag[i] > pars.ecal_diag_cut) | (mom[i] <= pars.diag_mom_min);
+	 setBits(cut_diag);
+       }
+
+     if(cuts & (1u << cut_edge))
+       {
+	 for(int i = 0; i < n; i++)
+	   ok[i] = (pcal_lv[i] > pars.ecal_edge_cut) & (pcal_lw[i] > pars.ecal_edge_cut);
+	 setBits(cut_edge);
+       }
+
+     if(cuts & (1u << cut_vertex))
+       {
+	 for(int i = 0; i < n; i++)
+	   {
+	     bool in_vxvy = (vx[i] > pars.vx[0]) & (vx[i] < pars.vx[1]) & (vy[i] > pars.vy[0]) & (vy[i] < pars.vy[1]);
+	     bool in_fd = (!pars.has_vz_fd) | ((vz[i] > pars.vz_fd[0]) & (vz[i] < pars.vz_fd[1]));
+	     bool in_cd = (!pars.has_vz_cd) | ((vz[i] > pars.vz_cd[0]) & (vz[i] < pars.vz_cd[1]));
+	     ok[i] = in_vxvy & ((region[i] == clas12::FD) ? in_fd : (region[i] == clas12::CD) ? in_cd : true);
+	   }
+	 setBits(cut_vertex);
+       }
+
+     if(cuts & (1u << cut_mom))
+       {
+	 for(int i = 0; i < n; i++)
+	   ok[i] = !(mom[i] < pars.mom_min);
+	 setBits(cut_mom);
+       }
+   };
+
+   //true if candidate i passed every cut in cuts
+   bool pass(int i, unsigned int cuts) const
+   {
+     return (passed[i] & cuts) == cuts;
+   };
+
+   //true if candidate i passed every cut that was applied
+   bool pass(int i) const
+   {
+     return passed[i] == evaluated[i];
+   };
+
+   //CutId values, repeated here so the kernel does not depend on clas12ana.h
+   enum {cut_nphe = 0, cut_sf = 1, cut_p = 2, cut_diag = 3, cut_edge = 4, cut_mom = 5, cut_vertex = 8};
+
+  private:
+
+   void setBits(int cut)
+   {
+     unsigned int bit = 1u << cut;
+     for(size_t i = 0; i < ok.size(); i++)
+       {
+	 evaluated[i] |= bit;
+	 passed[i] |= ok[i] ? bit : 0u;
+       }
+   };
+
+   std::vector<unsigned char> ok;
+   unsigned int gathered = ~0u; //cuts whose fields every candidate has
+ };
+
+ #endif
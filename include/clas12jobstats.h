@@ -0,0 +1,246 @@
+ #ifndef CLAS12JOBSTATS_HH
+ #define CLAS12JOBSTATS_HH
+
+ #include <iostream>
+ #include <fstream>
+ #include <sstream>
+ #include <string>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <algorithm>
+ #include <iterator>
+ #include <sys/stat.h>
+ #include <sys/resource.h>
+
+ //#############
+ //Job instrumentation shared by the executables
+ //Stage timers (RAII, see time()), events/s, input MB/s (bytes read by the process from
+ ///proc/self/io), peak RSS and an ETA from the input file sizes. A progress line replaces the
+ //dots every 100k events and summary() prints where the time went to stderr, and to JSON
+ //when a file is set with setJSONFile or the CLAS12_JOBSTATS_JSON environment variable.
+ //chain.Next() (read, decompression and the clas12reader bank decoding) is the read stage,
+ //the decoding happens inside it and cannot be timed on its own.
+ //#############
+
+ enum class jobStage {Read, Selection, Analysis, Fill, Write, NStages};
+
+ class clas12jobstats
+ {
+
+  public:
+   using clock = std::chrono::steady_clock;
+
+   clas12jobstats(std::string name = "job"): job{name}
+     {
+       start = clock::now();
+       start_bytes = bytesRead();
+       if(const char *json = std::getenv("CLAS12_JOBSTATS_JSON"))
+	 json_file = json;
+     };
+
+   //adds the time of its scope to one stage
+   //scopes nest exclusively, an inner scope pauses the one around it
+   class scope
+   {
+
+    public:
+     scope(clas12jobstats &s, jobStage st): stats{s},stage{st},outer{s.current}
+       {
+	 t0 = clock::now();
+	 if(outer)
+	   outer->pause(t0);
+	 stats.current = this;
+       };
+     ~scope()
+       {
+	 auto t1 = clock::now();
+	 stats.add(stage,t1 - t0);
+	 stats.current = outer;
+	 if(outer)
+	   outer->t0 = t1;
+       };
+     scope(const scope&) = delete;
+     scope& operator=(const scope&) = delete;
+
+    private:
+     friend class clas12jobstats;
+     void pause(clock::time_point t) {stats.add(stage,t - t0);};
+
+     clas12jobstats &stats;
+     jobStage stage;
+     scope *outer;
+     clock::time_point t0;
+   };
+
+   //auto timer = stats.time(jobStage::Selection);
+   //must be kept in a variable (guaranteed elision keeps the scope at one address)
+   scope time(jobStage stage) {return scope(*this,stage);};
+   //times one call inside an expression and returns its result
+   //if(!stats.timed(jobStage::Selection,[&]{return myCut.electroncut(c12);})) continue;
+   template<class F>
+     decltype(auto) timed(jobStage stage, F &&f)
+   {
+     auto t = time(stage);
+     return f();
+   };
+
+   void add(jobStage stage, clock::duration dt) {stage_time[int(stage)] += dt;};
+
+   //input size for the ETA, call for every file added to the chain
+   void addInputFile(const char *file)
+   {
+     struct stat st;
+     if(stat(file,&st) == 0)
+       input_bytes += st.st_size;
+   };
+   //known number of events, used for the ETA instead of the file sizes
+   void setTotalEvents(long n) {total_events = n;};
+   void setProgressInterval(long n) {progress_interval = n;};
+   void setJSONFile(const std::string &file) {json_file = file;};
+
+   //while(stats.next(chain)), times chain.Next() and counts the event
+   template<class Chain>
+     bool next(Chain &chain)
+   {
+     bool ok;
+     {
+       auto t = time(jobStage::Read);
+       ok = chain.Next();
+     }
+     if(ok)
+       event();
+     return ok;
+   };
+
+   //counts one event, for loops not using next()
+   void event()
+   {
+     if(++events % progress_interval == 0)
+       progress();
+   };
+
+   long getEvents() const {return events;};
+
+   void progress(std::ostream &out = std::cerr) const
+   {
+     double wall = elapsed();
+     char line[256];
+     snprintf(line,sizeof(line),"%s: %.2fM events  %.1f kHz  %.1f MB/s  RSS %.0f MB  ETA %s",
+	      job.c_str(),events*1e-6,events/wall*1e-3,mbRead()/wall,peakRSS(),eta(wall).c_str());
+     out << line << std::endl;
+   };
+
+   //end of job, where the time went
+   //the scope still running (e.g. the write stage around the output code) counts up to now
+   void summary() const
+   {
+     double wall = elapsed();
+     clock::duration times[int(jobStage::NStages)];
+     std::copy(std::begin(stage_time),std::end(stage_time),times);
+     if(current)
+       times[int(current->stage)] += clock::now() - current->t0;
+     std::stringstream out;
+     char line[256];
+     out << "==== " << job << " summary ====\n";
+     snprintf(line,sizeof(line),"events %ld  wall %.1f s  %.1f kHz  input %.1f MB  %.1f MB/s  peak RSS %.0f MB\n",
+	      events,wall,events/wall*1e-3,mbRead(),mbRead()/wall,peakRSS());
+     out << line;
+     snprintf(line,sizeof(line),"%-10s %10s %8s %12s\n","stage","time [s]","%","ns/event");
+     out << line;
+
+     double timed = 0;
+     for(int i = 0; i < int(jobStage::NStages); i++)
+       {
+	 double t = std::chrono::duration<double>(times[i]).count();
+	 timed += t;
+	 if(t > 0)
+	   {
+	     snprintf(line,sizeof(line),"%-10s %10.2f %8.1f %12.0f\n",stage_names[i],t,100*t/wall,events ? 1e9*t/events : 0.);
+	     out << line;
+	   }
+       }
+     snprintf(line,sizeof(line),"%-10s %10.2f %8.1f\n","untimed",wall - timed,100*(wall - timed)/wall);
+     out << line;
+     std::cerr << out.str();
+
+     if(!json_file.empty())
+       writeJSON(wall,times);
+   };
+
+  private:
+
+   void writeJSON(double wall, const clock::duration *times) const
+   {
+     std::ofstream out(json_file);
+     if(!out.is_open())
+       {
+	 std::cerr << "WARNING:: Could not write job statistics to " << json_file << std::endl;
+	 return;
+       }
+     out << "{\n  \"job\": \"" << job << "\",\n  \"events\": " << events << ",\n  \"wall_s\": " << wall
+	 << ",\n  \"events_per_s\": " << events/wall << ",\n  \"input_mb\": " << mbRead()
+	 << ",\n  \"mb_per_s\": " << mbRead()/wall << ",\n  \"peak_rss_mb\": " << peakRSS() << ",\n  \"stages\": {";
+     for(int i = 0; i < int(jobStage::NStages); i++)
+       out << (i ? ", " : "") << "\"" << stage_names[i] << "\": " << std::chrono::duration<double>(times[i]).count();
+     out << "}\n}\n";
+   };
+
+   double elapsed() const
+   {
+     double t = std::chrono::duration<double>(clock::now() - start).count();
+     return t > 0 ? t : 1e-9;
+   };
+
+   //bytes read by the process (read syscalls, page cache included)
+   static long bytesRead()
+   {
+     std::ifstream io("/proc/self/io");
+     std::string key;
+     long value;
+     while(io >> key >> value)
+       if(key == "rchar:")
+	 return value;
+     return 0;
+   };
+
+   double mbRead() const {return (bytesRead() - start_bytes)*1e-6;};
+
+   static double peakRSS()
+   {
+     struct rusage usage;
+     getrusage(RUSAGE_SELF,&usage);
+     return usage.ru_maxrss*1e-3; //kB on Linux
+   };
+
+   std::string eta(double wall) const
+   {
+     double done = 0;
+     if(total_events > 0)
+       done = double(events)/total_events;
+     else if(input_bytes > 0)
+       done = (bytesRead() - start_bytes)/double(input_bytes);
+     if(done <= 0 || done >= 1)
+       return "-";
+
+     long s = wall*(1 - done)/done;
+     char buf[32];
+     snprintf(buf,sizeof(buf),"%ldh%02ldm%02lds",s/3600,(s/60)%60,s%60);
+     return buf;
+   };
+
+   static constexpr const char* stage_names[int(jobStage::NStages)] = {"read","selection","analysis","fill","write"};
+
+   std::string job;
+   std::string json_file;
+   clock::time_point start;
+   clock::duration stage_time[int(jobStage::NStages)] = {};
+   long events = 0;
+   long total_events = -1;
+   long progress_interval = 100000;
+   long input_bytes = 0;
+   long start_bytes = 0;
+   scope *current = nullptr; //innermost running scope
+ };
+
+ #endif
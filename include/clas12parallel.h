@@ -0,0 +1,134 @@
+ #ifndef CLAS12PARALLEL_HH
+ #define CLAS12PARALLEL_HH
+
+ #include <iostream>
+ #include <vector>
+ #include <memory>
+ #include <thread>
+ #include <functional>
+ #include <algorithm>
+ #include "HipoChain.h"
+ #include "TROOT.h"
+ #include "TH1.h"
+ #include "TString.h"
+ #include "clas12ana.h"
+ #include "clas12prefilter.h"
+
+ //#############
+ //Multi-threaded event loop
+ //Input files are split round robin over the workers, each worker owns its
+ //own HipoChain and a clone of the configured clas12ana. Per-worker output
+ //(histograms, counters) is created by the user and merged at the end.
+ //Splitting is done per file, so use at least as many files as workers.
+ //#############
+
+ class clas12parallel
+ {
+
+  public:
+   clas12parallel(const clas12ana &ana, int nworkers = std::thread::hardware_concurrency()) : ana_template{ana}
+     {
+       n_workers = std::max(1,nworkers);
+     };
+
+   void Add(TString file)                      {files.push_back(file);};
+   void SetReaderTags(std::vector<long> tags)  {reader_tags = tags;};
+   void TurnOffQADB()                          {qadb_off = true;};
+   //configured on the reader of every worker
+   void SetPreFilter(const clas12prefilter &filter)  {prefilter = filter;};
+
+   int getNWorkers() const  {return n_workers;};
+   long getNEvents() const  {long n = 0; for(auto ev : worker_events) n += ev; return n;};
+   const std::vector<long>& getWorkerEvents() const  {return worker_events;};
+
+   //init(worker) builds the per-worker state, process(state,c12,ana) is called for every event
+   //returns the states in worker order so that merging is reproducible
+   template<class State>
+     std::vector<std::unique_ptr<State>> Process(std::function<std::unique_ptr<State>(int)> init,
+						 std::function<void(State&,clas12::clas12reader*,clas12ana&)> process)
+     {
+       int nworkers = std::min<int>(n_workers,std::max<size_t>(1,files.size()));
+
+       ROOT::EnableThreadSafety();
+       //histograms are owned by the worker states, not by the current directory
+       bool add_dir = TH1::AddDirectoryStatus();
+       TH1::AddDirectory(kFALSE);
+
+       //readers, analysers and states are built here serially, only the loop runs in the threads
+       std::vector<std::unique_ptr<clas12root::HipoChain>> chains;
+       anas.clear();
+       std::vector<std::unique_ptr<State>> states;
+       for(int i = 0; i < nworkers; i++)
+	 {
+	   auto chain = std::make_unique<clas12root::HipoChain>();
+	   chain->SetReaderTags(reader_tags);
+	   if(qadb_off)
+	     chain->db()->turnOffQADB();
+	   for(size_t f = i; f < files.size(); f += nworkers)
+	     chain->Add(files[f]);
+	   //the configuration reader is built from the first file
+	   prefilter.configure(chain->GetC12Reader());
+	   chains.push_back(std::move(chain));
+
+	   anas.push_back(ana_template.clone());
+
+	   states.push_back(init(i));
+	 }
+
+       worker_events.assign(nworkers,0);
+       std::vector<std::thread> threads;
+       for(int i = 0; i < nworkers; i++)
+	 threads.emplace_back([&,i]()
+			      {
+				auto &c12 = chains[i]->C12ref();
+				//debug plots are merged in worker order
+				clas12debug::setThreadSlot(i);
+				while(chains[i]->Next())
+				  {
+				    anas[i]->Run(c12);
+				    process(*states[i],c12.get(),*anas[i]);
+				    worker_events[i]++;
+				  }
+			      });
+
+       for(auto &t : threads)
+	 t.join();
+
+       TH1::AddDirectory(add_dir);
+
+       //debug plots of the workers are merged and written with those of the template clas12ana
+       return states;
+     }
+
+   //sum the worker cut flows (CLAS12ANA_CUTFLOW > 0) into ana
+   void MergeCutFlow(clas12ana &ana) const
+   {
+     for(auto &worker : anas)
+       ana.addCutFlow(*worker);
+   }
+
+   //add the per-worker copies of a histogram into the first one
+   static TH1* Merge(const std::vector<TH1*> &hists)
+   {
+     if(hists.empty())
+       return nullptr;
+
+     for(size_t i = 1; i < hists.size(); i++)
+       hists[0]->Add(hists[i]);
+
+     return hists[0];
+   }
+
+  private:
+   const clas12ana &ana_template;
+   int n_workers = 1;
+   bool qadb_off = false;
+   std::vector<TString> files;
+   std::vector<long> reader_tags = {0};
+   clas12prefilter prefilter;
+   std::vector<long> worker_events;
+   std::vector<std::unique_ptr<clas12ana>> anas;
+
+ };
+
+ #endif
@@ -0,0 +1,88 @@
+ #ifndef CLAS12PREFILTER_HH
+ #define CLAS12PREFILTER_HH
+
+ #include <iostream>
+ #include <fstream>
+ #include <sstream>
+ #include <string>
+ #include <vector>
+ #include "clas12reader.h"
+
+ //#############
+ //Event pre-filter on the REC::Particle pids
+ //Each requirement is "pid min_count", e.g. "11 1" (an electron candidate). They are handed
+ //to the reader (clas12reader::addAtLeastPid), which skips failing events before it builds
+ //the region particles, so neither the particles nor the clas12ana cuts are made for them.
+ //The requirements must be looser than the selection, they only remove events early.
+ //#############
+
+ struct prefilterReq
+ {
+   int pid = 0;
+   int min_count = 1;
+ };
+
+ class clas12prefilter
+ {
+
+  public:
+   clas12prefilter(){};
+   clas12prefilter(std::vector<std::string> reqs)
+     {
+       for(auto &r : reqs)
+	 addRequirement(r);
+     };
+
+   void addRequirement(const prefilterReq &req)
+   {
+     if(req.min_count > 0)
+       reqs.push_back(req);
+   };
+
+   //"pid min_count"
+   bool addRequirement(const std::string &line)
+   {
+     std::stringstream ss(line);
+     prefilterReq req;
+
+     if(!(ss >> req.pid >> req.min_count))
+       {
+	 std::cerr << "WARNING:: Bad pre-filter requirement: " << line << " (pid min_count)" << std::endl;
+	 return false;
+       }
+
+     addRequirement(req);
+     return true;
+   };
+
+   void readFile(const char *filename)
+   {
+     std::ifstream infile(filename);
+     if(!infile.is_open())
+       {
+	 std::cerr << "WARNING:: Pre-filter file " << filename << " didn't read in, no pre-filter applied" << std::endl;
+	 return;
+       }
+
+     std::string tp;
+     while(getline(infile, tp))
+       if(!tp.empty() && tp[0] != '#')
+	 addRequirement(tp);
+   };
+
+   bool empty() const {return reqs.empty();};
+   const std::vector<prefilterReq>& getRequirements() const {return reqs;};
+
+   //call with every configuration reader (chain.GetC12Reader()) before the event loop
+   void configure(clas12::clas12reader *c12) const
+   {
+     for(auto &req : reqs)
+       c12->addAtLeastPid(req.pid,req.min_count);
+   };
+
+  private:
+
+   std::vector<prefilterReq> reqs;
+ };
+
+ #endif
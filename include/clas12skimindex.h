@@ -0,0 +1,271 @@
+ #ifndef CLAS12SKIMINDEX_HH
+ #define CLAS12SKIMINDEX_HH
+
+ #include <iostream>
+ #include <fstream>
+ #include <sstream>
+ #include <string>
+ #include <vector>
+ #include <map>
+ #include <memory>
+ #include <algorithm>
+ #include <cstdlib>
+ #include <filesystem>
+ #include "clas12reader.h"
+ #include "HipoChain.h"
+
+ //#############
+ //Event index files, a skim without a copy of the events
+ //The skimmer writes (run, event, file, entry) for each selected event, entry being the
+ //position of the event in its hipo file as read with the reader tags of the index. Without
+ //event filters or QADB this is the number of events read so far in the file. A clas12reader
+ //does not give the position of events it returns after filtering, for a filtered chain
+ //(setFiltered) skimIndexWriter finds the event from that number on with its own reader.
+ //clas12skimindex adds the files of one or more index files to a HipoChain, which is
+ //configured as usual, and iterates the chain's configuration through the selected events
+ //only. The hipo reader index finds the record of each entry, so only the records with
+ //selected events are read (see Ana/example_analysis/read_skim_index.cpp).
+ //Text format, '#' comments, absolute file paths:
+ //  T <tag> ...                     reader tags used when the index was made
+ //  F <file number> <path>
+ //  <run> <event> <file number> <entry>
+ //#############
+
+ struct skimIndexEntry
+ {
+   int run = 0;
+   int event = 0;
+   int file = 0;
+   long entry = 0;
+ };
+
+ //absolute path of a file, so the index can be read from any directory
+ inline std::string skimIndexPath(const std::string &path)
+ {
+   std::error_code ec;
+   auto abs = std::filesystem::absolute(path,ec);
+   return ec ? path : abs.lexically_normal().string();
+ }
+
+ class skimIndexWriter
+ {
+
+  public:
+   skimIndexWriter(const std::string &filename, const std::vector<long> &tags = {}): out{filename}, reader_tags{tags}
+     {
+       if(!out.is_open())
+	 {
+	   std::cerr << "WARNING:: Could not open index file " << filename << std::endl;
+	   return;
+	 }
+       out << "# clas12 skim index: run event file entry\n";
+       if(!tags.empty())
+	 {
+	   out << "T";
+	   for(auto t : tags)
+	     out << " " << t;
+	   out << "\n";
+	 }
+     };
+
+   bool isOpen() const {return out.is_open();};
+   //the chain skips events (event filters, QADB), the positions are then searched
+   void setFiltered(bool f) {filtered = f;};
+
+   //the current event of c12, read_entry the number of events c12 returned before it
+   //in this file, which is its position unless the chain is filtered
+   bool add(const clas12::clas12reader &c12, long read_entry)
+   {
+     int run = c12.runconfig()->getRun();
+     int event = c12.runconfig()->getEvent();
+     std::string file = c12.getFilename();
+     if(!filtered)
+       {
+	 add(file,read_entry,run,event);
+	 return true;
+       }
+
+     if(file != located_file)
+       {
+	 located_file = file;
+	 locator.reset(new clas12::clas12reader(c12,file,reader_tags));
+	 skipped = 0;
+       }
+
+     //events skipped by the reader before this one, they only add up within a file
+     for(long entry = read_entry + skipped; locator->grabEvent(entry); entry++)
+       if(locator->runconfig()->getRun() == run && locator->runconfig()->getEvent() == event)
+	 {
+	   skipped = entry - read_entry;
+	   add(file,entry,run,event);
+	   return true;
+	 }
+
+     std::cerr << "WARNING:: Run " << run << " event " << event << " not found in " << file
+	       << " from entry " << read_entry + skipped << ", not written to the index" << std::endl;
+     return false;
+   };
+
+   //an event at a known position of its file
+   void add(const std::string &file, long entry, int run, int event)
+   {
+     if(file != last_file)
+       {
+	 std::string path = skimIndexPath(file);
+	 auto it = file_numbers.find(path);
+	 if(it == file_numbers.end())
+	   {
+	     it = file_numbers.emplace(path,file_numbers.size()).first;
+	     out << "F " << it->second << " " << path << "\n";
+	   }
+	 last_file = file;
+	 last_number = it->second;
+       }
+     out << run << " " << event << " " << last_number << " " << entry << "\n";
+     entries++;
+   };
+
+   long size() const {return entries;};
+   void close() {out.close();};
+
+  private:
+   std::ofstream out;
+   std::vector<long> reader_tags;
+   std::map<std::string,int> file_numbers;
+   std::string last_file;
+   int last_number = -1;
+   long entries = 0;
+   bool filtered = true;
+
+   std::unique_ptr<clas12::clas12reader> locator;
+   std::string located_file;
+   long skipped = 0;
+ };
+
+ class clas12skimindex
+ {
+
+  public:
+   //the files of the index are added to chain, configure it (banks, filters) as usual
+   clas12skimindex(clas12root::HipoChain &ch): chain{ch} {};
+   clas12skimindex(clas12root::HipoChain &ch, const char *filename): chain{ch}
+     {
+       readFile(filename);
+     };
+
+   //can be called for several index files before the loop
+   bool readFile(const char *filename)
+   {
+     std::ifstream in(filename);
+     if(!in.is_open())
+       {
+	 std::cerr << "WARNING:: Index file " << filename << " didn't read in" << std::endl;
+	 return false;
+       }
+
+     std::map<int,int> numbers; //file number in this index to position in files
+     std::string line;
+     while(getline(in,line))
+       {
+	 if(line.empty() || line[0] == '#')
+	   continue;
+
+	 std::stringstream ss(line);
+	 if(line[0] == 'T')
+	   {
+	     char t;
+	     long tag;
+	     ss >> t;
+	     tags.clear();
+	     while(ss >> tag)
+	       tags.push_back(tag);
+	   }
+	 else if(line[0] == 'F')
+	   {
+	     char f;
+	     int number;
+	     std::string path;
+	     ss >> f >> number;
+	     getline(ss >> std::ws,path);
+	     numbers[number] = addFile(path);
+	   }
+	 else
+	   {
+	     skimIndexEntry e;
+	     if(!(ss >> e.run >> e.event >> e.file >> e.entry) || numbers.count(e.file) == 0)
+	       {
+		 std::cerr << "WARNING:: Bad line in index file " << filename << ": " << line << std::endl;
+		 continue;
+	       }
+	     e.file = numbers[e.file];
+	     entries.push_back(e);
+	   }
+       }
+
+     //file by file in entry order, records are read once and forwards
+     std::stable_sort(entries.begin(),entries.end(),[](const skimIndexEntry &a, const skimIndexEntry &b)
+		      {return a.file < b.file || (a.file == b.file && a.entry < b.entry);});
+     return true;
+   };
+
+   //tags of the readers, by default those stored in the index
+   void SetReaderTags(const std::vector<long> &t) {tags = t;};
+
+   //while(index.Next()), like HipoChain::Next
+   bool Next()
+   {
+     while(++position < (long)entries.size())
+       {
+	 const skimIndexEntry &e = entries[position];
+	 if(e.file != current_file)
+	   {
+	     current_file = e.file;
+	     c12.reset(new clas12::clas12reader(*chain.GetC12Reader(),files[e.file],tags));
+	   }
+
+	 if(!c12->grabEvent(e.entry))
+	   {
+	     std::cerr << "WARNING:: Entry " << e.entry << " not found in " << files[e.file] << ". Aborting..." << std::endl;
+	     exit(-2);
+	   }
+	 if(c12->runconfig()->getRun() != e.run || c12->runconfig()->getEvent() != e.event)
+	   {
+	     std::cerr << "WARNING:: Index entry " << e.entry << " of " << files[e.file] << " is run " << c12->runconfig()->getRun()
+		       << " event " << c12->runconfig()->getEvent() << ", expected " << e.run << " " << e.event
+		       << ". Was the index made with other reader tags or was the file changed? Aborting..." << std::endl;
+	     exit(-2);
+	   }
+	 return true;
+       }
+     return false;
+   };
+
+   //reference to the reader of the current event, valid across file changes
+   const std::unique_ptr<clas12::clas12reader>& C12ref() const {return c12;};
+
+   const skimIndexEntry& getEntry() const {return entries[position];};
+   const std::vector<std::string>& getFiles() const {return files;};
+   long size() const {return entries.size();};
+
+  private:
+
+   int addFile(const std::string &path)
+   {
+     auto it = std::find(files.begin(),files.end(),path);
+     if(it != files.end())
+       return it - files.begin();
+     files.push_back(path);
+     chain.Add(path.c_str());
+     return files.size() - 1;
+   };
+
+   clas12root::HipoChain &chain;
+   std::vector<std::string> files;
+   std::vector<skimIndexEntry> entries;
+   std::vector<long> tags;
+   std::unique_ptr<clas12::clas12reader> c12;
+   long position = -1;
+   int current_file = -1;
+ };
+
+ #endif
@@ -0,0 +1,131 @@
+ #ifndef CLAS12SRCKIN_HH
+ #define CLAS12SRCKIN_HH
+
+ #include <vector>
+ #include <cmath>
+ #include <algorithm>
+ #include "TMath.h"
+ #include "TLorentzVector.h"
+ #include "clas12reader.h"
+ #include "region_particle.h"
+
+ //#############
+ //Plain four-vector and a batch kernel for the (e,e'p) SRC kinematics of all
+ //protons in an event (p, pmiss, mmiss, theta_pq, |p|/|q|), stored as one array
+ //per quantity. The arithmetic follows TLorentzVector/TVector3 (SetXYZM, P, M,
+ //Angle, Mag) so the values are the same as computing them one proton at a time.
+ //Header only, it needs the ROOT and clas12root headers but no library of this
+ //repository, so that it can also be used from ROOT macros.
+ //#############
+
+ struct fourVec
+ {
+   double px = 0;
+   double py = 0;
+   double pz = 0;
+   double e  = 0;
+
+   static fourVec fromXYZM(double x, double y, double z, double m)
+   {
+     fourVec v;
+     v.px = x; v.py = y; v.pz = z;
+     v.e  = (m >= 0) ? std::sqrt(x*x+y*y+z*z+m*m) : std::sqrt(std::max((x*x+y*y+z*z-m*m),0.));
+     return v;
+   }
+
+   static fourVec fromTLorentz(const TLorentzVector &v)
+   {
+     fourVec f;
+     f.px = v.Px(); f.py = v.Py(); f.pz = v.Pz(); f.e = v.E();
+     return f;
+   }
+
+   fourVec operator+(const fourVec &o) const  {fourVec v; v.px = px + o.px; v.py = py + o.py; v.pz = pz + o.pz; v.e = e + o.e; return v;}
+   fourVec operator-(const fourVec &o) const  {fourVec v; v.px = px - o.px; v.py = py - o.py; v.pz = pz - o.pz; v.e = e - o.e; return v;}
+
+   double mag2() const  {return px*px + py*py + pz*pz;}
+   double p() const     {return std::sqrt(mag2());}
+   double m2() const    {return e*e - mag2();}
+   double m() const     {double mm = m2(); return mm < 0.0 ? -std::sqrt(-mm) : std::sqrt(mm);}
+ };
+
+
+ struct srcKinematics
+ {
+   //inputs, one entry per proton
+   std::vector<double> px, py, pz;
+   std::vector<double> p_bank; //momentum as returned by the particle bank
+
+   //outputs, one entry per proton
+   std::vector<double> mom;      //|p|
+   std::vector<double> pmiss;    //|beam + target - e' - p|
+   std::vector<double> mmiss;    //missing mass
+   std::vector<double> theta_pq; //angle between p and q in degrees
+   std::vector<double> p_q;      //|p|/|q|
+
+   int size() const  {return px.size();}
+
+   //copy the proton momenta into the input arrays
+   void setParticles(const std::vector<clas12::region_part_ptr> &particles)
+   {
+     int n = particles.size();
+     px.resize(n); py.resize(n); pz.resize(n); p_bank.resize(n);
+     for(int i = 0; i < n; i++)
+       {
+	 p_bank[i] = particles[i]->par()->getP();
+	 px[i] = particles[i]->par()->getPx();
+	 py[i] = particles[i]->par()->getPy();
+	 pz[i] = particles[i]->par()->getPz();
+       }
+   }
+
+   void compute(const TLorentzVector &beam, const TLorentzVector &target, const TLorentzVector &el, double mass)
+   {
+     fourVec b = fourVec::fromTLorentz(beam);
+     fourVec t = fourVec::fromTLorentz(target);
+     fourVec e = fourVec::fromTLorentz(el);
+     compute(b + t - e, b - e, mass);
+   }
+
+   //miss_base = beam + target - e', the missing four-vector is miss_base - p
+   void compute(const fourVec &miss_base, const fourVec &q, double mass)
+   {
+     int n = size();
+     mom.resize(n); pmiss.resize(n); mmiss.resize(n); theta_pq.resize(n); p_q.resize(n);
+
+     double q_mag2 = q.mag2();
+     double q_mag  = std::sqrt(q_mag2);
+     double mass2  = mass*mass;
+     double rad_to_deg = TMath::RadToDeg();
+
+     const double *x = px.data();
+     const double *y = py.data();
+     const double *z = pz.data();
+
+     for(int i = 0; i < n; i++)
+       {
+	 double p_mag2 = x[i]*x[i] + y[i]*y[i] + z[i]*z[i];
+	 double p_e    = std::sqrt(p_mag2 + mass2);
+
+	 double mx = miss_base.px - x[i];
+	 double my = miss_base.py - y[i];
+	 double mz = miss_base.pz - z[i];
+	 double me = miss_base.e  - p_e;
+	 double miss_mag2 = mx*mx + my*my + mz*mz;
+	 double mm = me*me - miss_mag2;
+
+	 mom[i]   = std::sqrt(p_mag2);
+	 pmiss[i] = std::sqrt(miss_mag2);
+	 mmiss[i] = mm < 0.0 ? -std::sqrt(-mm) : std::sqrt(mm);
+	 p_q[i]   = mom[i]/q_mag;
+
+	 //TVector3::Angle
+	 double ptot2 = p_mag2*q_mag2;
+	 double arg = ptot2 <= 0 ? 1.0 : (x[i]*q.px + y[i]*q.py + z[i]*q.pz)/std::sqrt(ptot2);
+	 arg = arg > 1.0 ? 1.0 : (arg < -1.0 ? -1.0 : arg);
+	 theta_pq[i] = (ptot2 <= 0 ? 0.0 : std::acos(arg)) * rad_to_deg;
+       }
+   }
+ };
+
+ #endif
@@ -0,0 +1,121 @@
+ #ifndef CLAS12SYNTH_HH
+ #define CLAS12SYNTH_HH
+
+ #include <string>
+ #include <vector>
+ #include <memory>
+ #include <TRandom3.h>
+ #include "clas12reader.h"
+ #include "writer.h"
+
+ //#############
+ //Synthetic event source
+ //Fabricates REC::Particle, REC::Calorimeter, REC::Scintillator, REC::Cherenkov, REC::Traj,
+ //REC::Track, REC::Event, RUN::config and MC::Lund banks with configurable multiplicities and
+ //kinematics. The clas12reader only reads through hipo::reader, so the events are made in
+ //memory and streamed to a HIPO file, by default in /dev/shm, which is then opened by a
+ //normal clas12reader or HipoChain. Everything downstream (clas12ana::Run, eventcut, the
+ //veto functions) sees exactly the same interface as for data.
+ //The detector responses are simple parameterisations meant for timing and regression
+ //tests, not for physics.
+ //#############
+
+ //one generated particle species, the multiplicity per event is Poisson distributed
+ struct synthSpecies
+ {
+   int pid = 2212;
+   double mean_mult = 1;
+   double mom_min = 0.3;   //GeV/c, uniform
+   double mom_max = 2.5;
+   double theta_min = 10;  //degrees, uniform in cos(theta)
+   double theta_max = 120;
+ };
+
+ struct synthConfig
+ {
+   int run = 11;              //MC run number by default, set a data run to test the run ranges
+   double beam_energy = 5.98;
+   unsigned int seed = 12345;
+
+   //trigger electron, in the FD
+   double electron_prob = 0.95;
+   double el_mom_min = 1;
+   double el_mom_max = 5.5;
+   double el_theta_min = 8;
+   double el_theta_max = 35;
+
+   //other particles, theta above cd_theta goes to the CD
+   std::vector<synthSpecies> species = {{2212,1.2,0.3,3,10,120},{2112,0.4,0.2,2,10,120},
+					{211,0.3,0.2,2,10,120},{-211,0.3,0.2,2,10,120},
+					{22,0.8,0.1,2,5,40},{45,0.02,0.3,2,10,100}};
+   double cd_theta = 35;
+
+   //vertex and resolutions
+   double vz_mean = -3;
+   double vz_sigma = 1.5;
+   double vxy_sigma = 0.1;
+   double mom_resolution = 0.01; //relative
+   double time_resolution = 0.1; //ns
+   double start_time = 124.25;   //ns
+ };
+
+ class clas12synth
+ {
+
+  public:
+   clas12synth(synthConfig c = synthConfig());
+   ~clas12synth();
+
+   //fabricates nevents events into filename, false if the file cannot be written
+   bool write(const std::string &filename, long nevents);
+
+   //same into a file in /dev/shm (TMPDIR if there is no /dev/shm), removed by the destructor
+   std::string writeTemp(long nevents);
+
+   //reader on nevents new events, used exactly like a reader on a data file
+   std::unique_ptr<clas12::clas12reader> makeReader(long nevents, std::vector<long> tags = {});
+
+   //fills the banks of one event
+   void fill(hipo::event &event);
+
+   const synthConfig& getConfig() const {return config;};
+
+  private:
+
+   struct genParticle
+   {
+     int pid;
+     double mass;
+     int charge;
+     double p[3];
+     double v[3];
+   };
+
+   void addParticle(const genParticle &gen, bool trigger);
+   int addDetectors(int pindex, const genParticle &gen, const double p[3], int region, double beta);
+   genParticle generate(int pid, double mom_min, double mom_max, double theta_min, double theta_max);
+   static int sectorOf(double phi);
+
+   synthConfig config;
+   TRandom3 rand;
+   long event_number = 0;
+   std::vector<std::string> temp_files;
+
+   //bank definitions as in Kitchen/bankdefs/hipo4, REC::Traj with the edge column
+   enum {s_run, s_event, s_part, s_cal, s_che, s_sci, s_trk, s_traj, s_ft, s_mcevent, s_lund, n_schemas};
+   std::vector<hipo::schema> schemas;
+   double vertex[3] = {};
+
+   //rows of the current event, written to the banks at the end of fill
+   struct particleRow {int pid; float p[3]; float v[3]; float vt; int charge; float beta; float chi2pid; int status;};
+   struct detRow {int pindex; int detector; int sector; int layer; float energy; float time; float path; float x; float y; float z; float lu; float lv; float lw; float nphe; float edge; int charge; float chi2; int ndf;};
+   std::vector<particleRow> particles;
+   std::vector<detRow> cal_rows;
+   std::vector<detRow> che_rows;
+   std::vector<detRow> sci_rows;
+   std::vector<detRow> traj_rows;
+   std::vector<detRow> trk_rows;
+   std::vector<genParticle> lund;
+ };
+
+ #endif
@@ -0,0 +1,104 @@
+ #ifndef CLAS12TRAJCACHE_HH
+ #define CLAS12TRAJCACHE_HH
+
+ #include <vector>
+ #include "clas12reader.h"
+ #include "region_particle.h"
+
+ //#############
+ //Per-event cache of the REC::Traj quantities used by the fiducial cuts,
+ //the debug plots and the neutron veto: edge and hit position at
+ //DC layers 6/18/36 and CVT layers 1/3/5/7/12.
+ //Each particle is looked up once per event (per detector), keyed by its
+ //REC::Particle index. Clear() must be called at the start of each event.
+ //#############
+
+ struct trajPoint
+ {
+   double x = 0;
+   double y = 0;
+   double z = 0;
+   double edge = 0;
+ };
+
+ struct trajInfo
+ {
+   enum {dc_r1, dc_r2, dc_r3};
+   enum {cvt_1, cvt_3, cvt_5, cvt_7, cvt_12};
+
+   trajPoint dc[3];  //layers 6,18,36
+   trajPoint cvt[5]; //layers 1,3,5,7,12
+   bool has_dc  = false;
+   bool has_cvt = false;
+ };
+
+ class clas12trajcache
+ {
+
+  public:
+   static constexpr int dc_layers[3]  = {6,18,36};
+   static constexpr int cvt_layers[5] = {1,3,5,7,12};
+
+   void Clear()
+   {
+     for(auto &t : cache)
+       t.has_dc = t.has_cvt = false;
+   }
+
+   const trajInfo& dc(const clas12::region_part_ptr &p)
+   {
+     trajInfo &t = at(p);
+     if(!t.has_dc)
+       fillDC(p,t);
+     return t;
+   }
+
+   const trajInfo& cvt(const clas12::region_part_ptr &p)
+   {
+     trajInfo &t = at(p);
+     if(!t.has_cvt)
+       fillCVT(p,t);
+     return t;
+   }
+
+   //direct bank lookups, used to fill the cache
+   static void fillDC(const clas12::region_part_ptr &p, trajInfo &t)
+   {
+     for(int i = 0; i < 3; i++)
+       {
+	 auto traj = p->traj(clas12::DC,dc_layers[i]);
+	 t.dc[i].x = traj->getX();
+	 t.dc[i].y = traj->getY();
+	 t.dc[i].z = traj->getZ();
+	 t.dc[i].edge = traj->getFloat("edge",traj->getIndex());
+       }
+     t.has_dc = true;
+   }
+
+   static void fillCVT(const clas12::region_part_ptr &p, trajInfo &t)
+   {
+     for(int i = 0; i < 5; i++)
+       {
+	 auto traj = p->traj(clas12::CVT,cvt_layers[i]);
+	 t.cvt[i].x = traj->getX();
+	 t.cvt[i].y = traj->getY();
+	 t.cvt[i].z = traj->getZ();
+	 t.cvt[i].edge = traj->getEdge();
+       }
+     t.has_cvt = true;
+   }
+
+  private:
+   trajInfo& at(const clas12::region_part_ptr &p)
+   {
+     size_t index = p->par()->getIndex();
+     if(index >= cache.size())
+       cache.resize(index + 1);
+     return cache[index];
+   }
+
+   std::vector<trajInfo> cache;
+
+ };
+
+ #endif
@@ -1,5 +1,13 @@
 #include "clas12ana.h"
 
+std::vector<region_part_ptr> clas12ana::* const clas12ana::pid_buckets[clas12ana::n_pid_buckets] =
+  {&clas12ana::electrons, &clas12ana::protons, &clas12ana::neutrons, &clas12ana::deuterons, &clas12ana::piplus,
+   &clas12ana::piminus, &clas12ana::kplus, &clas12ana::kminus, &clas12ana::neutrals, &clas12ana::otherpart};
+
+const char* const clas12ana::cut_names[static_cast<int>(CutId::NCuts)] =
+  {"Nphe", "EcalSF", "EcalP", "EcalDiag", "EcalEdge", "ElMom", "Pid", "ProtonPid",
+   "Vertex", "DCEdge", "CDEdge", "CDRegion", "VertexCorr", "GhostTrack"};
+
 struct cutpar{
   std::string id;
   std::vector<double> par = {}; //pi- parameters
@@ -44,20 +52,18 @@ int clas12ana::getCDRegion(const region_part_ptr &p)
 
 void clas12ana::Clear()
  {
-   electrons.clear();
-   protons.clear();
-   deuterons.clear();
-   neutrals.clear();
-   neutrons.clear();
-   piplus.clear();
-   piminus.clear();
-   kplus.clear();
-   kminus.clear();
-   otherpart.clear();
+   for(auto bucket : pid_buckets)
+     (this->*bucket).clear();
+
 
    lead_proton.clear();
    recoil_proton.clear();
 
+   cut_masks.clear();
+   trigger_el = nullptr;
+   proton_candidates.clear();
+   traj_cache.Clear();
+
    current_run = -1;
    beam_energy = 0;
    event_mult = 0;
@@ -66,142 +72,137 @@ void clas12ana::Clear()
 
 void clas12ana::Run(const std::unique_ptr<clas12::clas12reader>& c12)
 {
-  Clear();
-  current_run = c12->runconfig()->getRun();
-  checkCutParameters(); //check run number has the right cuts 
+  Run<runtimeCuts>(c12);
+}
 
 
+cutMask& clas12ana::cutMaskAt(const region_part_ptr &p)
+{
+  size_t idx = p->par()->getIndex();
+  if(idx >= cut_masks.size())
+    cut_masks.resize(idx + 1);
 
-  auto particles = c12->getDetParticles(); //particles is now a std::vector of particles for this event
-  auto electrons_det = c12->getByID(11);
+  return cut_masks[idx];
+}
 
-  //DEBUG plots
-  if(debug_plots)
-    {
-      for(auto el : electrons_det)
-	debug_c.fillBeforeEl(el);
-    }
-  
-  std::for_each(electrons_det.begin(),electrons_det.end(),[this](auto el)
-		{
-		  if(!((el->che(HTCC)->getNphe() <= 2)           || //Photo electron min cut
-		       (!checkEcalSFCuts(el)   && f_ecalSFCuts)  || //ECAL SF cuts
-		       (!checkEcalPCuts(el)    && f_ecalPCuts)   || //ECAL SF cuts
-		       (!checkEcalDiagCuts(el) && f_ecalDiagCuts)|| //ECAL Diagonoal SF cuts
-		       (!EcalEdgeCuts(el) && f_ecalEdgeCuts)     || //ECAL edge cuts
-		       (!checkVertex(el)  && f_vertexCuts)       || //Vertex cut
-		       (!DCEdgeCuts(el)   && f_DCEdgeCuts)       || //DC edge cut
-		       (el->par()->getP() < 0.8)) ) // minium 800 MeV/c cut for electrons in class     
-		    setByPid(el);
-		});
-  
-  
-  if(debug_plots)
-    {
-      for(auto el : electrons)
-	debug_c.fillAfterEl(el);
-    }
-  
-  
-  if(electrons.size() == 1) //good trigger electron
-    {
-      
-      if(debug_plots)
-	{
-	  for(auto p : particles)
-	    if(p->par()->getPid() == 2212 || p->par()->getPid() == -211 || p->par()->getPid() == 211)
-	      debug_c.fillBeforePart(p);
-	}
-      
-      
-      /*
-	This may be a strange way to check the cuts, maybe there is a better way
-	We need to ensure that the flag f_cuts is on otherwise we don't want to apply any cut
-	The below logic will return particles that did not pass any cut (for only cut flags that are on
-	Then I will invert the logic using !(logic) to return when the particle do pass all cuts
-	
-	(!checkPidCut(p) && f_pidCuts)    ||	         //PID cuts
-	(!checkVertex(p) && f_vertexCuts) ||  //Vertex cut
-	(!CDEdgeCuts(p)  && f_CDEdgeCuts) ||  //CD edge cut
-	(!CDRegionCuts(p)  && f_CDRegionCuts) ||  //CD edge cut
-	(!DCEdgeCuts(p) && f_DCEdgeCuts)  || //DC edge cut
-	(!checkVertexCorrelation(electrons_det[0],p) && f_corr_vertexCuts) //Vertex correlation cut between electron
-      */
-      
-      std::for_each(particles.begin(),particles.end(),[this,electrons_det](auto p)
-		    {
-		      //neutrals and electrons don't follow cuts below, skip them 
-		      if(p->par()->getCharge() == 0 && p->par()->getPid() != 11 )
-			{
-			  setByPid(p);
-			  return;
-			}
-		      else if(p->par()->getPid() != 11  && electrons.size() > 0)
-			{
-			  ++event_mult;	//charge particles
-
-
-			  bool check_pid_cuts = ((f_protonpidCuts && checkProtonPidCut(p)) || //check if in proton PID cuts or chi2pid cuts
-						 (f_pidCuts && checkPidCut(p))             || // if proton pid cuts if off but pid cuts on just use chi2pid
-						 (!f_protonpidCuts && !f_pidCuts));           // if no pid cuts are specified let all particles pass pid 
-			  
-			  if( !( (!check_pid_cuts)                    || //PID cuts
-				 (!checkVertex(p)  && f_vertexCuts)   || //Vertex cut
-				 (!CDEdgeCuts(p)   && f_CDEdgeCuts)   || //CD edge cut
-				 (!CDRegionCuts(p) && f_CDRegionCuts) || //CD edge cut
-				 (!DCEdgeCuts(p)   && f_DCEdgeCuts)   || //DC edge cut
-				 (!checkVertexCorrelation(electrons_det[0],p) && f_corr_vertexCuts)) ) //Vertex correlation cut between electron
-			    setByPid(p);
-			}
-		    });
-      
-      
-      if(debug_plots)
-	{
-	  
-	  for(auto p : protons)
-	    debug_c.fillAfterPart(p);
-	  for(auto p : piplus)
-	    debug_c.fillAfterPart(p);
-	  for(auto p : piminus)
-	    debug_c.fillAfterPart(p);
-	  
-	  for(auto el : electrons)
-	    debug_c.fillAfterEl(el);
-	  
-	}
+cutMask clas12ana::getCutMask(const region_part_ptr &p) const
+{
+  size_t idx = p->par()->getIndex();
+  if(idx < cut_masks.size())
+    return cut_masks[idx];
 
-    }//good electron loop
-  
-  
+  return cutMask();
 }
 
+void clas12ana::setCutResult(const region_part_ptr &p, CutId cut, bool pass)
+{
+  unsigned int bit = 1u << static_cast<unsigned int>(cut);
+  cutMask &mask = cutMaskAt(p);
+
+  mask.evaluated |= bit;
+  if(pass)
+    mask.passed |= bit;
+  else
+    mask.passed &= ~bit;
+}
+
+void clas12ana::selectElectrons(electronBlock &block, int run)
+{
+  current_run = run;
+  checkCutParameters();
+  block.select(getElectronCutPars());
+}
+
+bool clas12ana::passed(const region_part_ptr &p, CutId cut)
+{
+  //true if inside cut; every cut is evaluated once per particle and event
+  return passed(p,cut,[&]{return evaluateCut(p,cut);});
+}
+
+bool clas12ana::evaluateCut(const region_part_ptr &p, CutId cut)
+{
+  switch(cut)
+    {
+    case CutId::Nphe:
+      return !(p->che(HTCC)->getNphe() <= 2);
+    case CutId::EcalSF:
+      return checkEcalSFCuts(p);
+    case CutId::EcalP:
+      return checkEcalPCuts(p);
+    case CutId::EcalDiag:
+      return checkEcalDiagCuts(p);
+    case CutId::EcalEdge:
+      return EcalEdgeCuts(p);
+    case CutId::ElMom:
+      return !(p->par()->getP() < 0.8);
+    case CutId::Pid:
+      return checkPidCut(p);
+    case CutId::ProtonPid:
+      return checkProtonPidCut(p);
+    case CutId::Vertex:
+      return checkVertexAs<runtimeCuts>(p);
+    case CutId::DCEdge:
+      return DCEdgeCuts(p);
+    case CutId::CDEdge:
+      return CDEdgeCuts(p);
+    case CutId::CDRegion:
+      return CDRegionCuts(p);
+    case CutId::VertexCorr:
+      return trigger_el == nullptr || checkVertexCorrelation(trigger_el,p);
+    case CutId::GhostTrack:
+      return !checkGhostTrackCD(p);
+    default:
+      return true;
+    }
+}
 
 
 void clas12ana::InitSFEcalCuts()
 {
-  //  cout<<"PARAMETERS for SF vs Ecal cuts"<<endl;
-   for(int i = 1; i < 7; i++)
+   ecal_sf_table.set(ecal_sf_fcn_par,sigma_cut);
+}
+
+void clas12ana::buildSFFunctions()
+{
+   for(int i = 0; i < 7; i++)
     {
+      if(!ecal_sf_mean_fcn[i])
+	{
+	  ecal_sf_mean_fcn[i] = new TF1(Form("ecal_sf_mean_fcn_%d",i),"[0] + [1]/x + [2]/pow(x,2)",0,1.5);
+	  ecal_sf_fcn[0][i] = new TF1(Form("ecal_sf_fcn_0_%d",i),"[0] + [1]/x + [2]/pow(x,2) - [6]*( [3] + [4]/x + [5]/pow(x,2))",0,1.5);
+	  ecal_sf_fcn[1][i] = new TF1(Form("ecal_sf_fcn_1_%d",i),"[0] + [1]/x + [2]/pow(x,2) + [6]*( [3] + [4]/x + [5]/pow(x,2))",0,1.5);
+
+	  ecal_p_mean_fcn[i] = new TF1(Form("ecal_p_mean_fcn_%d",i),"[0] + [1]/x + [2]/pow(x,2)",0,10);
+	  ecal_p_fcn[0][i] = new TF1(Form("ecal_p_fcn_0_%d",i),"[0] + [1]/x + [2]/pow(x,2) - [6]*( [3] + [4]/x + [5]/pow(x,2))",0,10);
+	  ecal_p_fcn[1][i] = new TF1(Form("ecal_p_fcn_1_%d",i),"[0] + [1]/x + [2]/pow(x,2) + [6]*( [3] + [4]/x + [5]/pow(x,2))",0,10);
+	}
+
       for(int j = 0; j < 6; j++)
 	{
 	  if(j < 4)
-	    ecal_sf_mean_fcn[i]->SetParameter(j,ecal_sf_fcn_par[i][j]); //only first 3 parameters involve mean
+	    {
+	      ecal_sf_mean_fcn[i]->SetParameter(j,ecal_sf_fcn_par[i][j]); //only first 3 parameters involve mean
+	      ecal_p_mean_fcn[i]->SetParameter(j,ecal_p_fcn_par[i][j]);
+	    }
 
-	  //	  cout<<"sector "<<i <<" j "<<j<<" par "<<ecal_sf_fcn_par[i][j]<<endl;
 	  ecal_sf_fcn[0][i]->SetParameter(j,ecal_sf_fcn_par[i][j]);
 	  ecal_sf_fcn[1][i]->SetParameter(j,ecal_sf_fcn_par[i][j]);
+	  ecal_p_fcn[0][i]->SetParameter(j,ecal_p_fcn_par[i][j]);
+	  ecal_p_fcn[1][i]->SetParameter(j,ecal_p_fcn_par[i][j]);
 	}
 
-      ecal_sf_fcn[0][i]->SetParameter(6,sigma_cut);
-      ecal_sf_fcn[1][i]->SetParameter(6,sigma_cut);
+      for(int k = 0; k < 2; k++)
+	{
+	  ecal_sf_fcn[k][i]->SetParameter(6,sigma_cut);
+	  ecal_p_fcn[k][i]->SetParameter(6,sigma_cut);
+	}
     }
 }
 
-
-
 void clas12ana::WriteSFEcalCuts()
 {
+  buildSFFunctions();
+
   TFile file_ecal("ecalSFcuts.root","RECREATE");
    for(int i = 1; i < 7; i++)
     {
@@ -226,131 +227,87 @@ void clas12ana::WriteSFEcalCuts()
 
 void clas12ana::InitSFPCuts()
 {
-  //   cout<<"PARAMETERS for SF vs P cuts"<<endl;
-   for(int i = 1; i < 7; i++)
-    {
-      for(int j = 0; j < 6; j++)
-	{
-	  if(j < 4)
-	    ecal_p_mean_fcn[i]->SetParameter(j,ecal_p_fcn_par[i][j]); //only first 3 parameters for mean value
-
-	  //	  cout<<"sector "<<i <<" j "<<j<<" par "<<ecal_p_fcn_par[i][j]<<endl;
-	  ecal_p_fcn[0][i]->SetParameter(j,ecal_p_fcn_par[i][j]);
-	  ecal_p_fcn[1][i]->SetParameter(j,ecal_p_fcn_par[i][j]);
-	}
-
-      ecal_p_fcn[0][i]->SetParameter(6,sigma_cut);
-      ecal_p_fcn[1][i]->SetParameter(6,sigma_cut);
-    }
-
+   ecal_p_table.set(ecal_p_fcn_par,sigma_cut);
 
 }
 
 void clas12ana::checkCutParameters()
 {
-  //This next section sets the Sampling Fraction cuts; pass1 data has two SF regions
-  //< 15542 and >=15542 based on the SF timelines
-  //Defualt SF cuts are set in Init() function and is the < 15542 events
-  if(current_run >= 15542)
-    {
-      if(previous_run < 15542) //default; do nothing already been set to >=15542
-	{
-	  //Set new SF cuts, new run range
-	  this -> readEcalSFPar( (std::string(CLAS12ANA_DIR) +"/Ana/cutFiles/paramsSF_40Ca_x2.dat").c_str() );
-	  this -> readEcalPPar( (std::string(CLAS12ANA_DIR) +"/Ana/cutFiles/paramsPI_40Ca_x2.dat").c_str());
-	  std::cerr << "WARNING:: Run number changed to " << current_run <<". The SF cuts are changed to reflect this new run range" << std::endl;
-	}
-    }
-
-  //note run ranges cover all possible ranges for a given target
-  // the production runs is some subet of the full range
-  //Here we check the previous run and the current run, if the current run differs
-  //then we need to set a new set of par files
-  bool h_runrange    = (current_run >= 15016 && current_run <= 15042);
-  bool d_runrange    = ((current_run >= 15043 && current_run <= 15106) || (current_run >= 15433 && current_run <= 15456));
-  bool he_runrange   = ((current_run >= 15108 && current_run <= 15164) || (current_run >= 15458 && current_run <= 15490));
-  bool cx4_runrange  = (current_run >= 15178 && current_run <= 15317);
-  bool snx4_runrange = (current_run >= 15318 && current_run <= 15328);
-  bool ca40_runrange = (current_run >= 15355 && current_run <= 15432);
-  bool ca48_runrange = (current_run >= 15829 && current_run <= 15884);
-
-  bool h_runrange_prev    = (previous_run >= 15016 && previous_run <= 15042);
-  bool d_runrange_prev    = ((previous_run >= 15043 && previous_run <= 15106) || (previous_run >= 15433 && previous_run <= 15456));
-  bool he_runrange_prev   = ((previous_run >= 15108 && previous_run <= 15164) || (previous_run >= 15458 && previous_run <= 15490));
-  bool cx4_runrange_prev  = (previous_run >= 15178 && previous_run <= 15317);
-  bool snx4_runrange_prev = (previous_run >= 15318 && previous_run <= 15328);
-  bool ca40_runrange_prev = (previous_run >= 15355 && previous_run <= 15432);
-  bool ca48_runrange_prev = (previous_run >= 15829 && previous_run <= 15884);
-
-
   //for some reason first 3-4 events are always run 0
   //they seem to always have 0 particles so maybe they are headers; do nothing here
-  if(current_run == 0)
+  //the parameters only need to be looked up when the run changes
+  if(current_run == 0 || current_run == current_cut_run)
     return;
 
-  //MC runs are always run 11 per CLAS default
+  current_cut_run = current_run;
+  previous_run = current_run;
+
+  //The parameter sets for each run range are read once in Init (Ana/cutFiles/run_ranges.par)
+  //note run ranges cover all possible ranges for a given target
+  //the SF cuts have two regions < 15542 and >=15542 based on the SF timelines
+  //MC runs are always run 11 per CLAS default and are in no range
   //We assume the USER must supply the parameter file inline in the analysis code
-  //Since the MC run# is always 11 there is no automatic feature
-  
-  if(he_runrange && !he_runrange_prev)
-    {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_he4.par file." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_he4.par").c_str() );
-    }
-  else if(ca40_runrange && !ca40_runrange_prev)
-    {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_ca40.par file." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_ca40.par").c_str() );
-    }
-  else if(ca48_runrange && !ca48_runrange_prev)
-    {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_ca48.par file." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_ca48.par").c_str() );
-    }
-  else if(cx4_runrange && !cx4_runrange_prev)
-    {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_cx4.par file." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_cx4.par").c_str() );
-    }
-  else if(snx4_runrange && !snx4_runrange_prev)
+  const runInterval *range = findRunInterval(current_run);
+  if(!range)
+    return;
+
+  if(range->ana >= 0 && range->ana != applied_ana)
     {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_cx4.par file which is the same as the snx4 cell." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_cx4.par").c_str() );
+      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting " << ana_par_sets[range->ana].file << " file." << std::endl;
+      applyInputParam(ana_par_sets[range->ana]);
+      this->printParams();
+      applied_ana = range->ana;
     }
-  else if(d_runrange && !d_runrange_prev)
+
+  bool sf_changed = (range->sf >= 0 && range->sf != applied_sf);
+  bool pi_changed = (range->pi >= 0 && range->pi != applied_pi);
+
+  if(sf_changed)
     {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_he4.par file. Which is std. liquid cell default." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_he4.par").c_str() );
+      std::copy(&sf_par_sets[range->sf].par[0][0],&sf_par_sets[range->sf].par[0][0] + 7*6,&ecal_sf_fcn_par[0][0]);
+      InitSFEcalCuts();
+      applied_sf = range->sf;
     }
-  else if(h_runrange && !h_runrange_prev)
+  if(pi_changed)
     {
-      std::cerr << "WARNING:: Run range changed for run " << current_run << ". Setting ana_he4.par file. Which is std. liquid cell default." << std::endl;
-      this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_he4.par").c_str() );
+      std::copy(&pi_par_sets[range->pi].par[0][0],&pi_par_sets[range->pi].par[0][0] + 7*6,&ecal_p_fcn_par[0][0]);
+      InitSFPCuts();
+      applied_pi = range->pi;
     }
+  if(sf_changed || pi_changed)
+    std::cerr << "WARNING:: Run number changed to " << current_run <<". The SF cuts are changed to reflect this new run range" << std::endl;
 
-  previous_run = current_run;
+}
+
+
+const runInterval* clas12ana::findRunInterval(int run) const
+{
+  //last range starting at or before run
+  auto it = std::upper_bound(run_intervals.begin(),run_intervals.end(),run,
+			     [](int r, const runInterval &range){return r < range.run_min;});
+  if(it == run_intervals.begin())
+    return nullptr;
+
+  --it;
+  if(run > it->run_max)
+    return nullptr;
 
+  return &(*it);
 }
 
 void clas12ana::Init()
 {
+  debug_c.setBinningFile( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/debug_binning.par").c_str() );
   if(debug_plots)
     debug_c.InitDebugPlots();
+  debug_c.setTrajCache(&traj_cache);
 
-  proton_pid_mean->SetParameters(0.0152222,0.816844,-0.0950375,0.255628);
-  proton_pid_sigma->SetParameters(0.0760525,0.240862,-0.000276433,0.229085);
-
-  for(int i = 0; i < 7; i++)
+  for(int j = 0; j < 4; j++)
     {
-      ecal_sf_mean_fcn[i] = new TF1(Form("ecal_sf_mean_fcn_%d",i),"[0] + [1]/x + [2]/pow(x,2)",0,1.5);
-      ecal_sf_fcn[0][i] = new TF1(Form("ecal_sf_fcn_0_%d",i),"[0] + [1]/x + [2]/pow(x,2) - [6]*( [3] + [4]/x + [5]/pow(x,2))",0,1.5);
-      ecal_sf_fcn[1][i] = new TF1(Form("ecal_sf_fcn_1_%d",i),"[0] + [1]/x + [2]/pow(x,2) + [6]*( [3] + [4]/x + [5]/pow(x,2))",0,1.5);
-      
-      ecal_p_mean_fcn[i] = new TF1(Form("ecal_p_mean_fcn_%d",i),"[0] + [1]/x + [2]/pow(x,2)",0,10);
-      ecal_p_fcn[0][i] = new TF1(Form("ecal_p_fcn_0_%d",i),"[0] + [1]/x + [2]/pow(x,2) - [6]*( [3] + [4]/x + [5]/pow(x,2))",0,10);
-      ecal_p_fcn[1][i] = new TF1(Form("ecal_p_fcn_1_%d",i),"[0] + [1]/x + [2]/pow(x,2) + [6]*( [3] + [4]/x + [5]/pow(x,2))",0,10);
+      proton_pid_table.mean[j]  = proton_pid_mean_par[j];
+      proton_pid_table.sigma[j] = proton_pid_sigma_par[j];
     }
-  
+
   for(int i = 0; i < 7; i++)
     {
       for(int j = 0; j < 6; j++)
@@ -366,16 +323,118 @@ void clas12ana::Init()
 	}
     }
 
+  //parsed parameters from the snapshot when it matches the text files (make_par_snapshot)
+  if(!this -> readParSnapshot(parSnapshotFile().c_str()))
+    this -> readParFiles();
+  //  this -> printParams();
+
+}
+
+void clas12ana::readParFiles()
+{
+  std::string dir = std::string(CLAS12ANA_DIR) + "/Ana/cutFiles";
+
+  //parameter files for all run ranges
+  this -> readRunRanges( (dir + "/run_ranges.par").c_str() );
 
   //As defualt load 4He analysis cuts and the SF cuts fit on liquid deuterium which apply to runs < 15542
   previous_run = 15108; //set to a defualt helium run
-  this -> readInputParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/ana_he4.par").c_str() );
-  this -> readEcalSFPar( (std::string(CLAS12ANA_DIR) +"/Ana/cutFiles/paramsSF_LD2_x2.dat").c_str() );
-  this -> readEcalPPar( (std::string(CLAS12ANA_DIR) +"/Ana/cutFiles/paramsPI_LD2_x2.dat").c_str());
+  this -> readInputParam( (dir + "/ana_he4.par").c_str() );
+  this -> readEcalSFPar( (dir + "/paramsSF_LD2_x2.dat").c_str() );
+  this -> readEcalPPar( (dir + "/paramsPI_LD2_x2.dat").c_str());
 
-  this -> readInputSRCParam( (std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/src_cuts.par").c_str() );
-  //  this -> printParams();
+  if(const runInterval *range = findRunInterval(previous_run))
+    {
+      applied_ana = range->ana;
+      applied_sf  = range->sf;
+      applied_pi  = range->pi;
+    }
+
+  this -> readInputSRCParam( (dir + "/src_cuts.par").c_str() );
+}
 
+
+std::unique_ptr<clas12ana> clas12ana::clone() const
+{
+  //no Init: the parameter files are not read again and the debug plots are those of this instance
+  std::unique_ptr<clas12ana> ana(new clas12ana(debug_plots,noInit()));
+  ana->debug_c.setTrajCache(&ana->traj_cache);
+  ana->copyParameters(*this);
+
+  return ana;
+}
+
+void clas12ana::copyParameters(const clas12ana &other)
+{
+  //ECAL SF parameters and the functions built from them
+  sigma_cut = other.sigma_cut;
+  std::copy(&other.ecal_sf_fcn_par[0][0],&other.ecal_sf_fcn_par[0][0] + 7*6,&ecal_sf_fcn_par[0][0]);
+  std::copy(&other.ecal_p_fcn_par[0][0],&other.ecal_p_fcn_par[0][0] + 7*6,&ecal_p_fcn_par[0][0]);
+  InitSFEcalCuts();
+  InitSFPCuts();
+  proton_pid_table = other.proton_pid_table;
+
+  //run range the parameters were loaded for
+  previous_run = other.previous_run;
+  ana_par_sets  = other.ana_par_sets;
+  sf_par_sets   = other.sf_par_sets;
+  pi_par_sets   = other.pi_par_sets;
+  run_intervals = other.run_intervals;
+  applied_ana   = other.applied_ana;
+  applied_sf    = other.applied_sf;
+  applied_pi    = other.applied_pi;
+
+  f_ecalSFCuts      = other.f_ecalSFCuts;
+  f_ecalPCuts       = other.f_ecalPCuts;
+  f_ecalDiagCuts    = other.f_ecalDiagCuts;
+  f_ecalEdgeCuts    = other.f_ecalEdgeCuts;
+  f_DCEdgeCuts      = other.f_DCEdgeCuts;
+  f_CDEdgeCuts      = other.f_CDEdgeCuts;
+  f_pidCuts         = other.f_pidCuts;
+  f_vertexCuts      = other.f_vertexCuts;
+  f_corr_vertexCuts = other.f_corr_vertexCuts;
+  f_protonpidCuts   = other.f_protonpidCuts;
+  f_ghostTrackCuts  = other.f_ghostTrackCuts;
+  f_CDRegionCuts    = other.f_CDRegionCuts;
+
+  pid_cuts_cd      = other.pid_cuts_cd;
+  pid_cuts_fd      = other.pid_cuts_fd;
+  vertex_z_cuts_cd = other.vertex_z_cuts_cd;
+  vertex_z_cuts_fd = other.vertex_z_cuts_fd;
+
+  vertex_x_cuts       = other.vertex_x_cuts;
+  vertex_y_cuts       = other.vertex_y_cuts;
+  vertex_corr_cuts_cd = other.vertex_corr_cuts_cd;
+  vertex_corr_cuts_fd = other.vertex_corr_cuts_fd;
+
+  pcal_energy_cut = other.pcal_energy_cut;
+  ecal_edge_cut   = other.ecal_edge_cut;
+  ecal_diag_cut   = other.ecal_diag_cut;
+  cd_edge_cut     = other.cd_edge_cut;
+  min_mom_pt      = other.min_mom_pt;
+  proton_sigma    = other.proton_sigma;
+  ghost_track_cut = other.ghost_track_cut;
+  dc_edge_cut_el  = other.dc_edge_cut_el;
+  dc_edge_cut_ptr = other.dc_edge_cut_ptr;
+  region_cut      = other.region_cut;
+
+  q2_cut         = other.q2_cut;
+  xb_cut         = other.xb_cut;
+  pmiss_cut      = other.pmiss_cut;
+  recoil_mom_cut = other.recoil_mom_cut;
+  mmiss_cut      = other.mmiss_cut;
+  pq_cut         = other.pq_cut;
+  theta_pq_cut   = other.theta_pq_cut;
+  mom_lead_cut   = other.mom_lead_cut;
+
+  beam_energy    = other.beam_energy;
+  debug_out_file = other.debug_out_file;
+  if(debug_c.getBinningFile() != other.debug_c.getBinningFile())
+    debug_c.setBinningFile(other.debug_c.getBinningFile());
+
+  //the copy fills the debug plots of other (one set per thread), they are written once by other
+  if(debug_plots && other.debug_plots)
+    debug_c.shareThreadSets(other.debug_c);
 }
 
 
@@ -385,13 +444,10 @@ bool clas12ana::DCEdgeCuts(const region_part_ptr &p)
   //cut all charged particles
   if(p->par()->getCharge() != 0)
     {
-      auto traj_index_1 = p->traj(DC,6)->getIndex();  //layer 1 
-      auto traj_index_2 = p->traj(DC,18)->getIndex(); //layer 2
-      auto traj_index_3 = p->traj(DC,36)->getIndex(); //layer 3
-
-      auto traj_edge_1  = p->traj(DC,6)->getFloat("edge",traj_index_1);
-      auto traj_edge_2  = p->traj(DC,18)->getFloat("edge",traj_index_2);
-      auto traj_edge_3  = p->traj(DC,36)->getFloat("edge",traj_index_3);
+      const trajInfo &traj = traj_cache.dc(p);
+      auto traj_edge_1  = traj.dc[trajInfo::dc_r1].edge; //layer 1
+      auto traj_edge_2  = traj.dc[trajInfo::dc_r2].edge; //layer 2
+      auto traj_edge_3  = traj.dc[trajInfo::dc_r3].edge; //layer 3
 
       //PUT DC EDGE CUTS IN PARAMETER FILE
 
@@ -460,6 +516,84 @@ bool clas12ana::checkGhostTrackCD(const region_part_ptr &p)
   return false;
 }
 
+
+void clas12ana::setGhostTracks(bool apply)
+{
+  /*
+    Moves the proton candidates of the event to the proton list, removing ghost tracks
+    (same two cases as checkGhostTrackCD).
+
+    Candidates are taken in REC::Particle order and a candidate is a ghost if it matches
+    one that was already kept, so the result does not depend on the order they were found in.
+    Kept CD tracks are indexed by CTOF component and the kept CD and FD tracks are sorted in theta,
+    so each candidate only looks at its neighbours in theta instead of all protons.
+  */
+
+  if(!apply)
+    {
+      for(auto &p : proton_candidates)
+	{
+	  setCutResult(p,CutId::GhostTrack,true);
+	  protons.push_back(p);
+	}
+      return;
+    }
+
+  std::stable_sort(proton_candidates.begin(),proton_candidates.end(),[](const region_part_ptr &a, const region_part_ptr &b)
+		   {return a->par()->getIndex() < b->par()->getIndex();});
+
+  //sorted, reused from event to event; a few entries per event
+  ghost_ctof.clear();
+  ghost_theta_cd.clear();
+  ghost_theta_fd.clear();
+  auto insertSorted = [](auto &list, auto value)
+    {
+      list.insert(std::upper_bound(list.begin(),list.end(),value),value);
+    };
+
+  //search window is wider than the cut, the cut itself is applied as in checkGhostTrackCD
+  double window = 2*ghost_track_cut*TMath::DegToRad();
+  auto matchTheta = [this,window](const std::vector<double> &list, double theta)
+    {
+      for(auto it = std::lower_bound(list.begin(),list.end(),theta - window); it != list.end() && *it <= theta + window; ++it)
+	if(abs(*it - theta)*TMath::RadToDeg() < ghost_track_cut)
+	  return true;
+      return false;
+    };
+
+  for(auto &p : proton_candidates)
+    {
+      auto t0 = cut_flow.start();
+      int region = p->getRegion();
+      double theta = p->getTheta();
+      bool ghost = false;
+
+      //check ghost tracks only apply to charge particles
+      if(p->par()->getCharge() != 0)
+	{
+	  if(region == clas12::CD)
+	    ghost = std::binary_search(ghost_ctof.begin(),ghost_ctof.end(),p->sci(CTOF)->getComponent()) || matchTheta(ghost_theta_fd,theta); //case 1 or case 2
+	  else if(region == clas12::FD)
+	    ghost = matchTheta(ghost_theta_cd,theta); //case 2
+	}
+
+      cut_flow.record(current_run,static_cast<int>(CutId::GhostTrack),!ghost,t0);
+      setCutResult(p,CutId::GhostTrack,!ghost);
+      if(ghost)
+	continue;
+
+      protons.push_back(p);
+
+      if(region == clas12::CD)
+	{
+	  insertSorted(ghost_ctof,p->sci(CTOF)->getComponent());
+	  insertSorted(ghost_theta_cd,theta);
+	}
+      else if(region == clas12::FD)
+	insertSorted(ghost_theta_fd,theta);
+    }
+}
+
 bool clas12ana::checkEcalDiagCuts(const region_part_ptr &p)
 {
   double mom = p->par()->getP();
@@ -494,8 +628,8 @@ bool clas12ana::checkEcalSFCuts(const region_part_ptr &p)
       int sector = p->getSector();
       
       //Turn on for functional form 
-      double sf_max_cut = ecal_sf_fcn[1][sector]->Eval(energy);
-      double sf_min_cut = ecal_sf_fcn[0][sector]->Eval(energy);
+      double sf_max_cut = ecal_sf_table.upper(sector,energy);
+      double sf_min_cut = ecal_sf_table.lower(sector,energy);
       
       if(sampling_frac < sf_max_cut && sampling_frac > sf_min_cut)
 	return true;
@@ -519,8 +653,8 @@ bool clas12ana::checkEcalPCuts(const region_part_ptr &p)
       int sector = p->getSector();
       
       //Turn on for functional form 
-      double sf_max_cut = ecal_p_fcn[1][sector]->Eval(p->par()->getP() );
-      double sf_min_cut = ecal_p_fcn[0][sector]->Eval(p->par()->getP() );
+      double sf_max_cut = ecal_p_table.upper(sector,p->par()->getP() );
+      double sf_min_cut = ecal_p_table.lower(sector,p->par()->getP() );
       
       if(sampling_frac < sf_max_cut && sampling_frac > sf_min_cut)
 	return true;
@@ -584,13 +718,17 @@ bool clas12ana::CDEdgeCuts(const region_part_ptr &p)
   //cut all charged particles
   if(p->par()->getCharge() != 0 &&  p->getRegion() == CD) //neutral particles don't follow cuts
     {
-      double edge_first = p->traj(CVT,7)->getEdge();
-      TVector3 hit_first(p->traj(CVT,7)->getX(),p->traj(CVT,7)->getY(),p->traj(CVT,7)->getZ());
+      const trajInfo &traj = traj_cache.cvt(p);
+      const trajPoint &first = traj.cvt[trajInfo::cvt_7];
+      const trajPoint &last  = traj.cvt[trajInfo::cvt_12];
+
+      double edge_first = first.edge;
+      TVector3 hit_first(first.x,first.y,first.z);
       double hp_first = hit_first.Phi()*180/M_PI;
       int hit_reg_first = hp_first<-90?1:hp_first<30?2:hp_first<150?3:1;
       
-      double edge_last = p->traj(CVT,12)->getEdge();
-      TVector3 hit_last(p->traj(CVT,12)->getX(),p->traj(CVT,12)->getY(),p->traj(CVT,12)->getZ());
+      double edge_last = last.edge;
+      TVector3 hit_last(last.x,last.y,last.z);
       double hp_last = hit_last.Phi()*180/M_PI;
       int hit_reg_last = hp_last<-90?1:hp_last<30?2:hp_last<150?3:1;
 
@@ -619,18 +757,23 @@ bool clas12ana::checkVertex(const region_part_ptr &p)
   //function returns true if inside vertex cuts
   int pid = p->par()->getPid();
 
+  //need to change the PID for protons which are idientified with TOF cuts if turned on
+  //otherwise vertex cuts will not properly be done
+  if(checkProtonPidCut(p) && f_protonpidCuts)
+    pid = 2212;
+
+  return checkVertex(p,pid);
+}
+
+bool clas12ana::checkVertex(const region_part_ptr &p, int pid)
+{
+  //function returns true if inside vertex cuts for the given (TOF corrected) pid
   bool in_vxvy = (p->par()->getVx() > vertex_x_cuts.at(0) && p->par()->getVx() < vertex_x_cuts.at(1))
     && (p->par()->getVy() > vertex_y_cuts.at(0) && p->par()->getVy() < vertex_y_cuts.at(1));
 
   if(!in_vxvy)
     return false;    
 
-  //need to change the PID for protons which are idientified with TOF cuts if turned on
-  //otherwise vertex cuts will not properly be done
-
-  if(checkProtonPidCut(p) && f_protonpidCuts)
-    pid = 2212;
-
   if(p->getRegion() == FD) //forward detector cuts
     {
       auto itter = vertex_z_cuts_fd.find(pid);
@@ -709,8 +852,8 @@ bool clas12ana::checkProtonPidCut(const region_part_ptr &p)
       //proton_sigma=2;
       double exp_beta  = mom/sqrt(pow(mom,2) + pow(mass_proton,2)); //expected beta of particle assuming proton mass
       double tof_diff = (p->getPath()/c)*(1/p->par()->getBeta() - 1/exp_beta); //TOF difference measured - expected
-      double up_lim  =  proton_pid_mean->Eval(mom) + proton_sigma*proton_pid_sigma->Eval(mom); 
-      double low_lim =  proton_pid_mean->Eval(mom) - proton_sigma*proton_pid_sigma->Eval(mom);
+      double up_lim  =  proton_pid_table.upper(mom,proton_sigma); 
+      double low_lim =  proton_pid_table.lower(mom,proton_sigma);
 
       if( !(tof_diff < up_lim && tof_diff > low_lim))
 	return false;
@@ -721,73 +864,51 @@ bool clas12ana::checkProtonPidCut(const region_part_ptr &p)
 
 
 
-void clas12ana::readEcalSFPar(const char* filename)
+bool clas12ana::parseEcalPar(const char* filename, double par[7][6])
 {
   int num_par = 6; 
   ifstream infile;
   infile.open(filename);
 
-  if (infile.is_open())
-    {  
-      string tp;
+  if (!infile.is_open())
+    return false;
 
-      //remove 3 lines of header                                                                   
-      for(int i = 0; i < 2; ++i)
-	getline(infile, tp);
+  string tp;
 
-      for(int i = 1; i < 7; ++i)
-	{
-	  getline(infile, tp);  //read data from file object and put it into string.       
-          stringstream ss(tp);
-          double parameter;
-	  //get parameters for a given sector
-	  for(int j = 0; j < num_par; j++)
-	    {	 
-	      ss >> parameter;
-	      ecal_sf_fcn_par[i][j] = parameter;
-	    }
+  //remove 3 lines of header                                                                   
+  for(int i = 0; i < 2; ++i)
+    getline(infile, tp);
+
+  for(int i = 1; i < 7; ++i)
+    {
+      getline(infile, tp);  //read data from file object and put it into string.       
+      stringstream ss(tp);
+      double parameter;
+      //get parameters for a given sector
+      for(int j = 0; j < num_par; j++)
+	{	 
+	  ss >> parameter;
+	  par[i][j] = parameter;
 	}
+    }
 
+  return true;
+}
 
-      InitSFEcalCuts();
-    }
+void clas12ana::readEcalSFPar(const char* filename)
+{
+  if(parseEcalPar(filename,ecal_sf_fcn_par))
+    InitSFEcalCuts();
   else
     std::cout<<"ECal parameter files does not exist!!!"<<endl;
 
-
 }
 
 
 void clas12ana::readEcalPPar(const char* filename)
 {
-  int num_par = 6; 
-  ifstream infile;
-  infile.open(filename);
-
-  if (infile.is_open())
-    {  
-      string tp;
-
-      //remove 3 lines of header                                                                   
-      for(int i = 0; i < 2; ++i)
-	getline(infile, tp);
-
-      for(int i = 1; i < 7; ++i)
-	{
-	  getline(infile, tp);  //read data from file object and put it into string.       
-          stringstream ss(tp);
-          double parameter;
-	  //get parameters for a given sector
-	  for(int j = 0; j < num_par; j++)
-	    {	 
-	      ss >> parameter;
-	      ecal_p_fcn_par[i][j] = parameter;
-	    }
-	}
-
-
-      InitSFPCuts();
-    }
+  if(parseEcalPar(filename,ecal_p_fcn_par))
+    InitSFPCuts();
   else
     std::cout<<"ECal parameter files does not exist!!!"<<endl;
 
@@ -802,9 +923,9 @@ void clas12ana::clearInputParam()
   vertex_z_cuts_fd.clear();
 }
 
-void clas12ana::readInputParam(const char* filename)
+bool clas12ana::parseInputParam(const char* filename, anaParSet &set)
 {
-  clearInputParam();
+  set.file = filename;
 
   ifstream infile;
   infile.open(filename);
@@ -849,9 +970,9 @@ void clas12ana::readInputParam(const char* filename)
 	      if(pid != -99) //if pid cut exists in file
 		{
 		  if(detector == "FD")
-		    pid_cuts_fd.insert(pair<int, vector<double> >(pid, par));
+		    set.pid_cuts_fd.insert(pair<int, vector<double> >(pid, par));
 		  else if(detector == "CD")
-		    pid_cuts_cd.insert(pair<int, vector<double> >(pid, par));
+		    set.pid_cuts_cd.insert(pair<int, vector<double> >(pid, par));
 		}
             }//end PID cuts section
 
@@ -880,13 +1001,33 @@ void clas12ana::readInputParam(const char* filename)
 	      if(pid != -99) //if pid cut exists in file
 		{
 		  if(detector == "FD")
-		    vertex_z_cuts_fd.insert(pair<int, vector<double> >(pid, par));
+		    set.vertex_z_cuts_fd.insert(pair<int, vector<double> >(pid, par));
 		  else if(detector == "CD")
-		    vertex_z_cuts_cd.insert(pair<int, vector<double> >(pid, par));
+		    set.vertex_z_cuts_cd.insert(pair<int, vector<double> >(pid, par));
 		}
             }//end vertex z cuts
         }
+      return true;
     }
+
+  return false;
+}
+
+void clas12ana::applyInputParam(const anaParSet &set)
+{
+  pid_cuts_cd      = set.pid_cuts_cd;
+  pid_cuts_fd      = set.pid_cuts_fd;
+  vertex_z_cuts_cd = set.vertex_z_cuts_cd;
+  vertex_z_cuts_fd = set.vertex_z_cuts_fd;
+}
+
+void clas12ana::readInputParam(const char* filename)
+{
+  clearInputParam();
+
+  anaParSet set;
+  if(parseInputParam(filename,set))
+    applyInputParam(set);
   else
     cout<<"Parameter file didn't read in "<<endl;
 
@@ -895,6 +1036,102 @@ void clas12ana::readInputParam(const char* filename)
   return;
 }
 
+int clas12ana::addAnaParSet(const std::string &file)
+{
+  if(file == "-")
+    return -1;
+
+  for(size_t i = 0; i < ana_par_sets.size(); i++)
+    if(ana_par_sets[i].file == file)
+      return i;
+
+  anaParSet set;
+  if(!parseInputParam(file.c_str(),set))
+    {
+      std::cerr << "WARNING:: Parameter file " << file << " didn't read in, run range ignored" << std::endl;
+      return -1;
+    }
+
+  ana_par_sets.push_back(set);
+  return ana_par_sets.size() - 1;
+}
+
+int clas12ana::addEcalParSet(std::vector<ecalParSet> &sets, const std::string &file)
+{
+  if(file == "-")
+    return -1;
+
+  for(size_t i = 0; i < sets.size(); i++)
+    if(sets[i].file == file)
+      return i;
+
+  ecalParSet set;
+  set.file = file;
+  if(!parseEcalPar(file.c_str(),set.par))
+    {
+      std::cerr << "WARNING:: ECal parameter file " << file << " does not exist, run range ignored" << std::endl;
+      return -1;
+    }
+
+  sets.push_back(set);
+  return sets.size() - 1;
+}
+
+void clas12ana::readRunRanges(const char* filename)
+{
+  ana_par_sets.clear();
+  sf_par_sets.clear();
+  pi_par_sets.clear();
+  run_intervals.clear();
+  applied_ana = applied_sf = applied_pi = -1;
+  current_cut_run = -1;
+
+  ifstream infile;
+  infile.open(filename);
+
+  if (!infile.is_open())
+    {
+      std::cerr << "WARNING:: Run range file " << filename << " didn't read in, parameters will not change with run number" << std::endl;
+      return;
+    }
+
+  //parameter files are given relative to the run range file
+  std::string dir(filename);
+  dir = (dir.find('/') == std::string::npos) ? "" : dir.substr(0,dir.rfind('/') + 1);
+  auto path = [&dir](const std::string &file){return file == "-" ? file : dir + file;};
+
+  string tp;
+  while(getline(infile, tp))
+    {
+      stringstream ss(tp);
+      runInterval range;
+      string ana_file,sf_file,pi_file;
+
+      //skip header and comment lines
+      if(tp.empty() || tp[0] == '#')
+	continue;
+
+      if(!(ss >> range.run_min >> range.run_max >> ana_file >> sf_file >> pi_file))
+	{
+	  std::cerr << "WARNING:: Bad line in run range file: " << tp << std::endl;
+	  continue;
+	}
+
+      range.ana = addAnaParSet(path(ana_file));
+      range.sf  = addEcalParSet(sf_par_sets,path(sf_file));
+      range.pi  = addEcalParSet(pi_par_sets,path(pi_file));
+      run_intervals.push_back(range);
+    }
+
+  std::sort(run_intervals.begin(),run_intervals.end(),
+	    [](const runInterval &a, const runInterval &b){return a.run_min < b.run_min;});
+
+  for(size_t i = 1; i < run_intervals.size(); i++)
+    if(run_intervals[i].run_min <= run_intervals[i-1].run_max)
+      std::cerr << "WARNING:: Run ranges " << run_intervals[i-1].run_min << "-" << run_intervals[i-1].run_max
+		<< " and " << run_intervals[i].run_min << "-" << run_intervals[i].run_max << " overlap" << std::endl;
+}
+
 
 void clas12ana::readInputSRCParam(const char* filename)
 {
@@ -1155,33 +1392,27 @@ void clas12ana::getLeadRecoilSRC(TLorentzVector beam, TLorentzVector target, TLo
   lead_proton.clear();
   recoil_proton.clear();
 
-  TLorentzVector ptr(0,0,0,0);
   TLorentzVector q = beam - el;                  //photon  4-vector	
   double q2        = -q.M2();
   double xb        = q2/(2 * mass_proton * (beam.E() - el.E()) ); //x-borken       
   
+  //p, pmiss, mmiss, theta_pq and |p|/|q| for all protons in one pass
+  src_kin.setParticles(protons);
+  src_kin.compute(beam,target,el,mass_proton);
+
   if( !(q2 > q2_cut[0] && xb > xb_cut[0]) )
     return; 
   
   int lead_idx   = -1;
   int lead_mult  = 0;
 
-
-  for(int idx_ptr = 0; idx_ptr != protons.size(); ++idx_ptr)
+  for(int idx_ptr = 0; idx_ptr != src_kin.size(); ++idx_ptr)
     {
-
-      ptr.SetXYZM(protons.at(idx_ptr)->par()->getPx(),protons.at(idx_ptr)->par()->getPy(),protons.at(idx_ptr)->par()->getPz(),mass_proton);
-
-      TLorentzVector miss = beam + target - el - ptr; //missing 4-vector                   
-      double pmiss    = miss.P();
-      double mmiss    = miss.M();
-      double theta_pq = ptr.Vect().Angle(q.Vect()) * TMath::RadToDeg(); //angle between vectors p_miss and q                                                                               
-      double p_q      = ptr.Vect().Mag()/q.Vect().Mag(); // |p|/|q|                               
-      if( ptr.P() > mom_lead_cut[0] &&  ptr.P() < mom_lead_cut[1]   && 
-	  pmiss > pmiss_cut[0] && pmiss < pmiss_cut[1]              && 
-	  mmiss > mmiss_cut[0] && mmiss < mmiss_cut[1]              && 
-	  theta_pq > theta_pq_cut[0]  && theta_pq < theta_pq_cut[1] &&
-	  p_q > pq_cut[0] && p_q < pq_cut[1])
+      if( src_kin.mom[idx_ptr] > mom_lead_cut[0] &&  src_kin.mom[idx_ptr] < mom_lead_cut[1]   && 
+	  src_kin.pmiss[idx_ptr] > pmiss_cut[0] && src_kin.pmiss[idx_ptr] < pmiss_cut[1]      && 
+	  src_kin.mmiss[idx_ptr] > mmiss_cut[0] && src_kin.mmiss[idx_ptr] < mmiss_cut[1]      && 
+	  src_kin.theta_pq[idx_ptr] > theta_pq_cut[0]  && src_kin.theta_pq[idx_ptr] < theta_pq_cut[1] &&
+	  src_kin.p_q[idx_ptr] > pq_cut[0] && src_kin.p_q[idx_ptr] < pq_cut[1])
 	{
 	  lead_idx = idx_ptr;
 	  lead_mult++; //check for double lead
@@ -1194,14 +1425,12 @@ void clas12ana::getLeadRecoilSRC(TLorentzVector beam, TLorentzVector target, TLo
   lead_proton.push_back(protons.at(lead_idx));
 
 
-  int recoil_idx = -1;
-
-  for(int idx_ptr = 0; idx_ptr != protons.size(); ++idx_ptr)
+  for(int idx_ptr = 0; idx_ptr != src_kin.size(); ++idx_ptr)
     {
       if(idx_ptr == lead_idx)
 	continue;
 
-      if(protons[idx_ptr]->par()->getP() > recoil_mom_cut[0] && protons[idx_ptr]->par()->getP() < recoil_mom_cut[1])
+      if(src_kin.p_bank[idx_ptr] > recoil_mom_cut[0] && src_kin.p_bank[idx_ptr] < recoil_mom_cut[1])
 	recoil_proton.push_back(protons.at(idx_ptr));
 
     }
@@ -0,0 +1,152 @@
+#include "clas12ana.h"
+#include "clas12anasnapshot.h"
+
+//the file names of the parameter sets are stored relative to Ana/cutFiles
+static std::string parDir()
+{
+  return std::string(CLAS12ANA_DIR) + "/Ana/cutFiles/";
+}
+
+bool clas12ana::writeParSnapshot(const char* filename)
+{
+  std::string dir = parDir();
+  auto rel = [&dir](const std::string &file){return file.compare(0,dir.size(),dir) == 0 ? file.substr(dir.size()) : file;};
+
+  parSnapshotWriter out;
+
+  out.put<uint32_t>(ana_par_sets.size());
+  for(auto &set : ana_par_sets)
+    {
+      out.put(rel(set.file));
+      out.put(set.pid_cuts_cd);
+      out.put(set.pid_cuts_fd);
+      out.put(set.vertex_z_cuts_cd);
+      out.put(set.vertex_z_cuts_fd);
+    }
+
+  for(auto sets : {&sf_par_sets,&pi_par_sets})
+    {
+      out.put<uint32_t>(sets->size());
+      for(auto &set : *sets)
+	{
+	  out.put(rel(set.file));
+	  out.put(set.par);
+	}
+    }
+
+  out.put<uint32_t>(run_intervals.size());
+  for(auto &range : run_intervals)
+    out.put(range);
+
+  //parameters loaded by default
+  out.put<int32_t>(previous_run);
+  out.put<int32_t>(applied_ana);
+  out.put<int32_t>(applied_sf);
+  out.put<int32_t>(applied_pi);
+  out.put(pid_cuts_cd);
+  out.put(pid_cuts_fd);
+  out.put(vertex_z_cuts_cd);
+  out.put(vertex_z_cuts_fd);
+  out.put(ecal_sf_fcn_par);
+  out.put(ecal_p_fcn_par);
+
+  for(auto cut : {&q2_cut,&xb_cut,&pmiss_cut,&recoil_mom_cut,&mmiss_cut,&pq_cut,&theta_pq_cut,&mom_lead_cut})
+    out.put(*cut);
+
+  return out.write(filename,parFilesStamp(dir));
+}
+
+bool clas12ana::readParSnapshot(const char* filename)
+{
+  parSnapshotReader in(filename);
+  if(!in.isOpen())
+    return false;
+
+  std::string dir = parDir();
+  uint64_t stamp = 0;
+  if(!in.readHeader(stamp) || stamp != parFilesStamp(dir))
+    {
+      std::cerr << "WARNING:: Parameter snapshot " << filename << " is out of date, reading the parameter files (rerun make_par_snapshot)" << std::endl;
+      return false;
+    }
+
+  //read into copies, nothing is changed unless the whole snapshot is valid
+  std::vector<anaParSet> ana_sets(in.getCount());
+  for(auto &set : ana_sets)
+    {
+      in.get(set.file);
+      set.file = dir + set.file;
+      in.get(set.pid_cuts_cd);
+      in.get(set.pid_cuts_fd);
+      in.get(set.vertex_z_cuts_cd);
+      in.get(set.vertex_z_cuts_fd);
+    }
+
+  std::vector<ecalParSet> ecal_sets[2];
+  for(auto &sets : ecal_sets)
+    {
+      sets.resize(in.getCount());
+      for(auto &set : sets)
+	{
+	  in.get(set.file);
+	  set.file = dir + set.file;
+	  in.get(&set.par[0][0],7*6);
+	}
+    }
+
+  std::vector<runInterval> ranges(in.getCount());
+  for(auto &range : ranges)
+    range = in.get<runInterval>();
+
+  int run = in.get<int32_t>();
+  int ana = in.get<int32_t>();
+  int sf = in.get<int32_t>();
+  int pi = in.get<int32_t>();
+
+  anaParSet current;
+  in.get(current.pid_cuts_cd);
+  in.get(current.pid_cuts_fd);
+  in.get(current.vertex_z_cuts_cd);
+  in.get(current.vertex_z_cuts_fd);
+  double sf_par[7][6],p_par[7][6];
+  in.get(&sf_par[0][0],7*6);
+  in.get(&p_par[0][0],7*6);
+
+  std::vector<double> src[8];
+  for(auto &cut : src)
+    in.get(cut);
+
+  if(!in.ok() || !in.atEnd())
+    {
+      std::cerr << "WARNING:: Parameter snapshot " << filename << " is corrupt, reading the parameter files" << std::endl;
+      return false;
+    }
+
+  ana_par_sets  = std::move(ana_sets);
+  sf_par_sets   = std::move(ecal_sets[0]);
+  pi_par_sets   = std::move(ecal_sets[1]);
+  run_intervals = std::move(ranges);
+  current_cut_run = -1;
+  previous_run = run;
+  applied_ana  = ana;
+  applied_sf   = sf;
+  applied_pi   = pi;
+
+  applyInputParam(current);
+  std::copy(&sf_par[0][0],&sf_par[0][0] + 7*6,&ecal_sf_fcn_par[0][0]);
+  std::copy(&p_par[0][0],&p_par[0][0] + 7*6,&ecal_p_fcn_par[0][0]);
+  InitSFEcalCuts();
+  InitSFPCuts();
+
+  q2_cut         = src[0];
+  xb_cut         = src[1];
+  pmiss_cut      = src[2];
+  recoil_mom_cut = src[3];
+  mmiss_cut      = src[4];
+  pq_cut         = src[5];
+  theta_pq_cut   = src[6];
+  mom_lead_cut   = src[7];
+
+  this->printParams();
+  return true;
+}
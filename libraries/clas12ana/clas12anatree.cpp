@@ -0,0 +1,171 @@
+#include "clas12anatree.h"
+
+void anaTreeEvent::Branch(TTree *tree)
+{
+  tree->Branch("run",&run,"run/I");
+  tree->Branch("event",&event,"event/I");
+  tree->Branch("start_time",&start_time,"start_time/F");
+  tree->Branch("weight",&weight,"weight/F");
+
+  tree->Branch("q2",&q2,"q2/F");
+  tree->Branch("xb",&xb,"xb/F");
+  tree->Branch("nu",&nu,"nu/F");
+  tree->Branch("w",&w,"w/F");
+
+  tree->Branch("npart",&npart,"npart/I");
+  tree->Branch("pid",pid,"pid[npart]/I");
+  tree->Branch("pid_rec",pid_rec,"pid_rec[npart]/I");
+  tree->Branch("pindex",pindex,"pindex[npart]/I");
+  tree->Branch("charge",charge,"charge[npart]/I");
+  tree->Branch("region",region,"region[npart]/I");
+  tree->Branch("sector",sector,"sector[npart]/I");
+  tree->Branch("status",status,"status[npart]/I");
+  tree->Branch("px",px,"px[npart]/F");
+  tree->Branch("py",py,"py[npart]/F");
+  tree->Branch("pz",pz,"pz[npart]/F");
+  tree->Branch("vx",vx,"vx[npart]/F");
+  tree->Branch("vy",vy,"vy[npart]/F");
+  tree->Branch("vz",vz,"vz[npart]/F");
+  tree->Branch("beta",beta,"beta[npart]/F");
+  tree->Branch("chi2pid",chi2pid,"chi2pid[npart]/F");
+  tree->Branch("path",path,"path[npart]/F");
+  tree->Branch("time",time,"time[npart]/F");
+  tree->Branch("cut_evaluated",cut_evaluated,"cut_evaluated[npart]/i");
+  tree->Branch("cut_passed",cut_passed,"cut_passed[npart]/i");
+  tree->Branch("src",src,"src[npart]/I");
+}
+
+void anaTreeEvent::SetBranchAddress(TTree *tree)
+{
+  tree->SetBranchAddress("run",&run);
+  tree->SetBranchAddress("event",&event);
+  tree->SetBranchAddress("start_time",&start_time);
+  tree->SetBranchAddress("weight",&weight);
+
+  tree->SetBranchAddress("q2",&q2);
+  tree->SetBranchAddress("xb",&xb);
+  tree->SetBranchAddress("nu",&nu);
+  tree->SetBranchAddress("w",&w);
+
+  tree->SetBranchAddress("npart",&npart);
+  tree->SetBranchAddress("pid",pid);
+  tree->SetBranchAddress("pid_rec",pid_rec);
+  tree->SetBranchAddress("pindex",pindex);
+  tree->SetBranchAddress("charge",charge);
+  tree->SetBranchAddress("region",region);
+  tree->SetBranchAddress("sector",sector);
+  tree->SetBranchAddress("status",status);
+  tree->SetBranchAddress("px",px);
+  tree->SetBranchAddress("py",py);
+  tree->SetBranchAddress("pz",pz);
+  tree->SetBranchAddress("vx",vx);
+  tree->SetBranchAddress("vy",vy);
+  tree->SetBranchAddress("vz",vz);
+  tree->SetBranchAddress("beta",beta);
+  tree->SetBranchAddress("chi2pid",chi2pid);
+  tree->SetBranchAddress("path",path);
+  tree->SetBranchAddress("time",time);
+  tree->SetBranchAddress("cut_evaluated",cut_evaluated);
+  tree->SetBranchAddress("cut_passed",cut_passed);
+  tree->SetBranchAddress("src",src);
+}
+
+
+clas12anatree::clas12anatree(TString file, double beam_E, TString tree_name) : beam_energy{beam_E}
+{
+  out_file = std::make_unique<TFile>(file,"RECREATE");
+  tree = new TTree(tree_name,"clas12ana selected events");
+  tree->SetDirectory(out_file.get());
+  ev.Branch(tree);
+}
+
+void clas12anatree::Fill(const std::unique_ptr<clas12::clas12reader>& c12, clas12ana &ana, double weight)
+{
+  if(!tree)
+    return;
+
+  ev.run        = c12->runconfig()->getRun();
+  ev.event      = c12->runconfig()->getEvent();
+  ev.start_time = c12->event()->getStartTime();
+  ev.weight     = weight;
+
+  ev.q2 = ev.xb = ev.nu = ev.w = 0;
+  auto &electrons = ana.getByPidView(11);
+  if(electrons.size() == 1)
+    {
+      TLorentzVector beam(0,0,beam_energy,beam_energy);
+      TLorentzVector el;
+      el.SetXYZM(electrons[0]->par()->getPx(),electrons[0]->par()->getPy(),electrons[0]->par()->getPz(),0.000511);
+
+      TLorentzVector q = beam - el;
+      ev.q2 = -q.M2();
+      ev.nu = q.E();
+      ev.xb = ev.q2/(2*mass_proton*ev.nu);
+      ev.w  = (q + TLorentzVector(0,0,0,mass_proton)).M();
+    }
+
+  auto lead   = ana.getLeadSRC();
+  auto recoil = ana.getRecoilSRC();
+
+  int n = 0;
+  bool truncated = false;
+  ana.forEachSelected([&](const region_part_ptr &p, int pid)
+    {
+      if(n >= anaTreeEvent::max_part)
+	{
+	  truncated = true;
+	  return;
+	}
+
+      ev.pid[n]     = pid;
+      ev.pid_rec[n] = p->par()->getPid();
+      ev.pindex[n]  = p->par()->getIndex();
+      ev.charge[n]  = p->par()->getCharge();
+      ev.region[n]  = p->getRegion();
+      ev.sector[n]  = p->getSector();
+      ev.status[n]  = p->par()->getStatus();
+      ev.px[n]      = p->par()->getPx();
+      ev.py[n]      = p->par()->getPy();
+      ev.pz[n]      = p->par()->getPz();
+      ev.vx[n]      = p->par()->getVx();
+      ev.vy[n]      = p->par()->getVy();
+      ev.vz[n]      = p->par()->getVz();
+      ev.beta[n]    = p->par()->getBeta();
+      ev.chi2pid[n] = p->par()->getChi2Pid();
+      ev.path[n]    = p->getPath();
+      ev.time[n]    = p->getTime();
+
+      cutMask mask = ana.getCutMask(p);
+      ev.cut_evaluated[n] = mask.evaluated;
+      ev.cut_passed[n]    = mask.passed;
+
+      ev.src[n] = 0;
+      if(std::find(lead.begin(),lead.end(),p) != lead.end())
+	ev.src[n] |= 1;
+      if(std::find(recoil.begin(),recoil.end(),p) != recoil.end())
+	ev.src[n] |= 2;
+
+      n++;
+    });
+
+  ev.npart = n;
+  if(truncated && !warned_truncated)
+    {
+      std::cerr << "WARNING:: clas12anatree: more than " << anaTreeEvent::max_part << " selected particles, extra particles are not written" << std::endl;
+      warned_truncated = true;
+    }
+
+  tree->Fill();
+}
+
+void clas12anatree::Close()
+{
+  if(!out_file)
+    return;
+
+  out_file->cd();
+  tree->Write();
+  out_file->Close();
+  out_file.reset();
+  tree = nullptr;
+}
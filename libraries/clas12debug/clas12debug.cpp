@@ -1,4 +1,6 @@
 #include "clas12debug.h"
+#include <atomic>
+#include <algorithm>
 
 double tof_difference(const clas12::region_part_ptr &p, double mass)
 {
@@ -14,6 +16,10 @@ double tof_difference(const clas12::region_part_ptr &p, double mass)
 
 void clas12debug::fillBeforeEl(const clas12::region_part_ptr &el)
 {
+  clas12debug *plots = fillTarget();
+  if(plots != this)
+    return plots->fillBeforeEl(el);
+
   int sector = el->getSector();
   double el_mom = el->getP();
   double el_sf = getSF(el);
@@ -27,13 +33,10 @@ void clas12debug::fillBeforeEl(const clas12::region_part_ptr &el)
   double pcal_w = el->cal(clas12::PCAL)->getLw();
   double chi2_ndf = el->trk(clas12::DC)->getChi2()/el->trk(clas12::DC)->getNDF();
 
-  auto traj_index_1 = el->traj(clas12::DC,6) ->getIndex(); //layer 1                                                                                                                        
-  auto traj_index_2 = el->traj(clas12::DC,18)->getIndex(); //layer 2                                                                                                                         
-  auto traj_index_3 = el->traj(clas12::DC,36)->getIndex(); //layer 3                                                                                                                         
-  
-  auto traj_edge_1  = el->traj(clas12::DC,6) ->getFloat("edge",traj_index_1);
-  auto traj_edge_2  = el->traj(clas12::DC,18)->getFloat("edge",traj_index_2);
-  auto traj_edge_3  = el->traj(clas12::DC,36)->getFloat("edge",traj_index_3);
+  const trajInfo &traj = getTrajDC(el);
+  auto traj_edge_1  = traj.dc[trajInfo::dc_r1].edge; //layer 1
+  auto traj_edge_2  = traj.dc[trajInfo::dc_r2].edge; //layer 2
+  auto traj_edge_3  = traj.dc[trajInfo::dc_r3].edge; //layer 3
   
   pcal_energy_b_debug->Fill(el_pcal_energy,el->cal(clas12::ECIN)->getEnergy()+el->cal(clas12::ECOUT)->getEnergy());
 
@@ -66,6 +69,10 @@ void clas12debug::fillBeforeEl(const clas12::region_part_ptr &el)
 
 void clas12debug::fillAfterEl(const clas12::region_part_ptr &el)
 {
+  clas12debug *plots = fillTarget();
+  if(plots != this)
+    return plots->fillAfterEl(el);
+
   int sector = el->getSector();
   double el_mom = el->getP();
   double el_sf = getSF(el);
@@ -101,6 +108,10 @@ void clas12debug::fillAfterEl(const clas12::region_part_ptr &el)
 
 void clas12debug::fillBeforePart(const clas12::region_part_ptr &p)
 {
+  clas12debug *plots = fillTarget();
+  if(plots != this)
+    return plots->fillBeforePart(p);
+
   double mass_proton    = 0.938272; //GeV/c2                                                                                                                                                 
 
   int pid = p->par()->getPid();
@@ -119,13 +130,10 @@ void clas12debug::fillBeforePart(const clas12::region_part_ptr &p)
   int sector = p->getSector();
   double chi2_ndf = p->trk(clas12::DC)->getChi2()/p->trk(clas12::DC)->getNDF();
 
-  auto traj_index_1 = p->traj(clas12::DC,6) ->getIndex(); //layer 1                                                                                                                          
-  auto traj_index_2 = p->traj(clas12::DC,18)->getIndex(); //layer 2                                                                                                                          
-  auto traj_index_3 = p->traj(clas12::DC,36)->getIndex(); //layer 3                                                                                                                          
-  
-  auto traj_edge_1  = p->traj(clas12::DC,6) ->getFloat("edge",traj_index_1);
-  auto traj_edge_2  = p->traj(clas12::DC,18)->getFloat("edge",traj_index_2);
-  auto traj_edge_3  = p->traj(clas12::DC,36)->getFloat("edge",traj_index_3);
+  const trajInfo &traj = getTrajDC(p);
+  auto traj_edge_1  = traj.dc[trajInfo::dc_r1].edge; //layer 1
+  auto traj_edge_2  = traj.dc[trajInfo::dc_r2].edge; //layer 2
+  auto traj_edge_3  = traj.dc[trajInfo::dc_r3].edge; //layer 3
 
 
   //DEBUG plots
@@ -170,6 +178,10 @@ void clas12debug::fillBeforePart(const clas12::region_part_ptr &p)
 
 void clas12debug::fillAfterPart(const clas12::region_part_ptr &p)
 {
+  clas12debug *plots = fillTarget();
+  if(plots != this)
+    return plots->fillAfterPart(p);
+
   double mass_proton    = 0.938272; //GeV/c2                                                                                                                                             
   int pid = p->par()->getPid();
   double par_mom  = p->par()->getP();
@@ -206,16 +218,26 @@ double clas12debug::getSF(const clas12::region_part_ptr &p)
     return -9999.;
 }
 
-void clas12debug::fillDCdebug(const clas12::region_part_ptr &p, std::vector<std::unique_ptr<TH2D> > &h)
+void clas12debug::fillDCdebug(const clas12::region_part_ptr &p, std::vector<std::unique_ptr<debugHist> > &h)
 {
-  h.at(0)->Fill(p->traj(clas12::DC,6)->getX(),p->traj(clas12::DC,6)->getY());
-  h.at(1)->Fill(p->traj(clas12::DC,18)->getX(),p->traj(clas12::DC,18)->getY());
-  h.at(2)->Fill(p->traj(clas12::DC,36)->getX(),p->traj(clas12::DC,36)->getY());
+  const trajInfo &traj = getTrajDC(p);
+  for(int i = 0; i < 3; i++)
+    h.at(i)->Fill(traj.dc[i].x,traj.dc[i].y);
+}
+
+const trajInfo& clas12debug::getTrajDC(const clas12::region_part_ptr &p)
+{
+  if(traj_cache)
+    return traj_cache->dc(p);
+
+  clas12trajcache::fillDC(p,traj_scratch);
+  return traj_scratch;
 }
 
 
 void clas12debug::plotDebug()
 {
+  mergeThreadSets();
 
   TCanvas *c1 = new TCanvas("c1","c1",1000,2000);
   c1->Divide(2,6);
@@ -236,6 +258,10 @@ void clas12debug::plotDebug()
 
 void clas12debug::debugByPid(const clas12::region_part_ptr &p)
 {
+  clas12debug *plots = fillTarget();
+  if(plots != this)
+    return plots->debugByPid(p);
+
   int pid = p->par()->getPid();
   double par_mom  = p->par()->getP();
   double par_beta = p->par()->getBeta();
@@ -285,46 +311,43 @@ void clas12debug::debugByPid(const clas12::region_part_ptr &p)
  void clas12debug::InitDebugPlots()
  {
 
-   hists_2D.push_back(pid_cd_debug.get());
-   hists_2D.push_back(pid_fd_debug.get());
-
    for(int i = 1; i <= 6; i++)
      {
 
-       sf_p_debug_b.push_back(std::make_unique<TH2D>(Form("sf_p_debug_b_sector_%d",i),Form("Sampling Fraction Before Cuts Sector_%d;Momentum (GeV/c);Sampling Fraction",i),100,0,6,100,0,.4));
-       sf_p_debug_a.push_back(std::make_unique<TH2D>(Form("sf_p_debug_a_sector_%d",i),Form("Sampling Fraction  After Cuts Sector_%d;Momentum (GeV/c);Sampling Fraction",i),100,0,6,100,0,.4));
+       sf_p_debug_b.push_back(std::make_unique<debugHist>(Form("sf_p_debug_b_sector_%d",i),Form("Sampling Fraction Before Cuts Sector_%d;Momentum (GeV/c);Sampling Fraction",i),100,0,6,100,0,.4));
+       sf_p_debug_a.push_back(std::make_unique<debugHist>(Form("sf_p_debug_a_sector_%d",i),Form("Sampling Fraction  After Cuts Sector_%d;Momentum (GeV/c);Sampling Fraction",i),100,0,6,100,0,.4));
 
-       sf_e_debug_b.push_back(std::make_unique<TH2D>(Form("sf_e_debug_b_sector_%d",i),Form("Sampling Fraction Before Cuts Sector_%d;Energy (GeV);Sampling Fraction",i),100,0,1.5,100,0,.4));
-       sf_e_debug_a.push_back(std::make_unique<TH2D>(Form("sf_e_debug_a_sector_%d",i),Form("Sampling Fraction  After Cuts Sector_%d;Energy (GeV);Sampling Fraction",i),100,0,1.5,100,0,.4));
+       sf_e_debug_b.push_back(std::make_unique<debugHist>(Form("sf_e_debug_b_sector_%d",i),Form("Sampling Fraction Before Cuts Sector_%d;Energy (GeV);Sampling Fraction",i),100,0,1.5,100,0,.4));
+       sf_e_debug_a.push_back(std::make_unique<debugHist>(Form("sf_e_debug_a_sector_%d",i),Form("Sampling Fraction  After Cuts Sector_%d;Energy (GeV);Sampling Fraction",i),100,0,1.5,100,0,.4));
 
-       dc_edge_el_chi2_r1.push_back(std::make_unique<TH1D>(Form("dc_edge_el_chi2_r1_%d",i),Form("Region 1 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_el_chi2_r2.push_back(std::make_unique<TH1D>(Form("dc_edge_el_chi2_r2_%d",i),Form("Region 2 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_el_chi2_r3.push_back(std::make_unique<TH1D>(Form("dc_edge_el_chi2_r3_%d",i),Form("Region 3 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_el_chi2_r1.push_back(std::make_unique<debugHist>(Form("dc_edge_el_chi2_r1_%d",i),Form("Region 1 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_el_chi2_r2.push_back(std::make_unique<debugHist>(Form("dc_edge_el_chi2_r2_%d",i),Form("Region 2 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_el_chi2_r3.push_back(std::make_unique<debugHist>(Form("dc_edge_el_chi2_r3_%d",i),Form("Region 3 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
 
-       dc_edge_p_chi2_r1.push_back(std::make_unique<TH1D>(Form("dc_edge_p_chi2_r1_%d",i),Form("Region 1 Protons DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_p_chi2_r2.push_back(std::make_unique<TH1D>(Form("dc_edge_p_chi2_r2_%d",i),Form("Region 2 Protons DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_p_chi2_r3.push_back(std::make_unique<TH1D>(Form("dc_edge_p_chi2_r3_%d",i),Form("Region 3 Protons DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_p_chi2_r1.push_back(std::make_unique<debugHist>(Form("dc_edge_p_chi2_r1_%d",i),Form("Region 1 Protons DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_p_chi2_r2.push_back(std::make_unique<debugHist>(Form("dc_edge_p_chi2_r2_%d",i),Form("Region 2 Protons DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_p_chi2_r3.push_back(std::make_unique<debugHist>(Form("dc_edge_p_chi2_r3_%d",i),Form("Region 3 Protons DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
 
-       dc_edge_el_r1.push_back(std::make_unique<TH1D>(Form("dc_edge_el_r1_%d",i),Form("Region 1 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_el_r2.push_back(std::make_unique<TH1D>(Form("dc_edge_el_r2_%d",i),Form("Region 2 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_el_r3.push_back(std::make_unique<TH1D>(Form("dc_edge_el_r3_%d",i),Form("Region 3 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_el_r1.push_back(std::make_unique<debugHist>(Form("dc_edge_el_r1_%d",i),Form("Region 1 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_el_r2.push_back(std::make_unique<debugHist>(Form("dc_edge_el_r2_%d",i),Form("Region 2 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_el_r3.push_back(std::make_unique<debugHist>(Form("dc_edge_el_r3_%d",i),Form("Region 3 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
 
-       dc_edge_p_r1.push_back(std::make_unique<TH1D>(Form("dc_edge_p_r1_%d",i),Form("Region 1 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_p_r2.push_back(std::make_unique<TH1D>(Form("dc_edge_p_r2_%d",i),Form("Region 2 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
-       dc_edge_p_r3.push_back(std::make_unique<TH1D>(Form("dc_edge_p_r3_%d",i),Form("Region 3 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_p_r1.push_back(std::make_unique<debugHist>(Form("dc_edge_p_r1_%d",i),Form("Region 1 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_p_r2.push_back(std::make_unique<debugHist>(Form("dc_edge_p_r2_%d",i),Form("Region 2 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
+       dc_edge_p_r3.push_back(std::make_unique<debugHist>(Form("dc_edge_p_r3_%d",i),Form("Region 3 DC edge %d;Distance to Edge (cm);#chi^{2}/DOF",i),100,0,50));
      }
 
 
    //DC hit maps
    for(int i = 1; i <=3 ; i++)
      {
-       dc_hit_map_b.push_back(std::make_unique<TH2D>(Form("dc_hitmap_before_%d",i), Form("Region %d Before Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
-       dc_hit_map_a.push_back(std::make_unique<TH2D>(Form("dc_hitmap_after_%d",i), Form("Region %d After Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
+       dc_hit_map_b.push_back(std::make_unique<debugHist>(Form("dc_hitmap_before_%d",i), Form("Region %d Before Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
+       dc_hit_map_a.push_back(std::make_unique<debugHist>(Form("dc_hitmap_after_%d",i), Form("Region %d After Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
 
-       dc_hit_map_a_proton.push_back(std::make_unique<TH2D>(Form("dc_hitmap_after_proton_%d",i), Form("Region %d After Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
-       dc_hit_map_b_proton.push_back(std::make_unique<TH2D>(Form("dc_hitmap_before_proton_%d",i), Form("Region %d Before Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
-       dc_hit_map_a_pion.push_back(std::make_unique<TH2D>(Form("dc_hitmap_after_pion_%d",i), Form("Region %d After Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
-       dc_hit_map_b_pion.push_back(std::make_unique<TH2D>(Form("dc_hitmap_before_pion_%d",i), Form("Region %d Before Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
+       dc_hit_map_a_proton.push_back(std::make_unique<debugHist>(Form("dc_hitmap_after_proton_%d",i), Form("Region %d After Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
+       dc_hit_map_b_proton.push_back(std::make_unique<debugHist>(Form("dc_hitmap_before_proton_%d",i), Form("Region %d Before Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
+       dc_hit_map_a_pion.push_back(std::make_unique<debugHist>(Form("dc_hitmap_after_pion_%d",i), Form("Region %d After Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
+       dc_hit_map_b_pion.push_back(std::make_unique<debugHist>(Form("dc_hitmap_before_pion_%d",i), Form("Region %d Before Cuts;x-position (cm);y-position (cm)",i),600,-300,300,600,-300,300));
 
       //       dc_hit_map_b[i] = new TH2D(Form("dc_hitmap_before_%d",i), Form("Region %d Before Cuts",i),600,-300,300,600,-300,300);
        //       dc_hit_map_a[i] = new TH2D(Form("dc_hitmap_after_%d",i), Form("Region %d After Cuts",i),600,-300,300,600,-300,300);
@@ -336,110 +359,312 @@ void clas12debug::debugByPid(const clas12::region_part_ptr &p)
        */
      }
 
+   //same order as the original output files
+   auto add = [this](std::vector<std::unique_ptr<debugHist>> &v) {for(auto &h : v) all_hists.push_back(h.get());};
+   all_hists.clear();
+   add(sf_p_debug_b);
+   add(sf_p_debug_a);
+   add(sf_e_debug_a);
+   add(sf_e_debug_b);
+   add(dc_edge_el_chi2_r1);
+   add(dc_edge_el_chi2_r2);
+   add(dc_edge_el_chi2_r3);
+   add(dc_edge_el_r1);
+   add(dc_edge_el_r2);
+   add(dc_edge_el_r3);
+   add(dc_edge_p_chi2_r1);
+   add(dc_edge_p_chi2_r2);
+   add(dc_edge_p_chi2_r3);
+   add(dc_edge_p_r1);
+   add(dc_edge_p_r2);
+   add(dc_edge_p_r3);
+   add(dc_hit_map_b);
+   add(dc_hit_map_a);
+   add(dc_hit_map_b_proton);
+   add(dc_hit_map_a_proton);
+   add(dc_hit_map_b_pion);
+   add(dc_hit_map_a_pion);
+
+   for(auto h : {sf_v_ecalIN_debug.get(),sf_w_ecalIN_debug.get(),sf_v_ecalOUT_debug.get(),sf_w_ecalOUT_debug.get(),sf_v_pcal_debug.get(),sf_w_pcal_debug.get(),
+	 sf_v_ecalIN_a_debug.get(),sf_w_ecalIN_a_debug.get(),sf_v_ecalOUT_a_debug.get(),sf_w_ecalOUT_a_debug.get(),sf_v_pcal_a_debug.get(),sf_w_pcal_a_debug.get(),
+	 cd_particles_a.get(),cd_particles_b.get(),
+	 pid_proton_fd_debug.get(),pid_deuteron_fd_debug.get(),pid_piplus_fd_debug.get(),pid_piminus_fd_debug.get(),pid_kplus_fd_debug.get(),pid_kminus_fd_debug.get(),pid_neutrals_fd_debug.get(),
+	 pid_proton_cd_debug.get(),pid_deuteron_cd_debug.get(),pid_piplus_cd_debug.get(),pid_piminus_cd_debug.get(),pid_kplus_cd_debug.get(),pid_kminus_cd_debug.get(),pid_neutrals_cd_debug.get(),
+	 pid_cd_debug.get(),pid_fd_debug.get(),
+	 el_vz_b_debug.get(),el_vz_a_debug.get(),el_vz_p_debug.get(),
+	 pcal_energy_b_debug.get(),pcal_energy_a_debug.get(),
+	 pid_proton_chi2_fd_debug.get(),pid_proton_chi2_cd_debug.get(),
+	 pid_proton_tof_fd_b_debug.get(),pid_proton_tof_cd_b_debug.get(),pid_proton_tof_fd_a_debug.get(),pid_proton_tof_cd_a_debug.get(),
+	 p_vz_cd_debug.get(),p_vz_fd_debug.get()})
+     all_hists.push_back(h);
+
+   applyBinning();
+   applySampling();
+
+   static std::atomic<unsigned long> next_id{1};
+   thread_sets = std::make_shared<debugThreadSets>();
+   thread_sets->id = next_id++;
+   thread_sets->owner = this;
+   thread_sets->owner_thread = std::this_thread::get_id();
+ }
 
+ //merge key of the sets booked by this thread
+ static thread_local int debug_thread_slot = -1;
+
+ void clas12debug::setThreadSlot(int slot)
+ {
+   debug_thread_slot = slot;
  }
 
+ clas12debug* clas12debug::fillTarget()
+ {
+   if(!thread_sets)
+     return this;
 
- void clas12debug::WriteDebugPlots(TString filename)
+   //the last store used by this thread is cached, so the lock is only taken
+   //the first time a thread fills (or when it switches between debug objects)
+   thread_local unsigned long cached_id = 0;
+   thread_local clas12debug *cached = nullptr;
+
+   if(cached_id != thread_sets->id)
+     {
+       std::lock_guard<std::mutex> lock(thread_sets->mutex);
+       auto thread = std::this_thread::get_id();
+
+       if(thread == thread_sets->owner_thread)
+	 cached = thread_sets->owner;
+       else
+	 {
+	   auto it = thread_sets->by_thread.find(thread);
+	   if(it != thread_sets->by_thread.end())
+	     cached = it->second;
+	   else
+	     {
+	       auto set = std::make_unique<clas12debug>();
+	       set->bookLike(*thread_sets->owner);
+	       long key = debug_thread_slot >= 0 ? debug_thread_slot : (1L << 20) + thread_sets->sets.size();
+	       cached = set.get();
+	       thread_sets->by_thread[thread] = cached;
+	       thread_sets->sets.emplace_back(key,std::move(set));
+	     }
+	 }
+       cached_id = thread_sets->id;
+     }
+
+   cached->traj_cache = traj_cache;
+   return cached;
+ }
+
+ void clas12debug::bookLike(const clas12debug &other)
  {
-   TFile f_debugOut(filename,"RECREATE");
+   InitDebugPlots();
+   //filled by a single thread
+   thread_sets.reset();
 
-   std::for_each(sf_p_debug_b.begin(),sf_p_debug_b.end(), [](auto &el) {el->Write();} );
-   std::for_each(sf_p_debug_a.begin(),sf_p_debug_a.end(), [](auto &el) {el->Write();} );
-   std::for_each(sf_e_debug_a.begin(),sf_e_debug_a.end(), [](auto &el) {el->Write();} );
-   std::for_each(sf_e_debug_b.begin(),sf_e_debug_b.end(), [](auto &el) {el->Write();} );
+   for(size_t i = 0; i < all_hists.size(); i++)
+     all_hists[i]->setBinning(other.all_hists[i]->getBinning());
 
-   std::for_each(dc_edge_el_chi2_r1.begin(),dc_edge_el_chi2_r1.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_el_chi2_r2.begin(),dc_edge_el_chi2_r2.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_el_chi2_r3.begin(),dc_edge_el_chi2_r3.end(),[](auto &p) {p->Write();} );
+   sample_prescale = other.sample_prescale;
+   sample_reservoir = other.sample_reservoir;
+   applySampling();
+ }
 
-   std::for_each(dc_edge_el_r1.begin(),dc_edge_el_r1.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_el_r2.begin(),dc_edge_el_r2.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_el_r3.begin(),dc_edge_el_r3.end(),[](auto &p) {p->Write();} );
+ void clas12debug::shareThreadSets(const clas12debug &other)
+ {
+   thread_sets = other.thread_sets;
+ }
+
+ void clas12debug::mergeThreadSets()
+ {
+   if(!thread_sets || thread_sets->owner != this)
+     return;
 
-   std::for_each(dc_edge_p_chi2_r1.begin(),dc_edge_p_chi2_r1.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_p_chi2_r2.begin(),dc_edge_p_chi2_r2.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_p_chi2_r3.begin(),dc_edge_p_chi2_r3.end(),[](auto &p) {p->Write();} );
+   std::lock_guard<std::mutex> lock(thread_sets->mutex);
 
-   std::for_each(dc_edge_p_r1.begin(),dc_edge_p_r1.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_p_r2.begin(),dc_edge_p_r2.end(),[](auto &p) {p->Write();} );
-   std::for_each(dc_edge_p_r3.begin(),dc_edge_p_r3.end(),[](auto &p) {p->Write();} );
+   //fixed order, independent of which thread finished first
+   auto &sets = thread_sets->sets;
+   std::stable_sort(sets.begin(),sets.end(),[](const auto &a, const auto &b){return a.first < b.first;});
 
+   finishSampling();
+
+   //the sets are kept (threads hold pointers to them) but cleared once merged
+   for(auto &set : sets)
+     {
+       set.second->finishSampling();
+       total_seen += set.second->total_seen;
+       total_sampled += set.second->total_sampled;
+       set.second->total_seen = set.second->total_sampled = 0;
+
+       for(size_t i = 0; i < all_hists.size(); i++)
+	 {
+	   all_hists[i]->Add(*set.second->all_hists[i]);
+	   set.second->all_hists[i]->Reset();
+	 }
+     }
+ }
+
+ void clas12debug::setPrescale(int n)
+ {
+   sample_prescale = std::max(1,n);
+   sample_reservoir = 0;
+   applySampling();
+ }
+
+ void clas12debug::setReservoir(int n)
+ {
+   sample_prescale = 1;
+   sample_reservoir = std::max(0,n);
+   applySampling();
+ }
 
-   for(int i = 0; i <= 2; i++)
-       dc_hit_map_b[i]->Write();
+ void clas12debug::applySampling()
+ {
+   for(auto h : all_hists)
+     {
+       h->setFillWeight(sample_prescale);
+       h->setRecord(sample_reservoir > 0 ? &event_record : nullptr);
+     }
+ }
 
-   for(int i = 0; i <= 2; i++)
-       dc_hit_map_a[i]->Write();
+ bool clas12debug::beginEvent(int run)
+ {
+   clas12debug *plots = fillTarget();
+   if(plots != this)
+     return plots->beginEvent(run);
 
-   for(int i = 0; i <= 2; i++)
-       dc_hit_map_b_proton[i]->Write();
+   if(sample_prescale <= 1 && sample_reservoir <= 0)
+     return true;
 
-   for(int i = 0; i <= 2; i++)
-       dc_hit_map_a_proton[i]->Write();
+   storeEvent();
+   if(run != sample_run)
+     {
+       flushReservoir();
+       sample_run = run;
+     }
 
-   for(int i = 0; i <= 2; i++)
-       dc_hit_map_b_pion[i]->Write();
+   run_seen++;
+   total_seen++;
 
-   for(int i = 0; i <= 2; i++)
-       dc_hit_map_a_pion[i]->Write();
+   if(sample_reservoir <= 0)
+     {
+       bool sampled = (run_seen - 1) % sample_prescale == 0;
+       if(sampled)
+	 total_sampled++;
+       return sampled;
+     }
 
+   //reservoir sampling: keep the event in place of a random earlier one with probability n/seen
+   if(run_seen <= sample_reservoir)
+     reservoir_slot = run_seen - 1;
+   else
+     {
+       long r = std::uniform_int_distribution<long>(0,run_seen - 1)(sample_rng);
+       reservoir_slot = r < sample_reservoir ? r : -1;
+     }
 
-   sf_v_ecalIN_debug->Write();
-   sf_w_ecalIN_debug->Write();
-   sf_v_ecalOUT_debug->Write();
-   sf_w_ecalOUT_debug->Write();
-   sf_v_pcal_debug->Write();
-   sf_w_pcal_debug->Write();
+   return reservoir_slot >= 0;
+ }
 
-   sf_v_ecalIN_a_debug->Write();
-   sf_w_ecalIN_a_debug->Write();
-   sf_v_ecalOUT_a_debug->Write();
-   sf_w_ecalOUT_a_debug->Write();
-   sf_v_pcal_a_debug->Write();
-   sf_w_pcal_a_debug->Write();
+ void clas12debug::storeEvent()
+ {
+   if(reservoir_slot >= 0)
+     {
+       if(reservoir.size() < size_t(sample_reservoir))
+	 reservoir.resize(sample_reservoir);
+       reservoir[reservoir_slot].swap(event_record);
+     }
 
-   cd_particles_a->Write();
-   cd_particles_b->Write();
+   event_record.clear();
+   reservoir_slot = -1;
+ }
 
-   pid_proton_fd_debug->Write();
-   pid_deuteron_fd_debug->Write();
-   pid_piplus_fd_debug->Write();
-   pid_piminus_fd_debug->Write();
-   pid_kplus_fd_debug->Write();
-   pid_kminus_fd_debug->Write();
-   pid_neutrals_fd_debug->Write();
+ void clas12debug::flushReservoir()
+ {
+   long kept = std::min<long>(run_seen,sample_reservoir);
+   if(kept > 0)
+     {
+       //each kept event stands for seen/kept events of the run
+       double weight = double(run_seen)/kept;
+       for(long i = 0; i < kept; i++)
+	 for(auto &fill : reservoir[i])
+	   fill.h->addBin(fill.bin,fill.w*weight);
+       total_sampled += kept;
+     }
 
-   pid_proton_cd_debug->Write();
-   pid_deuteron_cd_debug->Write();
-   pid_piplus_cd_debug->Write();
-   pid_piminus_cd_debug->Write();
-   pid_kplus_cd_debug->Write();
-   pid_kminus_cd_debug->Write();
-   pid_neutrals_cd_debug->Write();
+   for(auto &event : reservoir)
+     event.clear();
+   run_seen = 0;
+ }
 
-   pid_cd_debug->Write();
-   pid_fd_debug->Write();
+ void clas12debug::finishSampling()
+ {
+   storeEvent();
+   if(sample_reservoir > 0)
+     flushReservoir();
+   run_seen = 0;
+   sample_run = -1;
+ }
 
-   el_vz_b_debug->Write();
-   el_vz_a_debug->Write();
-   el_vz_p_debug->Write();
 
-   pcal_energy_b_debug->Write();
-   pcal_energy_a_debug->Write();
+ void clas12debug::WriteDebugPlots(TString filename)
+ {
+   //plots shared with another debug object are written by it
+   if(thread_sets && thread_sets->owner != this)
+     return;
 
-   pid_proton_chi2_fd_debug->Write();      
-   pid_proton_chi2_cd_debug->Write();      
+   mergeThreadSets();
 
-   pid_proton_tof_fd_b_debug->Write();
-   pid_proton_tof_cd_b_debug->Write();
-   pid_proton_tof_fd_a_debug->Write();
-   pid_proton_tof_cd_a_debug->Write();
+   TFile f_debugOut(filename,"RECREATE");
 
-   p_vz_cd_debug->Write();
-   p_vz_fd_debug->Write();
+   //converted to TH1D/TH2D one at a time
+   for(auto h : all_hists)
+     h->Write();
 
+   //normalisation of the sampled plots
+   if(sample_prescale > 1 || sample_reservoir > 0)
+     {
+       TH1D sampling("debug_sampling","Debug plot sampling;;",4,0,4);
+       sampling.SetDirectory(nullptr);
+       sampling.GetXaxis()->SetBinLabel(1,"events");
+       sampling.GetXaxis()->SetBinLabel(2,"sampled");
+       sampling.GetXaxis()->SetBinLabel(3,"prescale");
+       sampling.GetXaxis()->SetBinLabel(4,"reservoir");
+       sampling.SetBinContent(1,total_seen);
+       sampling.SetBinContent(2,total_sampled);
+       sampling.SetBinContent(3,sample_prescale);
+       sampling.SetBinContent(4,sample_reservoir);
+       sampling.Write();
+     }
 
    f_debugOut.Close();
  }
 
+ void clas12debug::setBinningFile(TString file)
+ {
+   binning_fileName = file;
+
+   //histograms already booked are rebinned (and cleared)
+   if(!all_hists.empty())
+     applyBinning();
+ }
+
+ void clas12debug::applyBinning()
+ {
+   if(binning_fileName == "")
+     return;
+
+   auto binning = readDebugBinning(binning_fileName.Data());
+   for(auto h : all_hists)
+     applyDebugBinning(binning,*h);
+ }
+
+ size_t clas12debug::memoryUsage() const
+ {
+   size_t total = 0;
+   for(auto h : all_hists)
+     total += h->memoryUsage();
+   if(thread_sets && thread_sets->owner == this)
+     for(auto &set : thread_sets->sets)
+       total += set.second->memoryUsage();
+   return total;
+ }
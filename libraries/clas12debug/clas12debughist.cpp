@@ -0,0 +1,262 @@
+#include "clas12debughist.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+
+debugHist::debugHist(TString name_, TString title_, int nx, double xmin, double xmax):
+  name{name_},title{title_}
+{
+  debugBinning b;
+  b.nx = nx;
+  b.xmin = xmin;
+  b.xmax = xmax;
+  setBinning(b);
+}
+
+debugHist::debugHist(TString name_, TString title_, int nx, double xmin, double xmax, int ny, double ymin, double ymax):
+  name{name_},title{title_}
+{
+  debugBinning b;
+  b.nx = nx;
+  b.xmin = xmin;
+  b.xmax = xmax;
+  b.ny = ny;
+  b.ymin = ymin;
+  b.ymax = ymax;
+  setBinning(b);
+}
+
+void debugHist::setBinning(const debugBinning &b)
+{
+  bins = b;
+  sparse_bins = nBins() > max_dense_bins;
+  max_sparse_filled = nBins()*sizeof(double)/sparse_bin_size;
+  has_sumw2 = false;
+  Reset();
+}
+
+void debugHist::Reset()
+{
+  entries = 0;
+  sparse.clear();
+  sparse_sumw2.clear();
+  dense_sumw2.clear();
+  if(sparse_bins)
+    dense.clear();
+  else
+    dense.assign(nBins(),0);
+  if(has_sumw2)
+    {
+      has_sumw2 = false;
+      enableSumw2();
+    }
+}
+
+void debugHist::enableSumw2()
+{
+  if(has_sumw2)
+    return;
+  has_sumw2 = true;
+
+  //unit weights so far, the sum of squares equals the contents
+  if(sparse_bins)
+    sparse_sumw2 = sparse;
+  else
+    dense_sumw2 = dense;
+}
+
+void debugHist::toDense()
+{
+  if(!sparse_bins)
+    return;
+  sparse_bins = false;
+
+  dense.assign(nBins(),0);
+  for(const auto &bin : sparse)
+    dense[bin.first] = bin.second;
+  if(has_sumw2)
+    {
+      dense_sumw2.assign(nBins(),0);
+      for(const auto &bin : sparse_sumw2)
+	dense_sumw2[bin.first] = bin.second;
+    }
+
+  //release the memory of the maps
+  std::unordered_map<int,double>().swap(sparse);
+  std::unordered_map<int,double>().swap(sparse_sumw2);
+}
+
+void debugHist::Add(const debugHist &other)
+{
+  if(other.bins.nx != bins.nx || other.bins.ny != bins.ny ||
+     other.bins.xmin != bins.xmin || other.bins.xmax != bins.xmax ||
+     other.bins.ymin != bins.ymin || other.bins.ymax != bins.ymax)
+    {
+      std::cerr << "WARNING:: debugHist " << name << " cannot add histogram with different binning" << std::endl;
+      return;
+    }
+
+  if(other.has_sumw2)
+    enableSumw2();
+
+  entries += other.entries;
+  if(!other.sparse_bins)
+    toDense();
+
+  if(other.sparse_bins)
+    {
+      const auto &other_sumw2 = other.has_sumw2 ? other.sparse_sumw2 : other.sparse;
+      if(sparse_bins)
+	{
+	  for(const auto &bin : other.sparse)
+	    sparse[bin.first] += bin.second;
+	  if(has_sumw2)
+	    for(const auto &bin : other_sumw2)
+	      sparse_sumw2[bin.first] += bin.second;
+	  if(sparse.size() > max_sparse_filled)
+	    toDense();
+	}
+      else
+	{
+	  for(const auto &bin : other.sparse)
+	    dense[bin.first] += bin.second;
+	  if(has_sumw2)
+	    for(const auto &bin : other_sumw2)
+	      dense_sumw2[bin.first] += bin.second;
+	}
+    }
+  else
+    {
+      for(size_t i = 0; i < dense.size(); i++)
+	dense[i] += other.dense[i];
+      if(has_sumw2)
+	for(size_t i = 0; i < dense.size(); i++)
+	  dense_sumw2[i] += other.has_sumw2 ? other.dense_sumw2[i] : other.dense[i];
+    }
+}
+
+size_t debugHist::memoryUsage() const
+{
+  //rough estimate of the hash map node size
+  size_t node = sizeof(std::pair<const int,double>) + 2*sizeof(void*);
+  return sizeof(*this) + (dense.capacity() + dense_sumw2.capacity())*sizeof(double)
+    + (sparse.size() + sparse_sumw2.size())*node
+    + (sparse.bucket_count() + sparse_sumw2.bucket_count())*sizeof(void*);
+}
+
+TH1* debugHist::toROOT() const
+{
+  bool add_dir = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+
+  TH1 *h;
+  if(bins.ny == 0)
+    h = new TH1D(name,title,bins.nx,bins.xmin,bins.xmax);
+  else
+    h = new TH2D(name,title,bins.nx,bins.xmin,bins.xmax,bins.ny,bins.ymin,bins.ymax);
+  TH1::AddDirectory(add_dir);
+
+  if(has_sumw2)
+    h->Sumw2();
+
+  if(sparse_bins)
+    {
+      for(const auto &bin : sparse)
+	h->SetBinContent(bin.first,bin.second);
+      for(const auto &bin : sparse_sumw2)
+	h->SetBinError(bin.first,sqrt(bin.second));
+    }
+  else
+    {
+      for(size_t i = 0; i < dense.size(); i++)
+	if(dense[i] != 0)
+	  h->SetBinContent(i,dense[i]);
+      for(size_t i = 0; i < dense_sumw2.size(); i++)
+	if(dense_sumw2[i] != 0)
+	  h->SetBinError(i,sqrt(dense_sumw2[i]));
+    }
+
+  h->SetEntries(entries);
+  return h;
+}
+
+void debugHist::Write() const
+{
+  TH1 *h = toROOT();
+  h->Write();
+  delete h;
+}
+
+void debugHist::Draw(const char *option) const
+{
+  //the drawn copy belongs to the pad
+  TH1 *h = toROOT();
+  h->SetBit(kCanDelete);
+  h->Draw(option);
+}
+
+std::vector<std::pair<std::string,debugBinning>> readDebugBinning(const char *filename)
+{
+  std::vector<std::pair<std::string,debugBinning>> binning;
+
+  std::ifstream infile(filename);
+  if(!infile.is_open())
+    {
+      std::cerr << "WARNING:: Debug binning file " << filename << " didn't read in, using default binning" << std::endl;
+      return binning;
+    }
+
+  std::string tp;
+  while(getline(infile, tp))
+    {
+      if(tp.empty() || tp[0] == '#')
+	continue;
+
+      std::stringstream ss(tp);
+      std::string name;
+      debugBinning b;
+      if(!(ss >> name >> b.nx >> b.xmin >> b.xmax) || b.nx <= 0 || b.xmax <= b.xmin)
+	{
+	  std::cerr << "WARNING:: Bad line in debug binning file: " << tp << std::endl;
+	  continue;
+	}
+
+      if(ss >> b.ny)
+	if(!(ss >> b.ymin >> b.ymax) || b.ny <= 0 || b.ymax <= b.ymin)
+	  {
+	    std::cerr << "WARNING:: Bad line in debug binning file: " << tp << std::endl;
+	    continue;
+	  }
+
+      binning.push_back(std::make_pair(name,b));
+    }
+
+  return binning;
+}
+
+bool applyDebugBinning(const std::vector<std::pair<std::string,debugBinning>> &binning, debugHist &h)
+{
+  std::string name(h.GetName().Data());
+
+  //the last matching line wins
+  for(auto it = binning.rbegin(); it != binning.rend(); ++it)
+    {
+      const std::string &key = it->first;
+      bool match = (!key.empty() && key.back() == '*') ? name.compare(0,key.size() - 1,key,0,key.size() - 1) == 0 : name == key;
+      if(!match)
+	continue;
+
+      //1D and 2D histograms keep their dimension
+      if((it->second.ny == 0) != (h.getBinning().ny == 0))
+	{
+	  std::cerr << "WARNING:: Debug binning for " << key << " does not match the dimension of " << name << std::endl;
+	  return false;
+	}
+
+      h.setBinning(it->second);
+      return true;
+    }
+
+  return false;
+}
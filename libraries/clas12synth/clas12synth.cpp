@@ -0,0 +1,456 @@
+#include "clas12synth.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+  struct schemaDef
+  {
+    const char *name;
+    int group;
+    int item;
+    const char *format;
+  };
+
+  //same order as the s_* indices of clas12synth
+  const schemaDef schema_defs[] =
+    {{"RUN::config",10000,11,"run/I,event/I,unixtime/I,trigger/L,timestamp/L,type/B,mode/B,torus/F,solenoid/F"},
+     {"REC::Event",300,30,"category/L,topology/L,beamCharge/F,liveTime/D,startTime/F,RFTime/F,helicity/B,helicityRaw/B,procTime/F"},
+     {"REC::Particle",300,31,"pid/I,px/F,py/F,pz/F,vx/F,vy/F,vz/F,vt/F,charge/B,beta/F,chi2pid/F,status/S"},
+     {"REC::Calorimeter",300,32,"index/S,pindex/S,detector/B,sector/B,layer/B,energy/F,time/F,path/F,chi2/F,x/F,y/F,z/F,hx/F,hy/F,hz/F,lu/F,lv/F,lw/F,du/F,dv/F,dw/F,m2u/F,m2v/F,m2w/F,m3u/F,m3v/F,m3w/F,status/S"},
+     {"REC::Cherenkov",300,33,"index/S,pindex/S,detector/B,sector/B,nphe/F,time/F,path/F,chi2/F,x/F,y/F,z/F,dtheta/F,dphi/F,status/S"},
+     {"REC::Scintillator",300,35,"index/S,pindex/S,detector/B,sector/B,layer/B,component/S,energy/F,time/F,path/F,chi2/F,x/F,y/F,z/F,hx/F,hy/F,hz/F,status/S"},
+     {"REC::Track",300,36,"index/S,pindex/S,detector/B,sector/B,status/S,q/B,chi2/F,NDF/S,hbindex/S"},
+     {"REC::Traj",300,40,"pindex/S,index/S,detector/B,layer/B,x/F,y/F,z/F,cx/F,cy/F,cz/F,path/F,edge/F"},
+     {"REC::ForwardTagger",300,34,"index/S,pindex/S,detector/B,layer/B,energy/F,time/F,path/F,chi2/F,x/F,y/F,z/F,dx/F,dy/F,radius/F,size/S,status/S"},
+     {"MC::Event",40,1,"npart/S,atarget/S,ztarget/S,ptarget/F,pbeam/F,btype/S,ebeam/F,targetid/S,processid/S,weight/F"},
+     {"MC::Lund",40,3,"index/B,lifetime/F,type/B,pid/I,parent/B,daughter/B,px/F,py/F,pz/F,energy/F,mass/F,vx/F,vy/F,vz/F"}};
+
+  const double c_light = 29.9792458; //cm/ns
+
+  double massOf(int pid)
+  {
+    switch(std::abs(pid))
+      {
+      case 11:   return 0.000511;
+      case 22:   return 0;
+      case 211:  return 0.13957;
+      case 321:  return 0.493677;
+      case 2112: return 0.939565;
+      case 45:   return 1.875613;
+      default:   return 0.938272;
+      }
+  }
+
+  int chargeOf(int pid)
+  {
+    switch(pid)
+      {
+      case 11: case -211: case -321: return -1;
+      case 22: case 2112:            return 0;
+      default:                       return 1;
+      }
+  }
+
+  //point at distance r along the direction of p
+  void along(const double p[3], double r, float &x, float &y, float &z)
+  {
+    double mag = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+    x = r*p[0]/mag;
+    y = r*p[1]/mag;
+    z = r*p[2]/mag;
+  }
+
+}
+
+clas12synth::clas12synth(synthConfig c):
+  config{c},rand{c.seed}
+{
+  for(auto &def : schema_defs)
+    {
+      schemas.emplace_back(def.name,def.group,def.item);
+      schemas.back().parse(def.format);
+    }
+}
+
+clas12synth::~clas12synth()
+{
+  for(auto &file : temp_files)
+    std::remove(file.c_str());
+}
+
+int clas12synth::sectorOf(double phi)
+{
+  //sector 1 is centred at phi = 0
+  int s = int(floor((phi*180/M_PI + 30)/60));
+  return (s + 6)%6 + 1;
+}
+
+clas12synth::genParticle clas12synth::generate(int pid, double mom_min, double mom_max, double theta_min, double theta_max)
+{
+  genParticle gen;
+  gen.pid = pid;
+  gen.mass = massOf(pid);
+  gen.charge = chargeOf(pid);
+
+  double mom = rand.Uniform(mom_min,mom_max);
+  double cos_theta = rand.Uniform(cos(theta_max*M_PI/180),cos(theta_min*M_PI/180));
+  double sin_theta = sqrt(1 - cos_theta*cos_theta);
+  double phi = rand.Uniform(-M_PI,M_PI);
+
+  gen.p[0] = mom*sin_theta*cos(phi);
+  gen.p[1] = mom*sin_theta*sin(phi);
+  gen.p[2] = mom*cos_theta;
+  for(int i = 0; i < 3; i++)
+    gen.v[i] = vertex[i];
+
+  return gen;
+}
+
+void clas12synth::addParticle(const genParticle &gen, bool trigger)
+{
+  int pindex = particles.size();
+  lund.push_back(gen);
+
+  double mom = sqrt(gen.p[0]*gen.p[0] + gen.p[1]*gen.p[1] + gen.p[2]*gen.p[2]);
+  double theta = acos(gen.p[2]/mom)*180/M_PI;
+  int region = (theta > config.cd_theta && !trigger) ? clas12::CD : clas12::FD;
+  double beta = mom/sqrt(mom*mom + gen.mass*gen.mass);
+
+  //reconstructed momentum and vertex
+  double scale = 1 + rand.Gaus(0,config.mom_resolution);
+  double p[3] = {gen.p[0]*scale,gen.p[1]*scale,gen.p[2]*scale};
+
+  particleRow row;
+  row.pid = gen.pid;
+  for(int i = 0; i < 3; i++)
+    {
+      row.p[i] = p[i];
+      row.v[i] = gen.v[i] + (i < 2 ? rand.Gaus(0,config.vxy_sigma) : rand.Gaus(0,0.3));
+    }
+  row.vt = config.start_time + rand.Gaus(0,config.time_resolution);
+  row.charge = gen.charge;
+  row.beta = beta + rand.Gaus(0,0.01);
+  row.chi2pid = gen.charge != 0 ? rand.Gaus(0,1) : 0;
+  particles.push_back(row);
+
+  //status: 1000*region + 100*scintillator + 10*calorimeter + cherenkov hits, negative for the trigger particle
+  int hits = addDetectors(pindex,gen,p,region,beta);
+  particles[pindex].status = (trigger ? -1 : 1)*(region + hits);
+}
+
+int clas12synth::addDetectors(int pindex, const genParticle &gen, const double p[3], int region, double beta)
+{
+  double mom = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+  double phi = atan2(p[1],p[0]);
+  int sector = (region == clas12::FD) ? sectorOf(phi) : 0;
+  int nsci = 0, ncal = 0, nche = 0;
+
+  auto hit = [&](int detector, int layer, double path)
+    {
+      detRow d = {};
+      d.pindex = pindex;
+      d.detector = detector;
+      d.sector = sector;
+      d.layer = layer;
+      d.path = path;
+      d.time = config.start_time + (beta > 0 ? path/(beta*c_light) : 0) + rand.Gaus(0,config.time_resolution);
+      along(p,path,d.x,d.y,d.z);
+      return d;
+    };
+
+  if(region == clas12::FD)
+    {
+      if(gen.pid == 11)
+	{
+	  detRow htcc = hit(clas12::HTCC,0,150);
+	  htcc.nphe = std::max(0.,rand.Gaus(15,5));
+	  che_rows.push_back(htcc);
+	  nche++;
+	}
+
+      //electrons and photons shower, sampling fraction ~0.25 shared 60/30/10 between the layers
+      if(gen.pid == 11 || gen.pid == 22 || gen.pid == 2112)
+	{
+	  double deposit = (gen.pid == 2112) ? rand.Uniform(0.01,0.1) : rand.Gaus(0.25,0.015)*mom;
+	  const int layers[3] = {clas12::PCAL,clas12::ECIN,clas12::ECOUT};
+	  const double share[3] = {0.6,0.3,0.1};
+	  for(int l = 0; l < 3; l++)
+	    {
+	      if(gen.pid == 2112 && l == 0)
+		continue;
+	      detRow cal = hit(clas12::ECAL,layers[l],720 + 15*l);
+	      cal.energy = (gen.pid == 2112) ? deposit : deposit*share[l];
+	      cal.lu = rand.Uniform(5,400);
+	      cal.lv = rand.Uniform(5,400);
+	      cal.lw = rand.Uniform(5,400);
+	      cal_rows.push_back(cal);
+	      ncal++;
+	    }
+	}
+
+      if(gen.charge != 0)
+	{
+	  detRow ftof = hit(clas12::FTOF,clas12::FTOF1B,650);
+	  ftof.energy = rand.Gaus(10,2);
+	  sci_rows.push_back(ftof);
+	  nsci++;
+
+	  //DC regions 1-3
+	  const int dc_layers[3] = {6,18,36};
+	  const double dc_path[3] = {230,350,500};
+	  for(int l = 0; l < 3; l++)
+	    {
+	      detRow traj = hit(clas12::DC,dc_layers[l],dc_path[l]);
+	      traj.edge = rand.Uniform(1,20);
+	      traj_rows.push_back(traj);
+	    }
+
+	  detRow trk = hit(clas12::DC,0,0);
+	  trk.charge = gen.charge;
+	  trk.chi2 = std::abs(rand.Gaus(20,5));
+	  trk.ndf = 30;
+	  trk_rows.push_back(trk);
+	}
+    }
+  else if(gen.charge != 0)
+    {
+      detRow ctof = hit(clas12::CTOF,1,35);
+      ctof.energy = rand.Gaus(8,2);
+      sci_rows.push_back(ctof);
+      nsci++;
+
+      const int cvt_layers[5] = {1,3,5,7,12};
+      for(int l = 0; l < 5; l++)
+	{
+	  detRow traj = hit(clas12::CVT,cvt_layers[l],7 + 2.5*l);
+	  traj.edge = rand.Uniform(0.1,5);
+	  traj_rows.push_back(traj);
+	}
+
+      detRow trk = hit(clas12::CVT,0,0);
+      trk.charge = gen.charge;
+      trk.chi2 = std::abs(rand.Gaus(10,3));
+      trk.ndf = 10;
+      trk_rows.push_back(trk);
+    }
+  else
+    {
+      //CD neutrals are only seen in the CND
+      detRow cnd = hit(clas12::CND,int(rand.Uniform(1,4)),40);
+      cnd.energy = rand.Uniform(2,20);
+      sci_rows.push_back(cnd);
+      nsci++;
+    }
+
+  return 100*std::min(nsci,9) + 10*std::min(ncal,9) + std::min(nche,9);
+}
+
+void clas12synth::fill(hipo::event &event)
+{
+  particles.clear();
+  cal_rows.clear();
+  che_rows.clear();
+  sci_rows.clear();
+  traj_rows.clear();
+  trk_rows.clear();
+  lund.clear();
+  event_number++;
+
+  //common vertex of the event
+  vertex[0] = rand.Gaus(0,config.vxy_sigma);
+  vertex[1] = rand.Gaus(0,config.vxy_sigma);
+  vertex[2] = rand.Gaus(config.vz_mean,config.vz_sigma);
+
+  if(rand.Rndm() < config.electron_prob)
+    addParticle(generate(11,config.el_mom_min,config.el_mom_max,config.el_theta_min,config.el_theta_max),true);
+
+  for(auto &s : config.species)
+    {
+      int n = rand.Poisson(s.mean_mult);
+      for(int i = 0; i < n; i++)
+	addParticle(generate(s.pid,s.mom_min,s.mom_max,s.theta_min,s.theta_max),false);
+    }
+
+  hipo::bank run(schemas[s_run],1);
+  run.putInt("run",0,config.run);
+  run.putInt("event",0,event_number);
+  run.putFloat("torus",0,-1);
+  run.putFloat("solenoid",0,-1);
+
+  hipo::bank rec_event(schemas[s_event],1);
+  rec_event.putFloat("startTime",0,config.start_time);
+
+  hipo::bank part(schemas[s_part],particles.size());
+  for(size_t i = 0; i < particles.size(); i++)
+    {
+      const particleRow &r = particles[i];
+      part.putInt("pid",i,r.pid);
+      part.putFloat("px",i,r.p[0]);
+      part.putFloat("py",i,r.p[1]);
+      part.putFloat("pz",i,r.p[2]);
+      part.putFloat("vx",i,r.v[0]);
+      part.putFloat("vy",i,r.v[1]);
+      part.putFloat("vz",i,r.v[2]);
+      part.putFloat("vt",i,r.vt);
+      part.putByte("charge",i,r.charge);
+      part.putFloat("beta",i,r.beta);
+      part.putFloat("chi2pid",i,r.chi2pid);
+      part.putShort("status",i,r.status);
+    }
+
+  //columns shared by the detector banks
+  auto putHit = [](hipo::bank &bank, int i, const detRow &r)
+    {
+      bank.putShort("index",i,i);
+      bank.putShort("pindex",i,r.pindex);
+      bank.putByte("detector",i,r.detector);
+      bank.putFloat("time",i,r.time);
+      bank.putFloat("path",i,r.path);
+      bank.putFloat("x",i,r.x);
+      bank.putFloat("y",i,r.y);
+      bank.putFloat("z",i,r.z);
+    };
+
+  hipo::bank cal(schemas[s_cal],cal_rows.size());
+  for(size_t i = 0; i < cal_rows.size(); i++)
+    {
+      const detRow &r = cal_rows[i];
+      putHit(cal,i,r);
+      cal.putByte("sector",i,r.sector);
+      cal.putByte("layer",i,r.layer);
+      cal.putFloat("energy",i,r.energy);
+      cal.putFloat("lu",i,r.lu);
+      cal.putFloat("lv",i,r.lv);
+      cal.putFloat("lw",i,r.lw);
+    }
+
+  hipo::bank che(schemas[s_che],che_rows.size());
+  for(size_t i = 0; i < che_rows.size(); i++)
+    {
+      const detRow &r = che_rows[i];
+      putHit(che,i,r);
+      che.putByte("sector",i,r.sector);
+      che.putFloat("nphe",i,r.nphe);
+    }
+
+  hipo::bank sci(schemas[s_sci],sci_rows.size());
+  for(size_t i = 0; i < sci_rows.size(); i++)
+    {
+      const detRow &r = sci_rows[i];
+      putHit(sci,i,r);
+      sci.putByte("sector",i,r.sector);
+      sci.putByte("layer",i,r.layer);
+      sci.putShort("component",i,1);
+      sci.putFloat("energy",i,r.energy);
+    }
+
+  hipo::bank trk(schemas[s_trk],trk_rows.size());
+  for(size_t i = 0; i < trk_rows.size(); i++)
+    {
+      const detRow &r = trk_rows[i];
+      trk.putShort("index",i,i);
+      trk.putShort("pindex",i,r.pindex);
+      trk.putByte("detector",i,r.detector);
+      trk.putByte("sector",i,r.sector);
+      trk.putByte("q",i,r.charge);
+      trk.putFloat("chi2",i,r.chi2);
+      trk.putShort("NDF",i,r.ndf);
+    }
+
+  hipo::bank traj(schemas[s_traj],traj_rows.size());
+  for(size_t i = 0; i < traj_rows.size(); i++)
+    {
+      const detRow &r = traj_rows[i];
+      traj.putShort("pindex",i,r.pindex);
+      traj.putShort("index",i,i);
+      traj.putByte("detector",i,r.detector);
+      traj.putByte("layer",i,r.layer);
+      traj.putFloat("x",i,r.x);
+      traj.putFloat("y",i,r.y);
+      traj.putFloat("z",i,r.z);
+      traj.putFloat("path",i,r.path);
+      traj.putFloat("edge",i,r.edge);
+    }
+
+  hipo::bank ft(schemas[s_ft],0);
+
+  hipo::bank mcevent(schemas[s_mcevent],1);
+  mcevent.putShort("npart",0,lund.size());
+  mcevent.putFloat("ebeam",0,config.beam_energy);
+  mcevent.putFloat("weight",0,1);
+
+  hipo::bank mcparts(schemas[s_lund],lund.size());
+  for(size_t i = 0; i < lund.size(); i++)
+    {
+      const genParticle &g = lund[i];
+      double mom2 = g.p[0]*g.p[0] + g.p[1]*g.p[1] + g.p[2]*g.p[2];
+      mcparts.putByte("index",i,i + 1);
+      mcparts.putByte("type",i,1);
+      mcparts.putInt("pid",i,g.pid);
+      mcparts.putFloat("px",i,g.p[0]);
+      mcparts.putFloat("py",i,g.p[1]);
+      mcparts.putFloat("pz",i,g.p[2]);
+      mcparts.putFloat("energy",i,sqrt(mom2 + g.mass*g.mass));
+      mcparts.putFloat("mass",i,g.mass);
+      mcparts.putFloat("vx",i,g.v[0]);
+      mcparts.putFloat("vy",i,g.v[1]);
+      mcparts.putFloat("vz",i,g.v[2]);
+    }
+
+  event.reset();
+  for(auto bank : {&run,&rec_event,&part,&cal,&che,&sci,&trk,&traj,&ft,&mcevent,&mcparts})
+    event.addStructure(*bank);
+}
+
+bool clas12synth::write(const std::string &filename, long nevents)
+{
+  //hipo::writer does not report errors on open
+  if(!std::ofstream(filename).is_open())
+    {
+      std::cerr << "WARNING:: Cannot write synthetic events to " << filename << std::endl;
+      return false;
+    }
+
+  hipo::writer writer;
+  for(auto &schema : schemas)
+    writer.getDictionary().addSchema(schema);
+  writer.open(filename.c_str());
+
+  hipo::event event;
+  for(long i = 0; i < nevents; i++)
+    {
+      fill(event);
+      writer.addEvent(event);
+    }
+  writer.close();
+
+  return true;
+}
+
+std::string clas12synth::writeTemp(long nevents)
+{
+  //memory backed when available
+  std::string dir = "/dev/shm";
+  if(access(dir.c_str(),W_OK) != 0)
+    dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+
+  std::string file = dir + "/clas12synth_" + std::to_string(getpid()) + "_" + std::to_string(temp_files.size()) + ".hipo";
+  if(!write(file,nevents))
+    return "";
+
+  temp_files.push_back(file);
+  return file;
+}
+
+std::unique_ptr<clas12::clas12reader> clas12synth::makeReader(long nevents, std::vector<long> tags)
+{
+  std::string file = writeTemp(nevents);
+  if(file.empty())
+    return nullptr;
+
+  return std::make_unique<clas12::clas12reader>(file,tags);
+}
@@ -0,0 +1,312 @@
+#include "cutexpr.h"
+#include <cmath>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+
+bool cutExpr::compile(const std::string &text, const cutVarDef *vars, int nvars, std::string &error)
+{
+  nodes.clear();
+  used = 0;
+  root = -1;
+  src = text;
+  pos = 0;
+  err = "";
+  defs = vars;
+  ndefs = nvars;
+
+  int n = parseOr();
+  skipSpace();
+  if(n >= 0 && pos != src.size()){
+    n = fail("unexpected \"" + src.substr(pos) + "\"");
+  }
+  if(n < 0){
+    error = err;
+    nodes.clear();
+    used = 0;
+    return false;
+  }
+  root = n;
+  return true;
+}
+
+void cutExpr::eval(const double *event, const double * const *cand, int n, unsigned char *pass)
+{
+  if(n <= 0){ return; }
+  if(root < 0){
+    std::fill(pass,pass+n,1);
+    return;
+  }
+
+  if(reg.size() < nodes.size()*n){
+    reg.resize(nodes.size()*n);
+  }
+
+  //children always come before their parents
+  for(size_t i = 0; i < nodes.size(); i++){
+    const node &nd = nodes[i];
+    double *out = &reg[i*n];
+    int m = nd.uniform ? 1 : n;
+
+    const double *a = (nd.a >= 0) ? &reg[nd.a*n] : nullptr;
+    const double *b = (nd.b >= 0) ? &reg[nd.b*n] : nullptr;
+    int sa = (nd.a >= 0 && !nodes[nd.a].uniform) ? 1 : 0;
+    int sb = (nd.b >= 0 && !nodes[nd.b].uniform) ? 1 : 0;
+
+    switch(nd.op)
+      {
+      case op_const: out[0] = nd.value; break;
+      case op_event: out[0] = event[nd.var]; break;
+      case op_cand: std::copy(cand[nd.var],cand[nd.var]+n,out); break;
+      case op_neg:  for(int k = 0; k < m; k++){ out[k] = -a[k*sa]; } break;
+      case op_not:  for(int k = 0; k < m; k++){ out[k] = (a[k*sa] == 0); } break;
+      case op_abs:  for(int k = 0; k < m; k++){ out[k] = std::fabs(a[k*sa]); } break;
+      case op_sqrt: for(int k = 0; k < m; k++){ out[k] = std::sqrt(a[k*sa]); } break;
+      case op_cos:  for(int k = 0; k < m; k++){ out[k] = std::cos(a[k*sa]); } break;
+      case op_sin:  for(int k = 0; k < m; k++){ out[k] = std::sin(a[k*sa]); } break;
+      case op_add:  for(int k = 0; k < m; k++){ out[k] = a[k*sa] + b[k*sb]; } break;
+      case op_sub:  for(int k = 0; k < m; k++){ out[k] = a[k*sa] - b[k*sb]; } break;
+      case op_mul:  for(int k = 0; k < m; k++){ out[k] = a[k*sa] * b[k*sb]; } break;
+      case op_div:  for(int k = 0; k < m; k++){ out[k] = a[k*sa] / b[k*sb]; } break;
+      case op_min:  for(int k = 0; k < m; k++){ out[k] = std::min(a[k*sa],b[k*sb]); } break;
+      case op_max:  for(int k = 0; k < m; k++){ out[k] = std::max(a[k*sa],b[k*sb]); } break;
+      case op_lt:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] < b[k*sb]); } break;
+      case op_le:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] <= b[k*sb]); } break;
+      case op_gt:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] > b[k*sb]); } break;
+      case op_ge:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] >= b[k*sb]); } break;
+      case op_eq:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] == b[k*sb]); } break;
+      case op_ne:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] != b[k*sb]); } break;
+      case op_and:  for(int k = 0; k < m; k++){ out[k] = (a[k*sa] != 0) & (b[k*sb] != 0); } break;
+      case op_or:   for(int k = 0; k < m; k++){ out[k] = (a[k*sa] != 0) | (b[k*sb] != 0); } break;
+      }
+  }
+
+  const double *r = &reg[root*n];
+  int sr = nodes[root].uniform ? 0 : 1;
+  for(int k = 0; k < n; k++){
+    pass[k] = (r[k*sr] != 0);
+  }
+}
+
+double cutExpr::fold(opCode op, double a, double b)
+{
+  switch(op)
+    {
+    case op_neg: return -a;
+    case op_not: return (a == 0);
+    case op_abs: return std::fabs(a);
+    case op_sqrt: return std::sqrt(a);
+    case op_cos: return std::cos(a);
+    case op_sin: return std::sin(a);
+    case op_add: return a + b;
+    case op_sub: return a - b;
+    case op_mul: return a * b;
+    case op_div: return a / b;
+    case op_min: return std::min(a,b);
+    case op_max: return std::max(a,b);
+    case op_lt: return (a < b);
+    case op_le: return (a <= b);
+    case op_gt: return (a > b);
+    case op_ge: return (a >= b);
+    case op_eq: return (a == b);
+    case op_ne: return (a != b);
+    case op_and: return (a != 0) & (b != 0);
+    case op_or: return (a != 0) | (b != 0);
+    default: return 0;
+    }
+}
+
+int cutExpr::addNode(opCode op, int a, int b, double value, int var)
+{
+  bool uniform = (op == op_const || op == op_event);
+  if(a >= 0){ uniform = nodes[a].uniform && (b < 0 || nodes[b].uniform); }
+
+  //constants are folded
+  if(a >= 0 && nodes[a].op == op_const && (b < 0 || nodes[b].op == op_const)){
+    value = fold(op,nodes[a].value,(b >= 0) ? nodes[b].value : 0);
+    op = op_const;
+    a = b = -1;
+    var = -1;
+    uniform = true;
+  }
+
+  //equal subexpressions share one node
+  for(size_t i = 0; i < nodes.size(); i++){
+    const node &nd = nodes[i];
+    if(nd.op == op && nd.a == a && nd.b == b && nd.var == var &&
+       (op != op_const || nd.value == value)){
+      return i;
+    }
+  }
+  nodes.push_back(node{op,a,b,value,var,uniform});
+  return nodes.size()-1;
+}
+
+int cutExpr::fail(const std::string &what)
+{
+  if(err.empty()){
+    err = what + " at position " + std::to_string(pos) + " of \"" + src + "\"";
+  }
+  return -1;
+}
+
+void cutExpr::skipSpace()
+{
+  while(pos < src.size() && std::isspace((unsigned char)src[pos])){ pos++; }
+}
+
+bool cutExpr::next(const char *token)
+{
+  skipSpace();
+  size_t len = std::strlen(token);
+  if(src.compare(pos,len,token) != 0){ return false; }
+  pos += len;
+  return true;
+}
+
+int cutExpr::parseOr()
+{
+  int a = parseAnd();
+  while(a >= 0 && next("||")){
+    int b = parseAnd();
+    if(b < 0){ return -1; }
+    a = addNode(op_or,a,b);
+  }
+  return a;
+}
+
+int cutExpr::parseAnd()
+{
+  int a = parseCompare();
+  while(a >= 0 && next("&&")){
+    int b = parseCompare();
+    if(b < 0){ return -1; }
+    a = addNode(op_and,a,b);
+  }
+  return a;
+}
+
+int cutExpr::parseCompare()
+{
+  int a = parseSum();
+  if(a < 0){ return -1; }
+
+  opCode op;
+  if(next("<=")){ op = op_le; }
+  else if(next(">=")){ op = op_ge; }
+  else if(next("==")){ op = op_eq; }
+  else if(next("!=")){ op = op_ne; }
+  else if(next("<")){ op = op_lt; }
+  else if(next(">")){ op = op_gt; }
+  else{ return a; }
+
+  int b = parseSum();
+  if(b < 0){ return -1; }
+  return addNode(op,a,b);
+}
+
+int cutExpr::parseSum()
+{
+  int a = parseProduct();
+  while(a >= 0){
+    opCode op;
+    if(next("+")){ op = op_add; }
+    else if(next("-")){ op = op_sub; }
+    else{ break; }
+    int b = parseProduct();
+    if(b < 0){ return -1; }
+    a = addNode(op,a,b);
+  }
+  return a;
+}
+
+int cutExpr::parseProduct()
+{
+  int a = parseUnary();
+  while(a >= 0){
+    opCode op;
+    if(next("*")){ op = op_mul; }
+    else if(next("/")){ op = op_div; }
+    else{ break; }
+    int b = parseUnary();
+    if(b < 0){ return -1; }
+    a = addNode(op,a,b);
+  }
+  return a;
+}
+
+int cutExpr::parseUnary()
+{
+  if(next("-")){
+    int a = parseUnary();
+    return (a < 0) ? -1 : addNode(op_neg,a);
+  }
+  skipSpace();
+  if(src.compare(pos,2,"!=") != 0 && next("!")){
+    int a = parseUnary();
+    return (a < 0) ? -1 : addNode(op_not,a);
+  }
+  return parsePrimary();
+}
+
+int cutExpr::parsePrimary()
+{
+  skipSpace();
+  if(pos >= src.size()){ return fail("unexpected end"); }
+
+  if(next("(")){
+    int a = parseOr();
+    if(a < 0){ return -1; }
+    if(!next(")")){ return fail("missing )"); }
+    return a;
+  }
+
+  char ch = src[pos];
+  if(std::isdigit((unsigned char)ch) || ch == '.'){
+    size_t len = 0;
+    double value;
+    try{
+      value = std::stod(src.substr(pos),&len);
+    }
+    catch(...){
+      return fail("bad number");
+    }
+    pos += len;
+    return addNode(op_const,-1,-1,value);
+  }
+
+  if(!std::isalpha((unsigned char)ch) && ch != '_'){
+    return fail(std::string("unexpected '") + ch + "'");
+  }
+  size_t start = pos;
+  while(pos < src.size() && (std::isalnum((unsigned char)src[pos]) || src[pos] == '_')){ pos++; }
+  std::string name = src.substr(start,pos-start);
+
+  //functions
+  static const struct {const char *name; opCode op; int nargs;} funcs[] =
+    {{"abs",op_abs,1},{"sqrt",op_sqrt,1},{"cos",op_cos,1},{"sin",op_sin,1},{"min",op_min,2},{"max",op_max,2}};
+  for(auto &f : funcs){
+    if(name != f.name){ continue; }
+    if(!next("(")){ return fail("missing ( after " + name); }
+    int a = parseOr();
+    int b = -1;
+    if(a < 0){ return -1; }
+    if(f.nargs == 2){
+      if(!next(",")){ return fail(name + " takes two arguments"); }
+      b = parseOr();
+      if(b < 0){ return -1; }
+    }
+    if(!next(")")){ return fail("missing )"); }
+    return addNode(f.op,a,b);
+  }
+
+  //variables
+  for(int v = 0; v < ndefs; v++){
+    if(name != defs[v].name){ continue; }
+    used |= 1ull << v;
+    return addNode(defs[v].event ? op_event : op_cand,-1,-1,0,v);
+  }
+
+  pos = start;
+  return fail("unknown variable " + name);
+}
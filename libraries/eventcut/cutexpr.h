@@ -0,0 +1,82 @@
+#ifndef CUTEXPR_HH
+#define CUTEXPR_HH
+
+#include <string>
+#include <vector>
+
+//Cut expressions for the eventcut cut files, e.g. "Q2 > 1.5 && abs(vzdiff) < 3"
+//The text is compiled once into a list of nodes (a DAG, equal subexpressions share a
+//node) which is evaluated over all candidates of the event at once. Nodes that only
+//depend on constants and event variables are evaluated once per call.
+//
+//Operators: || && ! < <= > >= == != + - * / and unary -
+//Functions: abs sqrt cos sin min max
+//Numbers are read with std::stod, variables are the names given to compile.
+
+struct cutVarDef{
+  const char *name;
+  bool event; //one value per event, otherwise one value per candidate
+  };
+
+class cutExpr{
+ public:
+
+  //returns false and sets error if the text does not compile
+  bool compile(const std::string &text, const cutVarDef *vars, int nvars, std::string &error);
+  bool empty() const {return nodes.empty();}
+
+  //bit i set if variable i is used
+  unsigned long long usedVars() const {return used;}
+
+  //pass[k] for the n candidates, event[v] the event variables and cand[v][k] the
+  //candidate variables (only the used ones need to be set)
+  void eval(const double *event, const double * const *cand, int n, unsigned char *pass);
+
+ private:
+
+  enum opCode{op_const,op_event,op_cand,op_neg,op_not,op_abs,op_sqrt,op_cos,op_sin,
+	      op_add,op_sub,op_mul,op_div,op_min,op_max,
+	      op_lt,op_le,op_gt,op_ge,op_eq,op_ne,op_and,op_or};
+
+  struct node{
+    opCode op;
+    int a;
+    int b;
+    double value;  //op_const
+    int var;       //op_event, op_cand
+    bool uniform;  //same value for all candidates
+    };
+
+  //parser, returns the node index or -1 on error
+  int parseOr();
+  int parseAnd();
+  int parseCompare();
+  int parseSum();
+  int parseProduct();
+  int parseUnary();
+  int parsePrimary();
+
+  bool next(const char *token);
+  void skipSpace();
+  int fail(const std::string &what);
+
+  int addNode(opCode op, int a = -1, int b = -1, double value = 0, int var = -1);
+  static double fold(opCode op, double a, double b);
+
+  std::vector<node> nodes;
+  int root = -1;
+  unsigned long long used = 0;
+
+  //registers, nodes.size() columns of at most n values
+  std::vector<double> reg;
+
+  //parser state
+  std::string src;
+  size_t pos = 0;
+  std::string err;
+  const cutVarDef *defs = nullptr;
+  int ndefs = 0;
+
+};
+
+#endif
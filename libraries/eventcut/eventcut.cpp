@@ -1,5 +1,17 @@
 #include "eventcut.h"
 
+//Names of the cut expression variables, in exprVar order
+static const cutVarDef exprVarDefs[xv_n] = {
+  //Event: electron (first electron of the event), q and the beam
+  {"e_p",true},{"e_theta",true},{"e_phi",true},{"e_vz",true},{"e_nphe",true},
+  {"e_calv",true},{"e_calw",true},{"e_SF",true},{"n_e",true},
+  {"nu",true},{"q",true},{"Q2",true},{"xB",true},{"Ebeam",true},
+  //Candidate: lead or recoil nucleon, angles in degrees
+  {"p",false},{"theta",false},{"phi",false},{"vz",false},{"chipid",false},{"timediff",false},
+  {"theta_lq",false},{"phidiff",false},{"vzdiff",false},{"pmiss",false},{"mmiss",false},{"loq",false}
+};
+static const unsigned long long exprCandVars = ~((1ull << xv_p) - 1) & ((1ull << xv_n) - 1);
+
 eventcut::eventcut(double E, char * filename)
 {
   //Set beam energy
@@ -13,10 +25,10 @@ eventcut::eventcut(double E, char * filename)
   cutStruct.max =  1000000;
   cutStruct.count =  0;
   cutStruct.label =  "";
+  cutStruct.mask =  0;
 
   for(int i = e_cuts; i != fake; i++){
-    cutName thisCut = static_cast<cutName>(i);
-    cutmap[thisCut] = cutStruct;    
+    cuts[i] = cutStruct;    
   }
 
   //Set the cuts from the text file
@@ -36,27 +48,27 @@ eventcut::~eventcut()
 
 bool eventcut::getDoCut(cutName thisCut)
 {
-  return cutmap[thisCut].docut;
+  return cuts[thisCut].docut;
 }
 
 double eventcut::getCutMin(cutName thisCut)
 {
-  return cutmap[thisCut].min;
+  return cuts[thisCut].min;
 }
 
 double eventcut::getCutMax(cutName thisCut)
 {
-  return cutmap[thisCut].max;
+  return cuts[thisCut].max;
 }
 
 int eventcut::getCutCount(cutName thisCut)
 {
-  return cutmap[thisCut].count;
+  return cuts[thisCut].count;
 }
 
 std::string eventcut::getCutLabel(cutName thisCut)
 {
-  return cutmap[thisCut].label;
+  return cuts[thisCut].label;
 }
 
 std::string eventcut::getCutName(cutName thisCut)
@@ -86,6 +98,9 @@ std::string eventcut::getCutName(cutName thisCut)
     case e_vtze:
       myCutName = "Vertex Z_{e}";
       break;
+    case e_expr:
+      myCutName = "Electron Expression";
+      break;
     case l_cuts:
       myCutName = "(e,e'N_{Lead}) Cuts";
       break;
@@ -113,6 +128,9 @@ std::string eventcut::getCutName(cutName thisCut)
     case l_phidiff:
       myCutName = "|#phi_{e} - #phi_{Lead}|";
       break;
+    case l_expr:
+      myCutName = "Lead Expression";
+      break;
     case lsrc_cuts:
       myCutName = "(e,e'N_{Lead,SRC}) Cuts";
       break;
@@ -131,6 +149,9 @@ std::string eventcut::getCutName(cutName thisCut)
     case lsrc_loq:
       myCutName = "p/q";
       break;
+    case lsrc_expr:
+      myCutName = "Lead SRC Expression";
+      break;
     case rsrc_cuts:
       myCutName = "(e,e'N_{Lead,SRC},N_{Recoil,SRC}) Cuts";
       break;
@@ -152,6 +173,9 @@ std::string eventcut::getCutName(cutName thisCut)
     case rsrc_vtzdiff:
       myCutName = "Vertex Z_{e} - Z_{Rec}";
       break;
+    case rsrc_expr:
+      myCutName = "Recoil SRC Expression";
+      break;
     default:
       myCutName = "Unknown Cut";
       break;
@@ -162,11 +186,11 @@ std::string eventcut::getCutName(cutName thisCut)
 std::string eventcut::getCutInformation(cutName thisCut)
 {
 
-  std::string min = std::to_string(cutmap[thisCut].min);
+  std::string min = std::to_string(cuts[thisCut].min);
   min.erase(min.find_last_not_of('0')+1,std::string::npos );
-  std::string max = std::to_string(cutmap[thisCut].max);
+  std::string max = std::to_string(cuts[thisCut].max);
   max.erase(max.find_last_not_of('0')+1,std::string::npos );
-  std::string cutonoff = (cutmap[thisCut].docut) ? "ON" : "OFF";
+  std::string cutonoff = (cuts[thisCut].docut) ? "ON" : "OFF";
 
   std::string myCutInformation;
   switch(thisCut)
@@ -196,13 +220,19 @@ std::string eventcut::getCutInformation(cutName thisCut)
       break;
     case l_pid:
     case rsrc_pid:
-      myCutInformation = getCutName(thisCut)+": "+std::to_string(cutmap[thisCut].count);
+      myCutInformation = getCutName(thisCut)+": "+std::to_string(cuts[thisCut].count);
       break;
     case l_scint:
-      myCutInformation = getCutName(thisCut)+": "+cutmap[thisCut].label;
+      myCutInformation = getCutName(thisCut)+": "+cuts[thisCut].label;
       break;
     case rsrc_scint:
-      myCutInformation = getCutName(thisCut)+": "+cutmap[thisCut].label;
+      myCutInformation = getCutName(thisCut)+": "+cuts[thisCut].label;
+      break;
+    case e_expr:
+    case l_expr:
+    case lsrc_expr:
+    case rsrc_expr:
+      myCutInformation = getCutName(thisCut)+": "+cuts[thisCut].label;
       break;
     case e_cuts:
     case l_cuts:
@@ -237,6 +267,7 @@ void eventcut::set_cuts(char * filename)
       cutStruct.max =  1000000;
       cutStruct.count =  0;
       cutStruct.label =  "";
+      cutStruct.mask =  0;
 
       cutName thisCut = hashit(line.substr(0,line.find(": ")));
       std::string cut_values =line.erase(0, line.find(": ") + 2);	 
@@ -285,10 +316,30 @@ void eventcut::set_cuts(char * filename)
 	  break;
 	case l_scint:
 	  cutStruct.label = cut_values;
+	  cutStruct.mask = scintMask(cut_values,false);
+	  if(cutStruct.mask == 0){
+	    std::cerr<<"Incorrect lead nucleon scintillator choice -"<< cut_values<<"-\n Aborting...";
+	    exit(-2);
+	  }
 	  break;
         case rsrc_scint:
           cutStruct.label = cut_values;
+	  cutStruct.mask = scintMask(cut_values,true);
+	  if(cutStruct.mask == 0){
+	    std::cerr<<"Incorrect recoil nucleon scintillator choice -"<< cut_values<<"-\n Aborting...";
+	    exit(-2);
+	  }
           break;
+	case e_expr:
+	case l_expr:
+	case lsrc_expr:
+	case rsrc_expr:
+	  //several lines of the same expression cut are combined with &&
+	  cutStruct.label = "(" + cut_values + ")";
+	  if(cuts[thisCut].docut && !cuts[thisCut].label.empty()){
+	    cutStruct.label = cuts[thisCut].label + " && " + cutStruct.label;
+	  }
+	  break;
 	case e_cuts:
 	case l_cuts:
 	case lsrc_cuts:
@@ -310,15 +361,31 @@ void eventcut::set_cuts(char * filename)
 	  exit(-2);
 	  break;
 	}
-      cutmap[thisCut] = cutStruct;
+      cuts[thisCut] = cutStruct;
     }
   filestream.close();
+
+  snap->scint_hits = 0;
+  if(cuts[l_scint].docut){ snap->scint_hits |= cuts[l_scint].mask; }
+  if(cuts[rsrc_scint].docut){ snap->scint_hits |= cuts[rsrc_scint].mask; }
+
+  compileExpr(e_expr,expr_e);
+  compileExpr(l_expr,expr_l);
+  compileExpr(lsrc_expr,expr_lsrc);
+  compileExpr(rsrc_expr,expr_rsrc);
+  if(expr_e.usedVars() & exprCandVars){
+    std::cerr<<"The electron expression can only use event variables:\n"
+	     <<cuts[e_expr].label<<std::endl
+	     <<"Aborting...\n";
+    exit(-2);
+  }
+  expr_cand_vars = (expr_l.usedVars() | expr_lsrc.usedVars() | expr_rsrc.usedVars()) & exprCandVars;
   
 }
 
 void eventcut::print_cuts()
 {
-  if(cutmap[e_cuts].docut){
+  if(cuts[e_cuts].docut){
     print_cut_loop(e_cuts,l_cuts);
   }
   else{
@@ -326,7 +393,7 @@ void eventcut::print_cuts()
   }
   std::cout<<std::endl;
 
-  if(cutmap[l_cuts].docut){
+  if(cuts[l_cuts].docut){
     print_cut_loop(l_cuts,lsrc_cuts);
   }
   else{
@@ -334,7 +401,7 @@ void eventcut::print_cuts()
   }
   std::cout<<std::endl;
 
-  if(cutmap[lsrc_cuts].docut){
+  if(cuts[lsrc_cuts].docut){
     print_cut_loop(lsrc_cuts,rsrc_cuts);
   }
   else{
@@ -342,7 +409,7 @@ void eventcut::print_cuts()
   }
   std::cout<<std::endl;
   
-  if(cutmap[rsrc_cuts].docut){
+  if(cuts[rsrc_cuts].docut){
     print_cut_loop(rsrc_cuts,fake);
   }
   else{
@@ -357,7 +424,7 @@ void eventcut::print_cut_loop(cutName startCut, cutName endCut)
 {
   for(int i = startCut; i != endCut; i++){
     cutName thisCut = static_cast<cutName>(i);
-    if(cutmap[thisCut].docut){
+    if(cuts[thisCut].docut){
       std::cout<<getCutInformation(thisCut)<<std::endl;
     }
   }  
@@ -365,7 +432,7 @@ void eventcut::print_cut_loop(cutName startCut, cutName endCut)
 
 void eventcut::print_cut_onPDF(TLatex &myText, cutName thisCut, double &line)
 {
-  if(cutmap[thisCut].docut){
+  if(cuts[thisCut].docut){
     myText.DrawLatex(0.2,line,getCutInformation(thisCut).c_str());
     line-=0.1;
   }
@@ -401,6 +468,8 @@ cutName eventcut::hashit(std::string cut_name)
   if(cut_name == "e_vtz"){ return e_vtze; }
   if(cut_name == "evtz"){ return e_vtze; }
 
+  if(cut_name == "e_expr"){ return e_expr; }
+
   //Lead Nucleon Cuts
   if(cut_name == "l_cuts"){ return l_cuts; }
   if(cut_name == "(e,e'N_{Lead})"){ return l_cuts; }
@@ -429,6 +498,8 @@ cutName eventcut::hashit(std::string cut_name)
 
   if(cut_name == "l_phidiff"){ return l_phidiff; }
 
+  if(cut_name == "l_expr"){ return l_expr; }
+
   //SRC (e,e'N) Cuts
   if(cut_name == "lsrc_cuts"){ return lsrc_cuts; }
   if(cut_name == "(e,e'N_{Lead,SRC})"){ return lsrc_cuts; }
@@ -450,6 +521,8 @@ cutName eventcut::hashit(std::string cut_name)
   if(cut_name == "lsrc_loq"){ return lsrc_loq; }
   if(cut_name == "loq"){ return lsrc_loq; }
 
+  if(cut_name == "lsrc_expr"){ return lsrc_expr; }
+
   //SRC (e,e'NN) Cuts
   if(cut_name == "rsrc_cuts"){ return rsrc_cuts; }
   if(cut_name == "(e,e'N_{Lead,SRC}N_{Recoil,SRC})"){ return rsrc_cuts; }
@@ -470,6 +543,8 @@ cutName eventcut::hashit(std::string cut_name)
 
   if(cut_name == "rsrc_vtzdiff"){ return rsrc_vtzdiff; }
 
+  if(cut_name == "rsrc_expr"){ return rsrc_expr; }
+
   std::cerr<<"This is an invalid cut:\n"
 	   <<cut_name<<std::endl
 	   <<"Aborting...\n";
@@ -477,35 +552,250 @@ cutName eventcut::hashit(std::string cut_name)
 }
 
 
+unsigned int eventcut::scintMask(const std::string &label, bool recoil)
+{
+  //Scintillators for the lead and recoil nucleons
+  if(label == "FTOF1A"){ return sc_FTOF1A; }
+  if(label == "FTOF1B"){ return sc_FTOF1B; }
+  if(label == "FTOF1"){ return sc_FTOF1A | sc_FTOF1B; }
+  if(label == "FTOF2"){ return sc_FTOF2; }
+  if(label == "FTOF"){ return sc_FTOF1A | sc_FTOF1B | sc_FTOF2; }
+  if(label == "CTOF"){ return sc_CTOF; }
+  if(label == "TOF"){ return sc_FTOF1A | sc_FTOF1B | sc_FTOF2 | sc_CTOF; }
+  if(!recoil){ return 0; }
+
+  //Calorimeters and CND, recoil only
+  if(label == "ECIN"){ return sc_ECIN; }
+  if(label == "ECOUT"){ return sc_ECOUT; }
+  if(label == "PCAL"){ return sc_PCAL; }
+  if(label == "CND1"){ return sc_CND1; }
+  if(label == "CND2"){ return sc_CND2; }
+  if(label == "CND3"){ return sc_CND3; }
+  if(label == "CND"){ return sc_CND1 | sc_CND2 | sc_CND3; }
+  return 0;
+}
+
+void eventcut::compileExpr(cutName thisCut, cutExpr &expr)
+{
+  std::string error;
+  if(!cuts[thisCut].docut){ return; }
+  if(!expr.compile(cuts[thisCut].label,exprVarDefs,xv_n,error)){
+    std::cerr<<"This is an invalid cut expression for "<<getCutName(thisCut)<<":\n"
+	     <<error<<std::endl
+	     <<"Aborting...\n";
+    exit(-2);
+  }
+}
+
+void eventcut::takeSnapshot(const std::unique_ptr<clas12::clas12reader>& c12)
+{
+  snap->reader = c12.get();
+  snap->run = c12->runconfig()->getRun();
+  snap->event = c12->runconfig()->getEvent();
+  snap->serial++;
+
+  snap->electron = {};
+  snap->leads.clear();
+  snap->recoils.clear();
+
+  int pid_L = cuts[l_pid].count;
+  int pid_R = cuts[rsrc_pid].count;
+
+  //same selection and order as c12->getByID(pid)
+  const auto &particles = c12->getDetParticles();
+  for(const auto &p : particles){
+    int pid = p->par()->getPid();
+    if(pid == 11 && snap->electron.count++ == 0){
+      snap->electron.nphe = p->che(clas12::HTCC)->getNphe();
+      snap->electron.calv = p->cal(clas12::PCAL)->getLv();
+      snap->electron.calw = p->cal(clas12::PCAL)->getLw();
+      snap->electron.v.SetMagThetaPhi(p->getP(),p->getTheta(),p->getPhi());
+      snap->electron.SF = (p->cal(clas12::PCAL)->getEnergy() +  p->cal(clas12::ECIN)->getEnergy() +  p->cal(clas12::ECOUT)->getEnergy()) / snap->electron.v.Mag();
+      snap->electron.mom = p->getP();
+      snap->electron.vz = p->par()->getVz();
+      snap->electron.phi = p->getPhi() * 180 / M_PI;
+    }
+    if(pid == pid_L){
+      snap->leads.emplace_back();
+      fillCandidate(snap->leads.back(),p);
+    }
+    else if(pid == pid_R){
+      snap->recoils.emplace_back();
+      fillCandidate(snap->recoils.back(),p);
+    }
+  }
+
+  //q, Q2 and xB are shared by the lead and SRC cuts
+  snap->electron.q = vbeam - snap->electron.v;
+  snap->electron.nu = Ebeam - snap->electron.v.Mag();
+  snap->electron.Q2 = snap->electron.q.Mag2() - (snap->electron.nu*snap->electron.nu);
+  snap->electron.xB = snap->electron.Q2 / (2 * mN * snap->electron.nu);
+
+  fillExprVars();
+}
+
+void eventcut::fillExprVars()
+{
+  //variables of the cut expressions
+  expr_serial = snap->serial;
+  expr_event[xv_e_p] = snap->electron.mom;
+  expr_event[xv_e_theta] = snap->electron.v.Theta() * 180 / M_PI;
+  expr_event[xv_e_phi] = snap->electron.phi;
+  expr_event[xv_e_vz] = snap->electron.vz;
+  expr_event[xv_e_nphe] = snap->electron.nphe;
+  expr_event[xv_e_calv] = snap->electron.calv;
+  expr_event[xv_e_calw] = snap->electron.calw;
+  expr_event[xv_e_SF] = snap->electron.SF;
+  expr_event[xv_n_e] = snap->electron.count;
+  expr_event[xv_nu] = snap->electron.nu;
+  expr_event[xv_q] = snap->electron.q.Mag();
+  expr_event[xv_Q2] = snap->electron.Q2;
+  expr_event[xv_xB] = snap->electron.xB;
+  expr_event[xv_Ebeam] = Ebeam;
+  if(expr_cand_vars){
+    fillColumns(snap->leads,lead_cols);
+    fillColumns(snap->recoils,recoil_cols);
+  }
+}
+
+void eventcut::fillColumns(const std::vector<candInfo> &cands, std::vector<double> *cols)
+{
+  //only the variables used by an expression
+  int n = cands.size();
+  for(int v = xv_p; v < xv_n; v++){
+    if(!(expr_cand_vars & (1ull << v))){ continue; }
+    std::vector<double> &col = cols[v];
+    col.resize(n);
+    for(int k = 0; k < n; k++){
+      const candInfo &N = cands[k];
+      switch(v)
+	{
+	case xv_p: col[k] = N.mom; break;
+	case xv_theta: col[k] = N.theta; break;
+	case xv_phi: col[k] = N.phi; break;
+	case xv_vz: col[k] = N.vz; break;
+	case xv_chipid: col[k] = N.chi2pid; break;
+	case xv_timediff: col[k] = N.timediff; break;
+	case xv_theta_lq: col[k] = snap->electron.q.Angle(N.v) * 180 / M_PI; break;
+	case xv_phidiff: col[k] = phiDiff(snap->electron.phi,N.phi); break;
+	case xv_vzdiff: col[k] = snap->electron.vz - N.vz; break;
+	case xv_pmiss: col[k] = (vbeam - snap->electron.v - N.v).Mag(); break;
+	case xv_mmiss:
+	  {
+	    TVector3 vmiss = vbeam - snap->electron.v - N.v;
+	    double emiss = Ebeam + mD - snap->electron.v.Mag() - sqrt((mN * mN) + N.v.Mag2());
+	    col[k] = sqrt((emiss * emiss) - vmiss.Mag2());
+	    break;
+	  }
+	case xv_loq: col[k] = N.v.Mag()/snap->electron.q.Mag(); break;
+	}
+    }
+  }
+}
+
+void eventcut::checkSnapshot(const std::unique_ptr<clas12::clas12reader>& c12)
+{
+  if(c12.get() != snap->reader ||
+     c12->runconfig()->getEvent() != snap->event ||
+     c12->runconfig()->getRun() != snap->run){
+    takeSnapshot(c12);
+  }
+  else if(expr_serial != snap->serial){
+    //taken by another eventcut sharing the snapshot
+    fillExprVars();
+  }
+}
+
+void eventcut::fillCandidate(candInfo &cand, const clas12::region_part_ptr &p)
+{
+  cand.p = p;
+
+  //only the detectors of the scintillator cuts are looked up
+  unsigned int hits = 0;
+  if(snap->scint_hits & sc_FTOF1A){ hits |= (p->sci(clas12::FTOF1A)->getDetector() == 12) ? sc_FTOF1A : 0; }
+  if(snap->scint_hits & sc_FTOF1B){ hits |= (p->sci(clas12::FTOF1B)->getDetector() == 12) ? sc_FTOF1B : 0; }
+  if(snap->scint_hits & sc_FTOF2){ hits |= (p->sci(clas12::FTOF2)->getDetector() == 12) ? sc_FTOF2 : 0; }
+  if(snap->scint_hits & sc_CTOF){ hits |= (p->sci(clas12::CTOF)->getDetector() == 4) ? sc_CTOF : 0; }
+  if(snap->scint_hits & sc_ECIN){ hits |= (p->cal(clas12::ECIN)->getDetector() == 7) ? sc_ECIN : 0; }
+  if(snap->scint_hits & sc_ECOUT){ hits |= (p->cal(clas12::ECOUT)->getDetector() == 7) ? sc_ECOUT : 0; }
+  if(snap->scint_hits & sc_PCAL){ hits |= (p->cal(clas12::PCAL)->getDetector() == 7) ? sc_PCAL : 0; }
+  if(snap->scint_hits & sc_CND1){ hits |= (p->sci(clas12::CND1)->getDetector() == 3) ? sc_CND1 : 0; }
+  if(snap->scint_hits & sc_CND2){ hits |= (p->sci(clas12::CND2)->getDetector() == 3) ? sc_CND2 : 0; }
+  if(snap->scint_hits & sc_CND3){ hits |= (p->sci(clas12::CND3)->getDetector() == 3) ? sc_CND3 : 0; }
+  cand.hits = hits;
+
+  cand.v.SetMagThetaPhi(p->getP(),p->getTheta(),p->getPhi());
+  cand.mom = p->getP();
+  cand.theta = p->getTheta() * 180 / M_PI;
+  cand.phi = p->getPhi() * 180 / M_PI;
+  cand.vz = p->par()->getVz();
+  cand.chi2pid = p->par()->getChi2Pid();
+
+  double path = p->getPath();
+
+  double mom = cand.mom;
+  double beta_frommom = mom/sqrt(mom*mom + mN*mN);
+  double time_frommom = path / (c*beta_frommom);
+
+  double beta = p->par()->getBeta();
+  double time_frombeta = path / (c*beta);
+  
+  cand.timediff = time_frombeta-time_frommom;
+}
+
+const std::vector<candInfo>& eventcut::recoilCandidates() const
+{
+  return (cuts[rsrc_pid].count == cuts[l_pid].count) ? snap->leads : snap->recoils;
+}
+
+bool eventcut::shareSnapshot(eventcut &owner)
+{
+  if(owner.cuts[l_pid].count != cuts[l_pid].count ||
+     owner.cuts[rsrc_pid].count != cuts[rsrc_pid].count ||
+     owner.Ebeam != Ebeam){
+    return false;
+  }
+  //the shared candidates have the detector hits of both
+  owner.snap->scint_hits |= snap->scint_hits;
+  snap = owner.snap;
+  snap_owner = false;
+  expr_serial = -1;
+  return true;
+}
+
 bool eventcut::electroncut(const std::unique_ptr<clas12::clas12reader>& c12)
 {
-  if(!cutmap[e_cuts].docut){ return true; }
-  auto electrons=c12->getByID(11);
-  if(electrons.size()!=1){ return false;}
-  if(!e_nphecut(c12)){ return false; }
-  if(!e_calvcut(c12)){ return false; }
-  if(!e_calwcut(c12)){ return false; }
-  if(!e_SFcut(c12)){ return false; }
-  if(!e_momcut(c12)){ return false; }
-  if(!e_vtzecut(c12)){ return false; }
+  if(snap_owner){ takeSnapshot(c12); }
+  else{ checkSnapshot(c12); }
+  if(!cuts[e_cuts].docut){ return true; }
+  if(snap->electron.count!=1){ return false;}
+  if(!e_nphecut()){ return false; }
+  if(!e_calvcut()){ return false; }
+  if(!e_calwcut()){ return false; }
+  if(!e_SFcut()){ return false; }
+  if(!e_momcut()){ return false; }
+  if(!e_vtzecut()){ return false; }
+  if(!e_exprcut()){ return false; }
   return true;
 }
 
 int eventcut::leadnucleoncut(const std::unique_ptr<clas12::clas12reader>& c12)
 {
-  if(!cutmap[l_cuts].docut){ return 0; }
-  int pid = cutmap[l_pid].count;
-  auto nucleons=c12->getByID(pid);
+  if(!cuts[l_cuts].docut){ return 0; }
+  checkSnapshot(c12);
+  l_exprcut();
   int num_L = 0;
   int index_L = -1;
-  for(int i = 0; i < nucleons.size(); i++){
-    if(!l_scintcut(c12,i)){ continue; }
-    if(!l_thetacut(c12,i)){ continue; }
-    if(!l_thetalqcut(c12,i)){ continue; }
-    if(!l_chipidcut(c12,i)){ continue; }
-    if(!l_timediffcut(c12,i)){ continue; }
-    if(!l_vtzdiffcut(c12,i)){ continue; }
-    if(!l_phidiffcut(c12,i)){ continue; }
+  for(int i = 0; i < snap->leads.size(); i++){
+    const candInfo &L = snap->leads[i];
+    if(!lead_pass[i]){ continue; }
+    if(!l_scintcut(L)){ continue; }
+    if(!l_thetacut(L)){ continue; }
+    if(!l_thetalqcut(L)){ continue; }
+    if(!l_chipidcut(L)){ continue; }
+    if(!l_timediffcut(L)){ continue; }
+    if(!l_vtzdiffcut(L)){ continue; }
+    if(!l_phidiffcut(L)){ continue; }
     num_L++;
     index_L = i;
   }
@@ -515,30 +805,38 @@ int eventcut::leadnucleoncut(const std::unique_ptr<clas12::clas12reader>& c12)
 
 bool eventcut::leadSRCnucleoncut(const std::unique_ptr<clas12::clas12reader>& c12, int index_L)
 {
-  if(!cutmap[lsrc_cuts].docut){ return true; }
-  if(!lsrc_Q2cut(c12)){ return false; }
-  if(!lsrc_xBcut(c12)){ return false; }
-  if(!lsrc_pmisscut(c12,index_L)){ return false; }
-  if(!lsrc_mmisscut(c12,index_L)){ return false; }
-  if(!lsrc_loqcut(c12,index_L)){ return false; }
+  if(!cuts[lsrc_cuts].docut){ return true; }
+  checkSnapshot(c12);
+  if(index_L < 0 || index_L >= snap->leads.size()){ return false; }
+  const candInfo &L = snap->leads[index_L];
+  if(!lsrc_Q2cut()){ return false; }
+  if(!lsrc_xBcut()){ return false; }
+  if(!lsrc_pmisscut(L)){ return false; }
+  if(!lsrc_mmisscut(L)){ return false; }
+  if(!lsrc_loqcut(L)){ return false; }
+  if(!lsrc_exprcut(index_L)){ return false; }
   return true;
 }
 
 int eventcut::recoilSRCnucleoncut(const std::unique_ptr<clas12::clas12reader>& c12, int index_L)
 {
-  if(!cutmap[rsrc_cuts].docut){ return 0; }
-  int pid_L = cutmap[l_pid].count;
-  int pid_R = cutmap[rsrc_pid].count;
-  auto nucleons=c12->getByID(pid_R);
+  if(!cuts[rsrc_cuts].docut){ return 0; }
+  checkSnapshot(c12);
+  int pid_L = cuts[l_pid].count;
+  int pid_R = cuts[rsrc_pid].count;
+  const std::vector<candInfo> &nucleons = recoilCandidates();
+  rsrc_exprcut();
   int num_R = 0;
   int index_R = -1;
   for(int j = 0; j < nucleons.size(); j++){
     if((index_L==j) && (pid_L==pid_R)){ continue; }
-    if(!rsrc_scintcut(c12,j)){ continue; }
-    if(!rsrc_momcut(c12,j)){ continue; }
-    if(!rsrc_chipidcut(c12,j)){ continue; }
-    if(!rsrc_timediffcut(c12,j)){ continue; }
-    if(!rsrc_vtzdiffcut(c12,j)){ continue; }
+    const candInfo &R = nucleons[j];
+    if(!recoil_pass[j]){ continue; }
+    if(!rsrc_scintcut(R)){ continue; }
+    if(!rsrc_momcut(R)){ continue; }
+    if(!rsrc_chipidcut(R)){ continue; }
+    if(!rsrc_timediffcut(R)){ continue; }
+    if(!rsrc_vtzdiffcut(R)){ continue; }
     num_R++;
     index_R = j;
   }
@@ -550,340 +848,170 @@ int eventcut::recoilSRCnucleoncut(const std::unique_ptr<clas12::clas12reader>& c
 
 
 //Electron Cuts
-bool eventcut::e_nphecut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::e_nphecut()
 {
-  auto electrons=c12->getByID(11);
-  return inRange(electrons[0]->che(clas12::HTCC)->getNphe(),e_nphe);  
+  return inRange(snap->electron.nphe,e_nphe);  
 }
-bool eventcut::e_calvcut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::e_calvcut()
 {
-  auto electrons=c12->getByID(11);  
-  return inRange(electrons[0]->cal(clas12::PCAL)->getLv(),e_calv);  
+  return inRange(snap->electron.calv,e_calv);  
 }
-bool eventcut::e_calwcut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::e_calwcut()
 {
-  auto electrons=c12->getByID(11);
-  return inRange(electrons[0]->cal(clas12::PCAL)->getLw(),e_calw);  
+  return inRange(snap->electron.calw,e_calw);  
 }
-bool eventcut::e_SFcut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::e_SFcut()
 {
-  auto electrons=c12->getByID(11);
-
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-  double EoP_e =  (electrons[0]->cal(clas12::PCAL)->getEnergy() +  electrons[0]->cal(clas12::ECIN)->getEnergy() +  electrons[0]->cal(clas12::ECOUT)->getEnergy()) / ve.Mag();  
-  return inRange(EoP_e,e_SF);  
+  return inRange(snap->electron.SF,e_SF);  
+}
+bool eventcut::e_momcut()
+{
+  return inRange(snap->electron.mom,e_mom);  
 }
-bool eventcut::e_momcut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::e_vtzecut()
 {
-  auto electrons=c12->getByID(11);
-  return inRange(electrons[0]->getP(),e_mom);  
+  return inRange(snap->electron.vz,e_vtze);  
 }
-bool eventcut::e_vtzecut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::e_exprcut()
 {
-  auto electrons=c12->getByID(11);
-  return inRange(electrons[0]->par()->getVz(),e_vtze);  
+  if(!cuts[e_expr].docut){ return true; }
+  unsigned char pass;
+  expr_e.eval(expr_event,nullptr,1,&pass);
+  return pass;
 }
 
 
 
 //Lead Nucleon Cuts
-bool eventcut::l_scintcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::l_thetacut(const candInfo &L)
 {
-  if(!cutmap[l_scint].docut){ return true; }
-
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-
-  bool FTOF1A = (leadnucleons[i]->sci(clas12::FTOF1A)->getDetector() == 12);
-  bool FTOF1B = (leadnucleons[i]->sci(clas12::FTOF1B)->getDetector() == 12);
-  bool FTOF2 = (leadnucleons[i]->sci(clas12::FTOF2)->getDetector() == 12);
-  bool CTOF = (leadnucleons[i]->sci(clas12::CTOF)->getDetector() == 4);
-
-  std::string ct = cutmap[l_scint].label;
-  bool nameCorrect = false;
-  if(ct.compare("FTOF1A")==0){ nameCorrect = true; }
-  if(ct.compare("FTOF1B")==0){ nameCorrect = true; }
-  if(ct.compare("FTOF1") ==0){ nameCorrect = true; }
-  if(ct.compare("FTOF2") ==0){ nameCorrect = true; }
-  if(ct.compare("FTOF")  ==0){ nameCorrect = true; }
-  if(ct.compare("CTOF")  ==0){ nameCorrect = true; }
-  if(ct.compare("TOF")   ==0){ nameCorrect = true; }
-
-  if(!nameCorrect){
-    std::cerr<<"Incorrect lead nucleon scintillator choice -"<< ct<<"-\n Aborting...";
-    exit(-2);
-  }
-  if((ct.compare("FTOF1A")==0) && (FTOF1A)){return true;}
-  if((ct.compare("FTOF1B")==0) && (FTOF1B)){return true;}
-  if((ct.compare("FTOF1")==0)  && (FTOF1A || FTOF1B)){return true;}
-  if((ct.compare("FTOF2")==0)  && (FTOF2)){return true;}
-  if((ct.compare("FTOF")==0)   && (FTOF1A || FTOF1B || FTOF2)){return true;}
-  if((ct.compare("CTOF")==0)   && (CTOF)){return true;}
-  if((ct.compare("TOF")==0)    && (FTOF1A || FTOF1B || FTOF2 || CTOF)){return true;}
-  
-  return false;
+  return inRange(L.theta,l_theta);  
 }
-
-bool eventcut::l_thetacut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::l_thetalqcut(const candInfo &L)
 {
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  double theta = leadnucleons[i]->getTheta() * 180 / M_PI;
-  return inRange(theta,l_theta);  
+  if(!cuts[l_thetalq].docut){ return true; }
+  double thetalq = snap->electron.q.Angle(L.v) * 180 / M_PI;
+  return inRange(thetalq,l_thetalq);  
 }
-bool eventcut::l_thetalqcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::l_chipidcut(const candInfo &L)
 {
-  auto electrons=c12->getByID(11);
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  TVector3 vL;
-  vL.SetMagThetaPhi(leadnucleons[i]->getP(),leadnucleons[i]->getTheta(),leadnucleons[i]->getPhi());
-  
-  TVector3 vq = vbeam - ve;
-  
-  double thetalq = vq.Angle(vL) * 180 / M_PI;
-  return inRange(thetalq,l_thetalq);  
+  return inRange(L.chi2pid,l_chipid);  
 }
-bool eventcut::l_chipidcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::l_timediffcut(const candInfo &L)
 {
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  return inRange(leadnucleons[i]->par()->getChi2Pid(),l_chipid);  
+  return inRange(L.timediff,l_timediff);  
 }
-bool eventcut::l_timediffcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::l_vtzdiffcut(const candInfo &L)
 {
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-
-  double path = leadnucleons[i]->getPath();
-
-  double mom = leadnucleons[i]->getP();
-  double beta_frommom = mom/sqrt(mom*mom + mN*mN);
-  double time_frommom = path / (c*beta_frommom);
-
-  double beta = leadnucleons[i]->par()->getBeta();
-  double time_frombeta = path / (c*beta);
-  
-  double time_diff = time_frombeta-time_frommom;
-
-  return inRange(time_diff,l_timediff);  
+  return inRange(snap->electron.vz-L.vz,l_vtzdiff);  
 }
-bool eventcut::l_vtzdiffcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::l_phidiffcut(const candInfo &L)
 {
-  auto electrons=c12->getByID(11);
-  double vtze = electrons[0]->par()->getVz();  
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  double vtzl = leadnucleons[i]->par()->getVz();  
-  return inRange(vtze-vtzl,l_vtzdiff);  
+  return inRange(phiDiff(snap->electron.phi,L.phi),l_phidiff);  
 }
-bool eventcut::l_phidiffcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+double eventcut::phiDiff(double e_phi, double p_phi)
 {
-  auto electrons=c12->getByID(11);
-  double e_phi = electrons[0]->getPhi() * 180 / M_PI;
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  double p_phi = leadnucleons[i]->getPhi() * 180 / M_PI;
-  double phidiff;
-
   if(e_phi>p_phi){
     if((e_phi-p_phi)<=180){
-      phidiff = (e_phi-p_phi);
+      return (e_phi-p_phi);
     }
     else{
-      phidiff = 360 - (e_phi-p_phi);
+      return 360 - (e_phi-p_phi);
     }
   }
   else{
     if((p_phi-e_phi)<=180){
-      phidiff = (p_phi-e_phi);
+      return (p_phi-e_phi);
     }
     else{
-      phidiff = 360 - (p_phi-e_phi);
+      return 360 - (p_phi-e_phi);
     }
   }
-
-  return inRange(phidiff,l_phidiff);  
+}
+//lead_pass for all lead candidates
+void eventcut::l_exprcut()
+{
+  lead_pass.assign(snap->leads.size(),1);
+  if(!cuts[l_expr].docut){ return; }
+  const double *cols[xv_n] = {};
+  for(int v = xv_p; v < xv_n; v++){ cols[v] = lead_cols[v].data(); }
+  expr_l.eval(expr_event,cols,snap->leads.size(),lead_pass.data());
 }
 
 
 //SRC (e,e'N) Cuts
-bool eventcut::lsrc_Q2cut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::lsrc_Q2cut()
 {
-  auto electrons=c12->getByID(11);
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-  TVector3 vq = vbeam - ve;
-  double nu = Ebeam - ve.Mag();
-  double Q2 = vq.Mag2() - (nu*nu);
-
-  return inRange(Q2,lsrc_Q2);  
+  return inRange(snap->electron.Q2,lsrc_Q2);  
 }
 
-bool eventcut::lsrc_xBcut(const std::unique_ptr<clas12::clas12reader>& c12)
+bool eventcut::lsrc_xBcut()
 {
-  auto electrons=c12->getByID(11);
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-  TVector3 vq = vbeam - ve;
-  double nu = Ebeam - ve.Mag();
-  double Q2 = vq.Mag2() - (nu*nu);
-  double xB = Q2 / (2 * mN * nu);
-  
-  return inRange(xB,lsrc_xB);  
+  return inRange(snap->electron.xB,lsrc_xB);  
 }
 
-bool eventcut::lsrc_pmisscut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::lsrc_pmisscut(const candInfo &L)
 {
-  auto electrons=c12->getByID(11);
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  TVector3 vL;
-  vL.SetMagThetaPhi(leadnucleons[i]->getP(),leadnucleons[i]->getTheta(),leadnucleons[i]->getPhi());
-  
-  TVector3 vmiss = vbeam - ve - vL;
+  TVector3 vmiss = vbeam - snap->electron.v - L.v;
 
   return inRange(vmiss.Mag(),lsrc_pmiss);  
 }
 
-bool eventcut::lsrc_mmisscut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::lsrc_mmisscut(const candInfo &L)
 {
-  auto electrons=c12->getByID(11);
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  TVector3 vL;
-  vL.SetMagThetaPhi(leadnucleons[i]->getP(),leadnucleons[i]->getTheta(),leadnucleons[i]->getPhi());
+  if(!cuts[lsrc_mmiss].docut){ return true; }
 
-  TVector3 vmiss = vbeam - ve - vL;
-  double Ee = ve.Mag();
-  double Ep = sqrt((mN * mN) + vL.Mag2());
+  TVector3 vmiss = vbeam - snap->electron.v - L.v;
+  double Ee = snap->electron.v.Mag();
+  double Ep = sqrt((mN * mN) + L.v.Mag2());
   double emiss = Ebeam + mD - Ee - Ep;
   double mmiss = sqrt((emiss * emiss) - vmiss.Mag2());
 
   return inRange(mmiss,lsrc_mmiss);  
 }
 
-bool eventcut::lsrc_loqcut(const std::unique_ptr<clas12::clas12reader>& c12, int i)
+bool eventcut::lsrc_loqcut(const candInfo &L)
 {
-  auto electrons=c12->getByID(11);
-  TVector3 ve;
-  ve.SetMagThetaPhi(electrons[0]->getP(),electrons[0]->getTheta(),electrons[0]->getPhi());
-
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  TVector3 vL;
-  vL.SetMagThetaPhi(leadnucleons[i]->getP(),leadnucleons[i]->getTheta(),leadnucleons[i]->getPhi());
-  
-  TVector3 vq = vbeam - ve;
-  double Loq = vL.Mag()/vq.Mag();
+  double Loq = L.v.Mag()/snap->electron.q.Mag();
   
   return inRange(Loq,lsrc_loq);
 }
 
-//SRC (e,e'NN) Cuts
-bool eventcut::rsrc_scintcut(const std::unique_ptr<clas12::clas12reader>& c12, int j)
+bool eventcut::lsrc_exprcut(int index_L)
 {
-  if(!cutmap[rsrc_scint].docut){ return true;}
-  
-  auto recoilnucleons=c12->getByID(cutmap[rsrc_pid].count);
-  
-  bool FTOF1A = (recoilnucleons[j]->sci(clas12::FTOF1A)->getDetector() == 12);
-  bool FTOF1B = (recoilnucleons[j]->sci(clas12::FTOF1B)->getDetector() == 12);
-  bool FTOF2 = (recoilnucleons[j]->sci(clas12::FTOF2)->getDetector() == 12);
-  bool CTOF = (recoilnucleons[j]->sci(clas12::CTOF)->getDetector() == 4);
-  bool ECIN = (recoilnucleons[j]->cal(clas12::ECIN)->getDetector() == 7);
-  bool ECOUT = (recoilnucleons[j]->cal(clas12::ECOUT)->getDetector() == 7);
-  bool PCAL = (recoilnucleons[j]->cal(clas12::PCAL)->getDetector() == 7);
-  bool CND1 = (recoilnucleons[j]->sci(clas12::CND1)->getDetector() == 3);
-  bool CND2 = (recoilnucleons[j]->sci(clas12::CND2)->getDetector() == 3);
-  bool CND3 = (recoilnucleons[j]->sci(clas12::CND3)->getDetector() == 3);
-
-  std::string ct = cutmap[rsrc_scint].label;
-  bool nameCorrect = false;
-  if(ct.compare("FTOF1A")==0){ nameCorrect = true; }
-  if(ct.compare("FTOF1B")==0){ nameCorrect = true; }
-  if(ct.compare("FTOF1") ==0){ nameCorrect = true; }
-  if(ct.compare("FTOF2") ==0){ nameCorrect = true; }
-  if(ct.compare("FTOF")  ==0){ nameCorrect = true; }
-  if(ct.compare("CTOF")  ==0){ nameCorrect = true; }
-  if(ct.compare("TOF")   ==0){ nameCorrect = true; }
-  if (ct.compare("ECIN") ==0){ nameCorrect = true; }
-  if (ct.compare("ECOUT")==0){ nameCorrect = true; }
-  if (ct.compare("PCAL") ==0){ nameCorrect = true; }
-  if (ct.compare("CND1") ==0){ nameCorrect = true; }
-  if (ct.compare("CND2") ==0){ nameCorrect = true; }
-  if (ct.compare("CND3") ==0){ nameCorrect = true; }
-  if (ct.compare("CND")  ==0){ nameCorrect = true; }
-
-  if(!nameCorrect){
-    std::cerr<<"Incorrect recoil nucleon scintillator choice -"<< ct<<"-\n Aborting...";
-    exit(-2);
-  }
-  if((ct.compare("FTOF1A")==0) && (FTOF1A)){return true;}
-  if((ct.compare("FTOF1B")==0) && (FTOF1B)){return true;}
-  if((ct.compare("FTOF1")==0)  && (FTOF1A || FTOF1B)){return true;}
-  if((ct.compare("FTOF2")==0)  && (FTOF2)){return true;}
-  if((ct.compare("FTOF")==0)   && (FTOF1A || FTOF1B || FTOF2)){return true;}
-  if((ct.compare("CTOF")==0)   && (CTOF)){return true;}
-  if((ct.compare("TOF")==0)    && (FTOF1A || FTOF1B || FTOF2 || CTOF)){return true;}
-  if((ct.compare("ECIN")==0)  && (ECIN)){return true;}
-  if((ct.compare("ECOUT")==0) && (ECOUT)){return true;}
-  if((ct.compare("PCAL")==0)  && (PCAL)){return true;}
-  if((ct.compare("CND1")==0)  && (CND1)){return true;}
-  if((ct.compare("CND2")==0)  && (CND2)){return true;}
-  if((ct.compare("CND3")==0)  && (CND3)){return true;}
-  if((ct.compare("CND")==0)   && (CND1 || CND2 || CND3)){return true;}
-
-  return false;
-
+  if(!cuts[lsrc_expr].docut){ return true; }
+  const double *cols[xv_n] = {};
+  for(int v = xv_p; v < xv_n; v++){ cols[v] = lead_cols[v].empty() ? nullptr : lead_cols[v].data() + index_L; }
+  unsigned char pass;
+  expr_lsrc.eval(expr_event,cols,1,&pass);
+  return pass;
 }
 
-bool eventcut::rsrc_momcut(const std::unique_ptr<clas12::clas12reader>& c12, int j)
+//SRC (e,e'NN) Cuts
+bool eventcut::rsrc_momcut(const candInfo &R)
 {
-  auto recoilnucleons=c12->getByID(cutmap[rsrc_pid].count);
-  return inRange(recoilnucleons[j]->getP(),rsrc_mom);
+  return inRange(R.mom,rsrc_mom);
 }
-bool eventcut::rsrc_chipidcut(const std::unique_ptr<clas12::clas12reader>& c12, int j)
+bool eventcut::rsrc_chipidcut(const candInfo &R)
 {
-  auto recoilnucleons=c12->getByID(cutmap[rsrc_pid].count);
-  return inRange(recoilnucleons[j]->par()->getChi2Pid(),rsrc_chipid);
+  return inRange(R.chi2pid,rsrc_chipid);
 }
-bool eventcut::rsrc_timediffcut(const std::unique_ptr<clas12::clas12reader>& c12, int j)
+bool eventcut::rsrc_timediffcut(const candInfo &R)
 {
-  auto recoilnucleons=c12->getByID(cutmap[rsrc_pid].count);
-
-  double path = recoilnucleons[j]->getPath();
-
-  double mom = recoilnucleons[j]->getP();
-  double beta_frommom = mom/sqrt(mom*mom + mN*mN);
-  double time_frommom = path / (c*beta_frommom);
-
-  double beta = recoilnucleons[j]->par()->getBeta();
-  double time_frombeta = path / (c*beta);
-  
-  double time_diff = time_frombeta-time_frommom;
-
-  return inRange(time_diff,rsrc_timediff);
+  return inRange(R.timediff,rsrc_timediff);
 }
-bool eventcut::rsrc_vtzdiffcut(const std::unique_ptr<clas12::clas12reader>& c12, int j)
+bool eventcut::rsrc_vtzdiffcut(const candInfo &R)
 {
-  auto electrons=c12->getByID(11);
-  double vtze = electrons[0]->par()->getVz();  
-  auto leadnucleons=c12->getByID(cutmap[l_pid].count);
-  double vtzr = leadnucleons[j]->par()->getVz();  
-
-  return inRange(vtze-vtzr,rsrc_vtzdiff);
+  return inRange(snap->electron.vz-R.vz,rsrc_vtzdiff);
 }
-
-
-
-//General Cut
-bool eventcut::inRange(double x, cutName thisCut)
+//recoil_pass for all recoil candidates
+void eventcut::rsrc_exprcut()
 {
-  if(!cutmap[thisCut].docut){ return true; }
-
-  if(x < cutmap[thisCut].min){ return false; }
-  if(x > cutmap[thisCut].max){ return false; }
-  return true;
-
+  const std::vector<candInfo> &nucleons = recoilCandidates();
+  recoil_pass.assign(nucleons.size(),1);
+  if(!cuts[rsrc_expr].docut){ return; }
+  const std::vector<double> *source = (&nucleons == &snap->leads) ? lead_cols : recoil_cols;
+  const double *cols[xv_n] = {};
+  for(int v = xv_p; v < xv_n; v++){ cols[v] = source[v].data(); }
+  expr_rsrc.eval(expr_event,cols,nucleons.size(),recoil_pass.data());
 }
@@ -8,6 +8,7 @@
 #include <chrono>
 #include <vector>
 #include <typeinfo>
+#include <memory>
 
 #include <TFile.h>
 #include <TTree.h>
@@ -21,11 +22,21 @@
 
 #include "clas12reader.h"
 #include "HipoChain.h"
+#include "cutexpr.h"
 
 #include "TF1.h"
 #include "TCanvas.h"
 
-enum cutName{e_cuts,e_nphe,e_calv,e_calw,e_SF,e_mom,e_vtze,l_cuts,l_pid,l_scint,l_theta,l_thetalq,l_chipid,l_timediff,l_vtzdiff,l_phidiff,lsrc_cuts,lsrc_Q2,lsrc_xB,lsrc_pmiss,lsrc_mmiss,lsrc_loq,rsrc_cuts,rsrc_pid,rsrc_scint,rsrc_mom,rsrc_chipid,rsrc_timediff,rsrc_vtzdiff,fake};
+enum cutName{e_cuts,e_nphe,e_calv,e_calw,e_SF,e_mom,e_vtze,e_expr,l_cuts,l_pid,l_scint,l_theta,l_thetalq,l_chipid,l_timediff,l_vtzdiff,l_phidiff,l_expr,lsrc_cuts,lsrc_Q2,lsrc_xB,lsrc_pmiss,lsrc_mmiss,lsrc_loq,lsrc_expr,rsrc_cuts,rsrc_pid,rsrc_scint,rsrc_mom,rsrc_chipid,rsrc_timediff,rsrc_vtzdiff,rsrc_expr,fake};
+
+//Variables of the cut expressions (e_expr, l_expr, lsrc_expr, rsrc_expr), see exprVarDefs
+enum exprVar{xv_e_p,xv_e_theta,xv_e_phi,xv_e_vz,xv_e_nphe,xv_e_calv,xv_e_calw,xv_e_SF,xv_n_e,xv_nu,xv_q,xv_Q2,xv_xB,xv_Ebeam,
+             xv_p,xv_theta,xv_phi,xv_vz,xv_chipid,xv_timediff,xv_theta_lq,xv_phidiff,xv_vzdiff,xv_pmiss,xv_mmiss,xv_loq,xv_n};
+
+//Detector hits used by the scintillator cuts, one bit each
+enum scintBit{sc_FTOF1A = 1<<0, sc_FTOF1B = 1<<1, sc_FTOF2 = 1<<2, sc_CTOF = 1<<3,
+              sc_ECIN = 1<<4, sc_ECOUT = 1<<5, sc_PCAL = 1<<6,
+              sc_CND1 = 1<<7, sc_CND2 = 1<<8, sc_CND3 = 1<<9};
 
 struct cutInfo{
   bool docut;
@@ -33,6 +44,50 @@ struct cutInfo{
   double max;
   int count;
   std::string label;
+  unsigned int mask; //scintBit mask of the label for the scintillator cuts
+  };
+
+//Fields of one lead or recoil candidate, read once per event
+struct candInfo{
+  clas12::region_part_ptr p;
+  unsigned int hits; //scintBit mask of the detectors hit, only the bits the cuts use
+  TVector3 v;
+  double mom;
+  double theta;    //deg
+  double phi;      //deg
+  double vz;
+  double chi2pid;
+  double timediff; //ToF from beta minus ToF from momentum
+  };
+
+//The electron of the event and the quantities derived from it
+struct electronInfo{
+  int count;
+  double nphe;
+  double calv;
+  double calw;
+  double SF;
+  double mom;
+  double vz;
+  double phi;      //deg
+  TVector3 v;
+  TVector3 q;
+  double nu;
+  double Q2;
+  double xB;
+  };
+
+//Candidates of the current event, read once and shared by the eventcuts selecting the same
+//lead and recoil PIDs with the same beam energy (eventcut::shareSnapshot)
+struct eventSnapshot{
+  const clas12::clas12reader *reader = nullptr;
+  int run = -1;
+  int event = -1;
+  long serial = 0; //counts the snapshots taken
+  unsigned int scint_hits = 0; //detectors read into candInfo::hits
+  electronInfo electron = {};
+  std::vector<candInfo> leads;
+  std::vector<candInfo> recoils; //only used when the recoil PID differs from the lead PID
   };
 
 class eventcut{
@@ -60,46 +115,71 @@ class eventcut{
   bool leadSRCnucleoncut(const std::unique_ptr<clas12::clas12reader>& c12, int index_L);
   int recoilSRCnucleoncut(const std::unique_ptr<clas12::clas12reader>& c12, int index_L);
 
+  //Reads the electron and nucleon candidates of the event once for all the cuts.
+  //electroncut always takes a new snapshot (unless shared), the other cuts take one when
+  //the run or event number has changed. Index_L and index_R count the candidates of the snapshot,
+  //in the same order as c12->getByID(pid).
+  void takeSnapshot(const std::unique_ptr<clas12::clas12reader>& c12);
+  //Use the snapshot of owner, whose electroncut takes it for both and has to be called
+  //first in every event. False (and nothing shared) if the PIDs or beam energy differ.
+  bool shareSnapshot(eventcut &owner);
+
   
  private:
   
   cutName hashit(std::string cut_name);
+  void compileExpr(cutName thisCut, cutExpr &expr);
+  void fillColumns(const std::vector<candInfo> &cands, std::vector<double> *cols);
+  static double phiDiff(double e_phi, double p_phi);
+  unsigned int scintMask(const std::string &label, bool recoil);
+  void checkSnapshot(const std::unique_ptr<clas12::clas12reader>& c12);
+  void fillExprVars();
+  void fillCandidate(candInfo &cand, const clas12::region_part_ptr &p);
+  const std::vector<candInfo>& recoilCandidates() const;
 
   //Electron Cuts
-  bool e_nphecut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool e_calvcut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool e_calwcut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool e_SFcut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool e_momcut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool e_vtzecut(const std::unique_ptr<clas12::clas12reader>& c12);
+  bool e_nphecut();
+  bool e_calvcut();
+  bool e_calwcut();
+  bool e_SFcut();
+  bool e_momcut();
+  bool e_vtzecut();
+  bool e_exprcut();
 
 
   //Lead Nucleon Cuts
-  bool l_pidcut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool l_scintcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool l_thetacut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool l_thetalqcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool l_chipidcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool l_timediffcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool l_vtzdiffcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool l_phidiffcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
+  bool l_scintcut(const candInfo &L) const {return !cuts[l_scint].docut || (L.hits & cuts[l_scint].mask);}
+  bool l_thetacut(const candInfo &L);
+  bool l_thetalqcut(const candInfo &L);
+  bool l_chipidcut(const candInfo &L);
+  bool l_timediffcut(const candInfo &L);
+  bool l_vtzdiffcut(const candInfo &L);
+  bool l_phidiffcut(const candInfo &L);
+  void l_exprcut();
 
   //SRC (e,e'N) Cuts
-  bool lsrc_Q2cut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool lsrc_xBcut(const std::unique_ptr<clas12::clas12reader>& c12);
-  bool lsrc_pmisscut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool lsrc_mmisscut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
-  bool lsrc_loqcut(const std::unique_ptr<clas12::clas12reader>& c12, int i);
+  bool lsrc_Q2cut();
+  bool lsrc_xBcut();
+  bool lsrc_pmisscut(const candInfo &L);
+  bool lsrc_mmisscut(const candInfo &L);
+  bool lsrc_loqcut(const candInfo &L);
+  bool lsrc_exprcut(int index_L);
   
   //SRC (e,e'NN) Cuts
-  bool rsrc_scintcut(const std::unique_ptr<clas12::clas12reader>& c12,int j);
-  bool rsrc_momcut(const std::unique_ptr<clas12::clas12reader>& c12,int j);
-  bool rsrc_chipidcut(const std::unique_ptr<clas12::clas12reader>& c12,int j);
-  bool rsrc_timediffcut(const std::unique_ptr<clas12::clas12reader>& c12,int j);
-  bool rsrc_vtzdiffcut(const std::unique_ptr<clas12::clas12reader>& c12,int j);
+  bool rsrc_scintcut(const candInfo &R) const {return !cuts[rsrc_scint].docut || (R.hits & cuts[rsrc_scint].mask);}
+  bool rsrc_momcut(const candInfo &R);
+  bool rsrc_chipidcut(const candInfo &R);
+  bool rsrc_timediffcut(const candInfo &R);
+  bool rsrc_vtzdiffcut(const candInfo &R);
+  void rsrc_exprcut();
 
   //General Cut
-  bool inRange(double x, cutName thisCut);
+  bool inRange(double x, cutName thisCut) const
+  {
+    const cutInfo &cut = cuts[thisCut];
+    if(!cut.docut){ return true; }
+    return !(x < cut.min) && !(x > cut.max);
+  }
 
   const double c = 29.9792458;
   const double mN = 0.939;
@@ -110,7 +190,24 @@ class eventcut{
   char name;
   double Ebeam;
   TVector3 vbeam;
-  std::map<cutName,cutInfo> cutmap;
+  cutInfo cuts[fake+1] = {};
+
+  //Snapshot of the current event, possibly shared with other eventcuts
+  std::shared_ptr<eventSnapshot> snap = std::make_shared<eventSnapshot>();
+  bool snap_owner = true; //electroncut takes a new snapshot
+
+  //Cut expressions, the event variables and the candidate variables as columns
+  cutExpr expr_e;
+  cutExpr expr_l;
+  cutExpr expr_lsrc;
+  cutExpr expr_rsrc;
+  unsigned long long expr_cand_vars = 0; //candidate variables used by any expression
+  long expr_serial = -1; //snapshot the variables were filled from
+  double expr_event[xv_n] = {};
+  std::vector<double> lead_cols[xv_n];
+  std::vector<double> recoil_cols[xv_n];
+  std::vector<unsigned char> lead_pass;
+  std::vector<unsigned char> recoil_pass;
 
 };
 
@@ -5,7 +5,15 @@
 
 
 
-double getCVTdiff(std::vector<region_part_ptr> neutron_list, std::vector<region_part_ptr> &allParticles_list, int i)
+double getCVTdiff(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr> &allParticles_list, int i)
+{
+  clas12trajcache traj_cache;
+  return getCVTdiff(neutron_list, allParticles_list, i, traj_cache);
+}
+
+
+
+double getCVTdiff(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr> &allParticles_list, int i, clas12trajcache &traj_cache)
 {
   double hit12_phi = 180;
   double angle_diff = 180;
@@ -16,12 +24,9 @@ double getCVTdiff(std::vector<region_part_ptr> neutron_list, std::vector<region_
 
   for (int j=0; j<allParticles_list.size(); j++)
   {
-    // want k=1,3,5,7,12
-    TVector3 traj1( allParticles_list[j]->traj(CVT,1)->getX(), allParticles_list[j]->traj(CVT,1)->getY(), allParticles_list[j]->traj(CVT,1)->getZ() ); 
-    TVector3 traj3( allParticles_list[j]->traj(CVT,3)->getX(), allParticles_list[j]->traj(CVT,3)->getY(), allParticles_list[j]->traj(CVT,3)->getZ() );
-    TVector3 traj5( allParticles_list[j]->traj(CVT,5)->getX(), allParticles_list[j]->traj(CVT,5)->getY(), allParticles_list[j]->traj(CVT,5)->getZ() );
-    TVector3 traj7( allParticles_list[j]->traj(CVT,7)->getX(), allParticles_list[j]->traj(CVT,7)->getY(), allParticles_list[j]->traj(CVT,7)->getZ() );
-    TVector3 traj12( allParticles_list[j]->traj(CVT,12)->getX(), allParticles_list[j]->traj(CVT,12)->getY(), allParticles_list[j]->traj(CVT,12)->getZ() );
+    // CVT layers k=1,3,5,7,12 are in the cache, the last one is used here
+    const trajPoint &hit12 = traj_cache.cvt(allParticles_list[j]).cvt[trajInfo::cvt_12];
+    TVector3 traj12( hit12.x, hit12.y, hit12.z );
 
 
     if (traj12.X()==0 || traj12.Y()==0 || traj12.Z()==0) {continue;}
@@ -41,7 +46,15 @@ double getCVTdiff(std::vector<region_part_ptr> neutron_list, std::vector<region_
 
 
 
-Struct getFeatures(std::vector<region_part_ptr> neutron_list, std::vector<region_part_ptr>& allParticles_list, int i)
+Struct getFeatures(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr>& allParticles_list, int i)
+{
+  clas12trajcache traj_cache;
+  return getFeatures(neutron_list, allParticles_list, i, traj_cache);
+}
+
+
+
+Struct getFeatures(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr>& allParticles_list, int i, clas12trajcache &traj_cache)
 {
 
   // initialize variables to return
@@ -53,7 +66,7 @@ Struct getFeatures(std::vector<region_part_ptr> neutron_list, std::vector<region
   info.energy = 0;
   info.layermult = 0;
   info.size = 0;
-  info.angle_diff = getCVTdiff(neutron_list, allParticles_list, i);
+  info.angle_diff = getCVTdiff(neutron_list, allParticles_list, i, traj_cache);
 
 
   // determine which CND layer(s) neutron is in
@@ -3,10 +3,13 @@
 
 #include "clas12reader.h"
 #include "TVector3.h"
+#include "clas12trajcache.h"
 
 using namespace clas12;
 
-double getCVTdiff(std::vector<region_part_ptr> neutron_list, std::vector<region_part_ptr>& allParticles_list, int i);
+double getCVTdiff(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr>& allParticles_list, int i);
+// same, reading the CVT trajectories from the event's cache (e.g. clas12ana::getTrajCache())
+double getCVTdiff(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr>& allParticles_list, int i, clas12trajcache &traj_cache);
 
 struct neutronInfo{
   double cnd_hits;
@@ -21,7 +24,8 @@ struct neutronInfo{
 
 typedef struct neutronInfo Struct;
 
-Struct getFeatures(std::vector<region_part_ptr> neutron_list, std::vector<region_part_ptr>& allParticles_list, int i);
+Struct getFeatures(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr>& allParticles_list, int i);
+Struct getFeatures(const std::vector<region_part_ptr> &neutron_list, std::vector<region_part_ptr>& allParticles_list, int i, clas12trajcache &traj_cache);
 
 
 